@@ -0,0 +1,259 @@
+// max and mean ulp error of the float builtins in glic.h against a double precision reference, for every precision tier
+//
+// usage: glic_accuracy [--json] [--samples n] [--exhaustive] [--check]
+//   --json         a json array instead of csv
+//   --samples      inputs per row (default 1048576), spread evenly over the float values of the domain, so every binade
+//                  of a wide domain gets its share
+//   --exhaustive   every float of the domain for the one argument functions (slow for the wide domains)
+//   --check        exits with 1 when a fast tier row exceeds its error bound from the table in approx.h (or has a failure),
+//                  naming the row on stderr; ctest runs it with --samples 65536
+//
+// rows come out in a fixed order with fixed formatting so the output of two builds or releases can be diffed directly
+// the error is |result - reference| in units of the float spacing at the reference; a non finite result where the reference
+// is finite (or the other way round) counts as a failure and is left out of max and mean
+// the vector overloads run the same scalar code on every component, so only the geometric functions, which combine
+// components, are measured on vectors
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include "glic.h"
+
+using namespace glic;
+
+namespace {
+    struct options {
+        bool json = false;
+        bool exhaustive = false;
+        bool check = false;
+        std::uint64_t samples = 1u << 20;
+    };
+
+    struct result {
+        std::uint64_t samples = 0, failures = 0;
+        double max = 0.0, sum = 0.0, max_absolute = 0.0;
+        double worst_x = 0.0, worst_y = 0.0;
+
+        void add(const double error, const double x, const double y, const double absolute = 0.0){
+            ++samples;
+            if(!(error <= std::numeric_limits<double>::max())){ ++failures; return; }
+            sum += error;
+            max_absolute = std::max(max_absolute, absolute);
+            if(error > max){ max = error; worst_x = x; worst_y = y; }
+        }
+    };
+
+    // the largest error a row may have under --check, in ulp or absolute (zero leaves that measure unbounded)
+    struct bound {
+        double ulp = 0.0, absolute = 0.0;
+    };
+
+    const bound unbounded;
+    bound ulps(const double ulp){ return bound{ulp, 0.0}; }
+    bound absolute(const double absolute){ return bound{0.0, absolute}; }
+
+    int violations = 0;
+
+    // float spacing at the magnitude of reference, down to the denormal spacing
+    double ulp(const double reference){
+        int exponent;
+        std::frexp(reference, &exponent);
+        return std::ldexp(1.0, std::max(exponent - 1, -126) - 23);
+    }
+
+    double error(const float value, const double reference){
+        if(std::isnan(reference)){ return std::isnan(value) ? 0.0 : INFINITY; }
+
+        // the reference as a float decides whether the result had to overflow
+        const float rounded = static_cast<float>(reference);
+        if(std::isinf(rounded) || std::isinf(value)){ return value == rounded ? 0.0 : INFINITY; }
+        if(std::isnan(value)){ return INFINITY; }
+
+        return std::fabs(static_cast<double>(value) - reference) / ulp(reference);
+    }
+
+    // floats in order as integers, so even steps between two of them visit the float values evenly
+    std::int64_t ordered(const float x){
+        std::uint32_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        return (u & 0x80000000u) ? -static_cast<std::int64_t>(u & 0x7fffffffu) : static_cast<std::int64_t>(u);
+    }
+
+    float from_ordered(const std::int64_t o){
+        const std::uint32_t u = o < 0 ? (0x80000000u | static_cast<std::uint32_t>(-o)) : static_cast<std::uint32_t>(o);
+        float x;
+        std::memcpy(&x, &u, sizeof(x));
+        return x;
+    }
+
+    // second arguments and vector components come from a fixed seed so runs are repeatable
+    struct random {
+        std::uint32_t state = 0x2545f491u;
+
+        float next(const float lo, const float hi){
+            state = state * 1664525u + 1013904223u;
+            return lo + (hi - lo) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    template <typename F> void sweep(const options& o, const float lo, const float hi, const bool exhaustive, const F& visit){
+        const std::int64_t first = ordered(lo), last = ordered(hi), span = last - first;
+        if(exhaustive || static_cast<std::uint64_t>(span) < o.samples){
+            for(std::int64_t i = first; i <= last; ++i){ visit(from_ordered(i)); }
+        } else {
+            for(std::uint64_t i = 0; i < o.samples; ++i){ visit(from_ordered(first + static_cast<std::int64_t>(static_cast<double>(span) * i / (o.samples - 1)))); }
+        }
+    }
+
+    bool first_row = true;
+
+    void print(const options& o, const char* name, const char* tier, const std::string& domain, const result& r){
+        const double mean = r.samples > r.failures ? r.sum / (r.samples - r.failures) : 0.0;
+        if(o.json){
+            std::printf("%s\n  {\"function\": \"%s\", \"tier\": \"%s\", \"domain\": \"%s\", \"samples\": %llu, \"max_ulp\": %.4f, \"mean_ulp\": %.6f, \"worst_x\": \"%a\", \"worst_y\": \"%a\", \"failures\": %llu}",
+                first_row ? "[" : ",", name, tier, domain.c_str(), static_cast<unsigned long long>(r.samples), r.max, mean, r.worst_x, r.worst_y, static_cast<unsigned long long>(r.failures));
+        } else {
+            if(first_row){ std::printf("function,tier,domain,samples,max_ulp,mean_ulp,worst_x,worst_y,failures\n"); }
+            std::printf("%s,%s,%s,%llu,%.4f,%.6f,%a,%a,%llu\n",
+                name, tier, domain.c_str(), static_cast<unsigned long long>(r.samples), r.max, mean, r.worst_x, r.worst_y, static_cast<unsigned long long>(r.failures));
+        }
+        first_row = false;
+    }
+
+    void verify(const options& o, const char* name, const char* tier, const std::string& domain, const result& r, const bound& b){
+        if(!o.check || (b.ulp <= 0.0 && b.absolute <= 0.0)){ return; }
+        const bool ulp_exceeded = b.ulp > 0.0 && r.max > b.ulp, absolute_exceeded = b.absolute > 0.0 && r.max_absolute > b.absolute;
+        if(r.failures || ulp_exceeded || absolute_exceeded){
+            std::fprintf(stderr, "%s %s %s: max %.4f ulp, %.3g absolute, %llu failures, bound %g ulp %g absolute\n", name, tier, domain.c_str(),
+                r.max, r.max_absolute, static_cast<unsigned long long>(r.failures), b.ulp, b.absolute);
+            ++violations;
+        }
+    }
+
+    std::string range(const float lo, const float hi){
+        char text[64];
+        std::snprintf(text, sizeof(text), "[%g %g]", lo, hi);
+        return text;
+    }
+
+    template <typename F, typename R> void unary(const options& o, const char* name, const char* tier, const float lo, const float hi, const F& function, const R& reference, const bound& b = unbounded){
+        result r;
+        sweep(o, lo, hi, o.exhaustive, [&](const float x){
+            const float value = function(x);
+            const double expected = reference(static_cast<double>(x));
+            r.add(error(value, expected), x, 0.0, std::fabs(static_cast<double>(value) - expected));
+        });
+        print(o, name, tier, range(lo, hi), r);
+        verify(o, name, tier, range(lo, hi), r, b);
+    }
+
+    // x walks its domain like a unary function, y is drawn uniformly from its own
+    template <typename F, typename R> void binary(const options& o, const char* name, const char* tier, const float xlo, const float xhi, const float ylo, const float yhi, const F& function, const R& reference){
+        result r;
+        random y_values;
+        sweep(o, xlo, xhi, false, [&](const float x){
+            const float y = y_values.next(ylo, yhi);
+            r.add(error(function(x, y), reference(static_cast<double>(x), static_cast<double>(y))), x, y);
+        });
+        print(o, name, tier, range(xlo, xhi) + " x " + range(ylo, yhi), r);
+    }
+
+    // vec3 arguments with components drawn from [lo, hi], the error of a vector result is that of its worst component
+    template <typename F> void geometric(const options& o, const char* name, const float lo, const float hi, const F& measure){
+        result r;
+        random values;
+        for(std::uint64_t i = 0; i < o.samples; ++i){
+            const vec3 a(values.next(lo, hi), values.next(lo, hi), values.next(lo, hi)), b(values.next(lo, hi), values.next(lo, hi), values.next(lo, hi));
+            r.add(measure(a, b), a.x, b.x);
+        }
+        print(o, name, "exact", "vec3 " + range(lo, hi), r);
+    }
+
+    double length(const double x, const double y, const double z){ return std::sqrt(x * x + y * y + z * z); }
+
+    void all(const options& o){
+        const float pi = 3.14159265f, smallest = std::numeric_limits<float>::min(), largest = std::numeric_limits<float>::max();
+
+        // trigonometry
+        unary(o, "radians", "exact", -720.0f, 720.0f, [](float x){ return glic::radians(x); }, [](double x){ return x * 3.14159265358979323846 / 180.0; });
+        unary(o, "degrees", "exact", -4.0f * pi, 4.0f * pi, [](float x){ return glic::degrees(x); }, [](double x){ return x * 180.0 / 3.14159265358979323846; });
+
+        // the fast tier bounds are those of the table in approx.h
+        for(const float limit : {pi, 8192.0f}){
+            const bound trigonometry = limit == pi ? ulps(1.5) : absolute(7.9e-8);
+            unary(o, "sin", "exact", -limit, limit, [](float x){ return glic::sin(x, precision::exact); }, [](double x){ return std::sin(x); });
+            unary(o, "sin", "fast", -limit, limit, [](float x){ return glic::sin(x, precision::fast); }, [](double x){ return std::sin(x); }, trigonometry);
+            unary(o, "cos", "exact", -limit, limit, [](float x){ return glic::cos(x, precision::exact); }, [](double x){ return std::cos(x); });
+            unary(o, "cos", "fast", -limit, limit, [](float x){ return glic::cos(x, precision::fast); }, [](double x){ return std::cos(x); }, trigonometry);
+            unary(o, "tan", "exact", -limit, limit, [](float x){ return glic::tan(x, precision::exact); }, [](double x){ return std::tan(x); });
+            unary(o, "tan", "fast", -limit, limit, [](float x){ return glic::tan(x, precision::fast); }, [](double x){ return std::tan(x); });
+        }
+
+        unary(o, "asin", "exact", -1.0f, 1.0f, [](float x){ return glic::asin(x); }, [](double x){ return std::asin(x); });
+        unary(o, "acos", "exact", -1.0f, 1.0f, [](float x){ return glic::acos(x); }, [](double x){ return std::acos(x); });
+        unary(o, "atan", "exact", -1e4f, 1e4f, [](float x){ return glic::atan(x); }, [](double x){ return std::atan(x); });
+        binary(o, "atan2", "exact", -10.0f, 10.0f, -10.0f, 10.0f, [](float y, float x){ return glic::atan(y, x); }, [](double y, double x){ return std::atan2(y, x); });
+
+        // exponential
+        binary(o, "pow", "exact", 1e-3f, 1e3f, -4.0f, 4.0f, [](float x, float y){ return glic::pow(x, y, precision::exact); }, [](double x, double y){ return std::pow(x, y); });
+        binary(o, "pow", "fast", 1e-3f, 1e3f, -4.0f, 4.0f, [](float x, float y){ return glic::pow(x, y, precision::fast); }, [](double x, double y){ return std::pow(x, y); });
+        unary(o, "exp", "exact", -87.0f, 88.0f, [](float x){ return glic::exp(x, precision::exact); }, [](double x){ return std::exp(x); });
+        unary(o, "exp", "fast", -87.0f, 88.0f, [](float x){ return glic::exp(x, precision::fast); }, [](double x){ return std::exp(x); }, ulps(1.0));
+        unary(o, "exp2", "exact", -126.0f, 127.0f, [](float x){ return glic::exp2(x, precision::exact); }, [](double x){ return std::exp2(x); });
+        unary(o, "exp2", "fast", -126.0f, 127.0f, [](float x){ return glic::exp2(x, precision::fast); }, [](double x){ return std::exp2(x); }, ulps(1.3));
+        unary(o, "log", "exact", smallest, largest, [](float x){ return glic::log(x, precision::exact); }, [](double x){ return std::log(x); });
+        unary(o, "log", "fast", smallest, largest, [](float x){ return glic::log(x, precision::fast); }, [](double x){ return std::log(x); }, ulps(0.9));
+        unary(o, "log2", "exact", smallest, largest, [](float x){ return glic::log2(x, precision::exact); }, [](double x){ return std::log2(x); });
+        unary(o, "log2", "fast", smallest, largest, [](float x){ return glic::log2(x, precision::fast); }, [](double x){ return std::log2(x); }, ulps(1.5));
+        unary(o, "sqrt", "exact", 0.0f, largest, [](float x){ return glic::sqrt(x); }, [](double x){ return std::sqrt(x); });
+        unary(o, "inversesqrt", "exact", smallest, largest, [](float x){ return glic::inversesqrt(x, precision::exact); }, [](double x){ return 1.0 / std::sqrt(x); });
+        unary(o, "inversesqrt", "fast", smallest, largest, [](float x){ return glic::inversesqrt(x, precision::fast); }, [](double x){ return 1.0 / std::sqrt(x); }, ulps(3.2));
+
+        // common
+        unary(o, "fract", "exact", -1e3f, 1e3f, [](float x){ return glic::fract(x); }, [](double x){ return x - std::floor(x); });
+        binary(o, "mod", "exact", -100.0f, 100.0f, 0.5f, 10.0f, [](float x, float y){ return glic::mod(x, y); }, [](double x, double y){ return x - y * std::floor(x / y); });
+        unary(o, "smoothstep", "exact", -0.5f, 1.5f, [](float x){ return glic::smoothstep(0.0f, 1.0f, x); }, [](double x){ const double t = std::min(std::max(x, 0.0), 1.0); return t * t * (3.0 - 2.0 * t); });
+        binary(o, "mix", "exact", -100.0f, 100.0f, 0.0f, 1.0f, [](float x, float a){ return glic::mix(x, 3.0f, a); }, [](double x, double a){ return x + a * (3.0 - x); });
+
+        // geometric
+        geometric(o, "length", -100.0f, 100.0f, [](const vec3 a, const vec3){ return error(glic::length(a), length(a.x, a.y, a.z)); });
+        geometric(o, "distance", -100.0f, 100.0f, [](const vec3 a, const vec3 b){
+            return error(glic::distance(a, b), length(static_cast<double>(b.x) - a.x, static_cast<double>(b.y) - a.y, static_cast<double>(b.z) - a.z));
+        });
+        geometric(o, "dot", -100.0f, 100.0f, [](const vec3 a, const vec3 b){
+            return error(glic::dot(a, b), static_cast<double>(a.x) * b.x + static_cast<double>(a.y) * b.y + static_cast<double>(a.z) * b.z);
+        });
+        geometric(o, "normalize", -100.0f, 100.0f, [](const vec3 a, const vec3){
+            const vec3 n = glic::normalize(a);
+            const double l = length(a.x, a.y, a.z);
+            return std::max(error(n.x, a.x / l), std::max(error(n.y, a.y / l), error(n.z, a.z / l)));
+        });
+    }
+};
+
+int main(int argc, char** argv){
+    options o;
+    for(int i = 1; i < argc; ++i){
+        if(!std::strcmp(argv[i], "--json")){
+            o.json = true;
+        } else if(!std::strcmp(argv[i], "--exhaustive")){
+            o.exhaustive = true;
+        } else if(!std::strcmp(argv[i], "--check")){
+            o.check = true;
+        } else if(!std::strcmp(argv[i], "--samples") && i + 1 < argc){
+            o.samples = std::max<std::uint64_t>(2, std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            std::fprintf(stderr, "usage: %s [--json] [--samples n] [--exhaustive] [--check]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    all(o);
+    if(o.json){ std::printf("\n]\n"); }
+    return violations ? 1 : 0;
+}
@@ -0,0 +1,731 @@
+// throughput of every builtin in glic.h for float, vec2, vec3 and vec4, followed by full shader and pipeline workloads
+//
+// usage: glic_bench [--csv] [--quick] [--filter text]
+//   --csv      one machine readable row per measurement instead of the table
+//   --quick    shorter timing runs, for smoke testing
+//   --filter   only runs measurements whose name contains text
+//
+// ns/op is the time of one builtin call on one argument set, Gops/s counts the components of the argument type processed
+// per second (a vec4 call is four), so the vector widths can be compared with each other
+// every figure is the best of several runs over inputs that stay in L1, single threaded unless the name says otherwise
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include "batch.h"
+#include "denormal.h"
+#include "dispatch.h"
+#include "glic.h"
+#include "lazy.h"
+#include "noise.h"
+#include "quad.h"
+#include "render.h"
+#include "table.h"
+#include "texture.h"
+
+using namespace glic;
+
+namespace {
+    struct options {
+        bool csv = false;
+        bool quick = false;
+        std::string filter;
+
+        bool selected(const std::string& name) const { return filter.empty() || name.find(filter) != std::string::npos; }
+    };
+
+    // makes the compiler assume value is read, so neither the value nor the stores leading to it can be dropped
+    template <typename T> void keep(const T& value){
+        #if defined(__GNUC__)
+            asm volatile("" : : "g"(&value) : "memory");
+        #else
+            static volatile const void* sink;
+            sink = &value;
+        #endif
+    }
+
+    double seconds_since(const std::chrono::steady_clock::time_point start){
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // best time of one call to body, repeated until each run lasts long enough to time reliably
+    template <typename F> double best_seconds(const options& o, const F& body){
+        const double target = o.quick ? 0.002 : 0.02;
+        std::size_t repeats = 1;
+        while(true){
+            const auto start = std::chrono::steady_clock::now();
+            for(std::size_t r = 0; r < repeats; ++r){ body(); }
+            if(seconds_since(start) >= target){ break; }
+            repeats *= 2;
+        }
+
+        double best = 1e30;
+        for(int run = 0; run < (o.quick ? 2 : 5); ++run){
+            const auto start = std::chrono::steady_clock::now();
+            for(std::size_t r = 0; r < repeats; ++r){ body(); }
+            best = std::min(best, seconds_since(start) / repeats);
+        }
+        return best;
+    }
+
+    void print_header(const options& o){
+        if(o.csv){
+            std::printf("kind,name,type,ns_per_op,gops_per_s,value,unit\n");
+        } else {
+            std::printf("dispatch level %s (best %s)\n\n", dispatch::name(dispatch::selected()), dispatch::name(dispatch::detect()));
+            std::printf("%-28s %-6s %10s %10s\n", "builtin", "type", "ns/op", "Gops/s");
+        }
+    }
+
+    void report_builtin(const options& o, const std::string& name, const char* type, const double ns, const int components){
+        const double gops = components / ns;
+        if(o.csv){
+            std::printf("builtin,%s,%s,%.4f,%.4f,,\n", name.c_str(), type, ns, gops);
+        } else {
+            std::printf("%-28s %-6s %10.3f %10.3f\n", name.c_str(), type, ns, gops);
+        }
+    }
+
+    void report_workload(const options& o, const std::string& name, const double value, const char* unit){
+        if(o.csv){
+            std::printf("workload,%s,,,,%.4f,%s\n", name.c_str(), value, unit);
+        } else {
+            std::printf("%-42s %12.3f %s\n", name.c_str(), value, unit);
+        }
+    }
+
+    // inputs
+
+    struct random {
+        std::uint32_t state = 0x12345678u;
+
+        // uniform in [lo, hi)
+        float next(const float lo, const float hi){
+            state = state * 1664525u + 1013904223u;
+            return lo + (hi - lo) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    template <typename T> struct traits;
+    template <> struct traits<float> { static constexpr int components = 1; static const char* name(){ return "float"; } };
+    template <> struct traits<vec2> { static constexpr int components = 2; static const char* name(){ return "vec2"; } };
+    template <> struct traits<vec3> { static constexpr int components = 3; static const char* name(){ return "vec3"; } };
+    template <> struct traits<vec4> { static constexpr int components = 4; static const char* name(){ return "vec4"; } };
+
+    float make(random& r, const float lo, const float hi, float*){ return r.next(lo, hi); }
+    vec2 make(random& r, const float lo, const float hi, vec2*){ return vec2(r.next(lo, hi), r.next(lo, hi)); }
+    vec3 make(random& r, const float lo, const float hi, vec3*){ return vec3(r.next(lo, hi), r.next(lo, hi), r.next(lo, hi)); }
+    vec4 make(random& r, const float lo, const float hi, vec4*){ return vec4(r.next(lo, hi), r.next(lo, hi), r.next(lo, hi), r.next(lo, hi)); }
+
+    // 1024 elements of each argument keep even vec4 inputs and outputs well inside L1
+    constexpr std::size_t count = 1024;
+
+    template <typename T> std::vector<T> inputs(const float lo, const float hi, const std::uint32_t seed){
+        random r;
+        r.state ^= seed * 0x9e3779b9u;
+        std::vector<T> values(count);
+        for(T& value : values){ value = make(r, lo, hi, static_cast<T*>(nullptr)); }
+        return values;
+    }
+
+    // builtins
+
+    template <typename T, typename F, typename... A> void run_builtin(const options& o, const std::string& name, const F& function, const std::vector<A>&... args){
+        if(!o.selected(name)){ return; }
+
+        std::vector<decltype(function(args[0]...))> out(count);
+        const double seconds = best_seconds(o, [&](){
+            for(std::size_t i = 0; i < count; ++i){ out[i] = function(args[i]...); }
+            keep(out[0]);
+        });
+        report_builtin(o, name, traits<T>::name(), seconds / count * 1e9, traits<T>::components);
+    }
+
+    // inputs default to (0.05, 0.95), inside the domain of every builtin including asin, acos, log and inversesqrt
+    template <typename... T, typename F> void unary(const options& o, const std::string& name, const F& function, const float lo = 0.05f, const float hi = 0.95f){
+        (run_builtin<T>(o, name, function, inputs<T>(lo, hi, 1)), ...);
+    }
+
+    template <typename... T, typename F> void binary(const options& o, const std::string& name, const F& function, const float lo = 0.05f, const float hi = 0.95f){
+        (run_builtin<T>(o, name, function, inputs<T>(lo, hi, 1), inputs<T>(lo, hi, 2)), ...);
+    }
+
+    template <typename... T, typename F> void ternary(const options& o, const std::string& name, const F& function, const float lo = 0.05f, const float hi = 0.95f){
+        (run_builtin<T>(o, name, function, inputs<T>(lo, hi, 1), inputs<T>(lo, hi, 2), inputs<T>(lo, hi, 3)), ...);
+    }
+
+    // refract takes its ratio as a plain float for every vector type
+    template <typename... T, typename F> void vector_vector_float(const options& o, const std::string& name, const F& function){
+        (run_builtin<T>(o, name, function, inputs<T>(-1.0f, 1.0f, 1), inputs<T>(-1.0f, 1.0f, 2), inputs<float>(0.5f, 1.0f, 3)), ...);
+    }
+
+    #define GLIC_BENCH_UNARY(name, ...) unary<float, vec2, vec3, vec4>(o, #name, [](const auto& x){ return glic::name(x); }, ##__VA_ARGS__)
+    #define GLIC_BENCH_FAST(name, ...) unary<float, vec2, vec3, vec4>(o, #name "/fast", [](const auto& x){ return glic::name(x, precision::fast); }, ##__VA_ARGS__)
+    #define GLIC_BENCH_BINARY(name, ...) binary<float, vec2, vec3, vec4>(o, #name, [](const auto& x, const auto& y){ return glic::name(x, y); }, ##__VA_ARGS__)
+    #define GLIC_BENCH_TERNARY(name, ...) ternary<float, vec2, vec3, vec4>(o, #name, [](const auto& x, const auto& y, const auto& z){ return glic::name(x, y, z); }, ##__VA_ARGS__)
+
+    void builtins(const options& o){
+        print_header(o);
+
+        // trigonometry
+        GLIC_BENCH_UNARY(radians);
+        GLIC_BENCH_UNARY(degrees);
+        GLIC_BENCH_UNARY(sin);
+        GLIC_BENCH_FAST(sin);
+        GLIC_BENCH_UNARY(cos);
+        GLIC_BENCH_FAST(cos);
+        GLIC_BENCH_UNARY(tan);
+        GLIC_BENCH_FAST(tan);
+        GLIC_BENCH_UNARY(asin);
+        GLIC_BENCH_UNARY(acos);
+        GLIC_BENCH_UNARY(atan);
+        binary<float, vec2, vec3, vec4>(o, "atan2", [](const auto& y, const auto& x){ return glic::atan(y, x); }, -1.0f, 1.0f);
+
+        // exponential
+        GLIC_BENCH_BINARY(pow);
+        binary<float, vec2, vec3, vec4>(o, "pow/fast", [](const auto& x, const auto& y){ return glic::pow(x, y, precision::fast); });
+        GLIC_BENCH_UNARY(exp);
+        GLIC_BENCH_FAST(exp);
+        GLIC_BENCH_UNARY(log);
+        GLIC_BENCH_FAST(log);
+        GLIC_BENCH_UNARY(exp2);
+        GLIC_BENCH_FAST(exp2);
+        GLIC_BENCH_UNARY(log2);
+        GLIC_BENCH_FAST(log2);
+        GLIC_BENCH_UNARY(sqrt);
+        GLIC_BENCH_UNARY(inversesqrt);
+        GLIC_BENCH_FAST(inversesqrt);
+
+        // common, sign and friends get inputs on both sides of zero
+        GLIC_BENCH_UNARY(abs, -1.0f, 1.0f);
+        GLIC_BENCH_UNARY(sign, -1.0f, 1.0f);
+        GLIC_BENCH_UNARY(floor, -4.0f, 4.0f);
+        GLIC_BENCH_UNARY(ceil, -4.0f, 4.0f);
+        GLIC_BENCH_UNARY(fract, -4.0f, 4.0f);
+        GLIC_BENCH_BINARY(mod, 0.5f, 4.0f);
+        GLIC_BENCH_BINARY(min);
+        GLIC_BENCH_BINARY(max);
+        GLIC_BENCH_TERNARY(clamp);
+        GLIC_BENCH_TERNARY(mix);
+        GLIC_BENCH_BINARY(step);
+        ternary<float, vec2, vec3, vec4>(o, "smoothstep", [](const auto& x, const auto& y, const auto& z){ return glic::smoothstep(x * 0.5f, y * 0.5f + 0.5f, z); });
+
+        // geometric
+        GLIC_BENCH_UNARY(length);
+        GLIC_BENCH_BINARY(distance);
+        GLIC_BENCH_BINARY(dot);
+        binary<vec3>(o, "cross", [](const vec3& x, const vec3& y){ return glic::cross(x, y); });
+        GLIC_BENCH_UNARY(normalize);
+        GLIC_BENCH_TERNARY(faceforward, -1.0f, 1.0f);
+        GLIC_BENCH_BINARY(reflect, -1.0f, 1.0f);
+        vector_vector_float<float, vec2, vec3, vec4>(o, "refract", [](const auto& i, const auto& n, const float eta){ return glic::refract(i, n, eta); });
+    }
+
+    // apply and zip take the scalar function as a template argument, so every lane is a direct call the compiler can inline
+    // (min becomes minps, floor and fract roundps when the target has sse4.1); the _pointer rows make the same calls through a function
+    // pointer read from a volatile, as apply and zip did before, so the compiler cannot turn it back into a direct call
+    vec4 apply_pointer(const vec4& v, gl1float* const volatile& function){ return vec4(function(v.x), function(v.y), function(v.z), function(v.w)); }
+    vec4 zip_pointer(const vec4& a, const vec4& b, gl2float* const volatile& function){ return vec4(function(a.x, b.x), function(a.y, b.y), function(a.z, b.z), function(a.w, b.w)); }
+
+    template <typename F, typename P> void lane_dispatch_case(const options& o, const std::string& name, const F& direct, const P& pointer){
+        std::vector<vec4> out(count);
+        double direct_seconds = 0.0, pointer_seconds = 0.0;
+        if(o.selected(name + "_template")){
+            direct_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < count; ++i){ out[i] = direct(i); } keep(out[0]); });
+            report_workload(o, name + "_template", direct_seconds / count * 1e9, "ns/vec4");
+        }
+        if(o.selected(name + "_pointer")){
+            pointer_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < count; ++i){ out[i] = pointer(i); } keep(out[0]); });
+            report_workload(o, name + "_pointer", pointer_seconds / count * 1e9, "ns/vec4");
+        }
+        if(direct_seconds > 0.0 && pointer_seconds > 0.0){ report_workload(o, name + "_speedup", pointer_seconds / direct_seconds, "x"); }
+    }
+
+    void lane_dispatch(const options& o){
+        const std::vector<vec4> x = inputs<vec4>(-4.0f, 4.0f, 1), y = inputs<vec4>(-4.0f, 4.0f, 2);
+        gl1float* const volatile floor_function = glic::floor;
+        gl1float* const volatile fract_function = glic::fract;
+        gl2float* const volatile min_function = glic::min;
+
+        lane_dispatch_case(o, "apply/floor", [&](const std::size_t i){ return x[i].apply<glic::floor>(); }, [&](const std::size_t i){ return apply_pointer(x[i], floor_function); });
+        lane_dispatch_case(o, "apply/fract", [&](const std::size_t i){ return x[i].apply<glic::fract>(); }, [&](const std::size_t i){ return apply_pointer(x[i], fract_function); });
+        lane_dispatch_case(o, "zip/min", [&](const std::size_t i){ return vec4::zip<glic::min>(x[i], y[i]); }, [&](const std::size_t i){ return zip_pointer(x[i], y[i], min_function); });
+    }
+
+    // floor and fract + abs against the same lanes written with std:: directly; the builtins are std:: at run time in every
+    // standard (constant.h), so a ratio well above 1 means one of them stopped reaching it or lost roundps
+    template <typename F, typename R> void rounding_case(const options& o, const std::string& name, const F& builtin, const R& reference){
+        const std::vector<vec4> x = inputs<vec4>(-4.0f, 4.0f, 3);
+        std::vector<vec4> out(count);
+        double builtin_seconds = 0.0, reference_seconds = 0.0;
+        if(o.selected(name + "_glic")){
+            builtin_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < count; ++i){ out[i] = builtin(x[i]); } keep(out[0]); });
+            report_workload(o, name + "_glic", builtin_seconds / count * 1e9, "ns/vec4");
+        }
+        if(o.selected(name + "_std")){
+            reference_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < count; ++i){ out[i] = reference(x[i]); } keep(out[0]); });
+            report_workload(o, name + "_std", reference_seconds / count * 1e9, "ns/vec4");
+        }
+        if(builtin_seconds > 0.0 && reference_seconds > 0.0){ report_workload(o, name + "_ratio", builtin_seconds / reference_seconds, "x"); }
+    }
+
+    void rounding(const options& o){
+        rounding_case(o, "rounding/floor", [](const vec4& v){ return glic::floor(v); }, [](const vec4& v){
+            return vec4(std::floor(v.x), std::floor(v.y), std::floor(v.z), std::floor(v.w));
+        });
+        rounding_case(o, "rounding/fract_abs", [](const vec4& v){ return glic::fract(v) + glic::abs(v); }, [](const vec4& v){
+            return vec4(v.x - std::floor(v.x) + std::abs(v.x), v.y - std::floor(v.y) + std::abs(v.y), v.z - std::floor(v.z) + std::abs(v.z), v.w - std::floor(v.w) + std::abs(v.w));
+        });
+    }
+
+    // full shader workloads, timed over whole frames through the tiled renderer
+
+    vec4 plasma(const vec2 fragCoord, const uniforms& inputs){
+        const vec2 uv = fragCoord / inputs.resolution * 10.0f;
+        const float t = inputs.time;
+        float v = sin(uv.x + t) + sin((uv.y + t) * 0.5f) + sin((uv.x + uv.y + t) * 0.5f);
+        const vec2 c = uv + vec2(5.0f * sin(t / 3.0f), 5.0f * cos(t / 2.0f));
+        v += sin(sqrt(dot(c, c) + 1.0f) + t);
+        v *= 0.5f;
+        return vec4(sin(v * 3.14159265f) * 0.5f + 0.5f, cos(v * 3.14159265f) * 0.5f + 0.5f, 0.5f, 1.0f);
+    }
+
+    // sphere on a plane, sphere traced with up to 64 steps, lit with a blinn-phong highlight and a soft horizon fade
+    float scene(const vec3 p){ return min(length(p - vec3(0.0f, 1.0f, 0.0f)) - 1.0f, p.y); }
+
+    vec3 scene_normal(const vec3 p){
+        const float e = 1e-3f;
+        return normalize(vec3(
+            scene(p + vec3(e, 0.0f, 0.0f)) - scene(p - vec3(e, 0.0f, 0.0f)),
+            scene(p + vec3(0.0f, e, 0.0f)) - scene(p - vec3(0.0f, e, 0.0f)),
+            scene(p + vec3(0.0f, 0.0f, e)) - scene(p - vec3(0.0f, 0.0f, e))
+        ));
+    }
+
+    vec4 raymarch(const vec2 fragCoord, const uniforms& inputs){
+        const vec2 uv = (fragCoord * 2.0f - inputs.resolution) / inputs.resolution.y;
+        const vec3 origin(0.0f, 1.0f, -4.0f);
+        const vec3 direction = normalize(vec3(uv.x, uv.y, 1.5f));
+
+        float t = 0.0f;
+        for(int i = 0; i < 64 && t < 20.0f; ++i){
+            const float d = scene(origin + direction * t);
+            if(d < 1e-3f){ break; }
+            t += d;
+        }
+
+        const vec3 sky(0.6f, 0.7f, 0.9f);
+        if(t >= 20.0f){ return vec4(sky.x, sky.y, sky.z, 1.0f); }
+
+        const vec3 p = origin + direction * t, n = scene_normal(p);
+        const vec3 light = normalize(vec3(0.6f, 0.8f, -0.4f));
+        const float diffuse = max(dot(n, light), 0.0f);
+        const float highlight = pow(max(dot(reflect(direction, n), light), 0.0f), 32.0f);
+        const vec3 color = mix(vec3(0.8f, 0.3f, 0.2f) * (diffuse + 0.1f) + highlight, sky, smoothstep(5.0f, 20.0f, t));
+        return vec4(color.x, color.y, color.z, 1.0f);
+    }
+
+    // anti aliased grid lines, the line width comes from fwidth so it needs the quad renderer
+    quad<vec4> grid(const quad<vec2>& fragCoord, const uniforms& inputs){
+        const quad<vec2> uv = fragCoord / inputs.resolution * 20.0f;
+        const quad<vec2> distance = abs(fract(uv - 0.5f) - 0.5f) / fwidth(uv);
+        const quad<float> line = per_lane([](const vec2 d){ return 1.0f - min(min(d.x, d.y), 1.0f); }, distance);
+        return per_lane([](const float l){ return vec4(l, l, l, 1.0f); }, line);
+    }
+
+    template <typename F> void frame_workload(const options& o, const std::string& name, const F& frame){
+        if(!o.selected(name)){ return; }
+        const double seconds = best_seconds(o, frame);
+        report_workload(o, name, 512.0 * 512.0 / seconds * 1e-6, "Mpix/s");
+    }
+
+    void shaders(const options& o){
+        std::vector<std::uint8_t> pixels(512 * 512 * 4);
+        const uniforms inputs(vec2(512.0f, 512.0f), 1.5f);
+
+        thread_pool single(1);
+        render_options one;
+        one.pool = &single;
+        const render_options all;
+        const std::string threads = std::to_string(thread_pool::shared().size());
+
+        const bool parallel = thread_pool::shared().size() > 1;
+
+        frame_workload(o, "plasma/1t", [&](){ render(plasma, inputs, pixels.data(), one); });
+        if(parallel){ frame_workload(o, "plasma/" + threads + "t", [&](){ render(plasma, inputs, pixels.data(), all); }); }
+        frame_workload(o, "raymarch/1t", [&](){ render(raymarch, inputs, pixels.data(), one); });
+        if(parallel){ frame_workload(o, "raymarch/" + threads + "t", [&](){ render(raymarch, inputs, pixels.data(), all); }); }
+        frame_workload(o, "grid_quads/1t", [&](){ render_quads(grid, inputs, pixels.data(), one); });
+        if(parallel){ frame_workload(o, "grid_quads/" + threads + "t", [&](){ render_quads(grid, inputs, pixels.data(), all); }); }
+    }
+
+    // a 1024 x 1024 texture drawn rotated by 30 degrees with trilinear filtering, so fetches walk the texture diagonally,
+    // once from the tiled layout and once from the linear one
+    void textures(const options& o){
+        const int size = 1024;
+        std::vector<std::uint8_t> texels(static_cast<std::size_t>(size) * size * 4);
+        random r;
+        for(std::uint8_t& texel : texels){ texel = static_cast<std::uint8_t>(r.next(0.0f, 256.0f)); }
+
+        std::vector<std::uint8_t> pixels(512 * 512 * 4);
+        const uniforms inputs(vec2(512.0f, 512.0f));
+        thread_pool single(1);
+        render_options one;
+        one.pool = &single;
+
+        for(const texture_layout layout : {texture_layout::tiled, texture_layout::linear}){
+            sampler2D sampler(size, size, texels.data(), sampler_state(), layout);
+            sampler.generate_mipmaps();
+
+            const float c = std::cos(0.5235988f), s = std::sin(0.5235988f);
+            const auto shader = [&](const quad<vec2>& fragCoord, const uniforms& inputs){
+                const quad<vec2> uv = per_lane([&](const vec2 p){ const vec2 q = p / inputs.resolution - 0.5f; return vec2(c * q.x - s * q.y, s * q.x + c * q.y) * 1.3f; }, fragCoord);
+                return texture(sampler, uv);
+            };
+
+            const std::string name = std::string("texture_rotated/") + (layout == texture_layout::tiled ? "tiled" : "linear") + "/1t";
+            frame_workload(o, name, [&](){ render_quads(shader, inputs, pixels.data(), one); });
+        }
+    }
+
+    // four million vertices through one mat4, the batch transform against a plain triple loop over float arrays
+    void transforms(const options& o){
+        const std::size_t vertices = o.quick ? (1u << 18) : (1u << 22);
+        std::vector<vec4> in(vertices), out(vertices);
+        random r;
+        for(vec4& v : in){ v = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), 1.0f); }
+
+        mat4 m;
+        for(int c = 0; c < 4; ++c){ m[c] = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+
+        if(o.selected("transform/batch")){
+            const double seconds = best_seconds(o, [&](){ batch::transform(m, in, out); keep(out[0]); });
+            report_workload(o, "transform/batch", seconds / vertices * 1e9, "ns/vertex");
+        }
+
+        if(o.selected("transform/scalar_loop")){
+            float elements[4][4];
+            for(int c = 0; c < 4; ++c){ elements[c][0] = m[c].x; elements[c][1] = m[c].y; elements[c][2] = m[c].z; elements[c][3] = m[c].w; }
+
+            const double seconds = best_seconds(o, [&](){
+                const float* source = &in[0].x;
+                float* target = &out[0].x;
+                for(std::size_t v = 0; v < vertices; ++v){
+                    for(int row = 0; row < 4; ++row){
+                        float sum = 0.0f;
+                        for(int c = 0; c < 4; ++c){ sum += elements[c][row] * source[4 * v + c]; }
+                        target[4 * v + row] = sum;
+                    }
+                }
+                keep(out[0]);
+            });
+            report_workload(o, "transform/scalar_loop", seconds / vertices * 1e9, "ns/vertex");
+        }
+    }
+
+    // the same seven op pipeline once as separate array passes with intermediates and once as a fused lazy expression
+    //   out = clamp(sqrt(mix(a, b, smoothstep(0.2, 0.8, x)) * k + sin(x) * 0.5), 0, 1)
+    // bandwidth is the traffic each version must move (reads plus writes of every pass), divided by its time
+    void fusion(const options& o){
+        const std::size_t n = o.quick ? (1u << 20) : (1u << 23);
+        std::vector<float> x(n), a(n), b(n), out(n), t1(n), t2(n), t3(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){ x[i] = r.next(0.0f, 1.0f); a[i] = r.next(0.0f, 1.0f); b[i] = r.next(0.0f, 1.0f); }
+        const float k = 0.75f;
+        const double bytes = static_cast<double>(n) * sizeof(float);
+
+        if(o.selected("fusion/passes")){
+            const double seconds = best_seconds(o, [&](){
+                batch::smoothstep(0.2f, 0.8f, x, t1);                      // reads 1, writes 1
+                batch::mix(a, b, t1, t2);                                   // reads 3, writes 1
+                for(std::size_t i = 0; i < n; ++i){ t2[i] *= k; }           // reads 1, writes 1
+                batch::sin(x, t3);                                          // reads 1, writes 1
+                for(std::size_t i = 0; i < n; ++i){ t2[i] += t3[i] * 0.5f; } // reads 2, writes 1
+                batch::sqrt(t2, t1);                                        // reads 1, writes 1
+                batch::clamp(t1, 0.0f, 1.0f, out);                          // reads 1, writes 1
+                keep(out[0]);
+            });
+            report_workload(o, "fusion/passes", seconds * 1e3, "ms");
+            report_workload(o, "fusion/passes_bandwidth", 17.0 * bytes / seconds * 1e-9, "GB/s");
+        }
+
+        if(o.selected("fusion/lazy")){
+            const double seconds = best_seconds(o, [&](){
+                const auto ax = lazy::ref(x);
+                lazy::into(out) = clamp(sqrt(mix(lazy::ref(a), lazy::ref(b), smoothstep(0.2f, 0.8f, ax)) * k + sin(ax) * 0.5f), 0.0f, 1.0f);
+                keep(out[0]);
+            });
+            report_workload(o, "fusion/lazy", seconds * 1e3, "ms");
+            // reads x, a and b once and writes out once
+            report_workload(o, "fusion/lazy_bandwidth", 4.0 * bytes / seconds * 1e-9, "GB/s");
+            report_workload(o, "fusion/traffic_saved", (17.0 - 4.0) * bytes * 1e-6, "MB");
+        }
+    }
+
+    // streams over vec4 buffers stored as float and as half, out = mix(a, b, t) and out = normalize(mix(a, b, t))
+    // the half versions move half the bytes and convert inside the same fused loop, so they win where the loop is bandwidth
+    // bound and break even once the arithmetic (the square root and divide of normalize) is the limit; bandwidth counts
+    // the bytes each version moves (two reads and a write per element)
+    void half_storage(const options& o){
+        const std::size_t n = o.quick ? (1u << 18) : (1u << 21);
+        std::vector<vec4> a(n), b(n), out(n);
+        std::vector<f16vec4> a16(n), b16(n), out16(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){
+            a[i] = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f));
+            b[i] = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f));
+        }
+        batch::to_half(a, a16);
+        batch::to_half(b, b16);
+        const float t = 0.3f;
+        const double elements = static_cast<double>(n);
+
+        const auto compare = [&](const std::string& name, const auto& float32, const auto& float16){
+            double float_seconds = 0.0, half_seconds = 0.0;
+
+            if(o.selected(name + "_float32")){
+                float_seconds = best_seconds(o, [&](){ float32(); keep(out[0]); });
+                report_workload(o, name + "_float32", float_seconds * 1e3, "ms");
+                report_workload(o, name + "_float32_bandwidth", 3.0 * sizeof(vec4) * elements / float_seconds * 1e-9, "GB/s");
+            }
+
+            if(o.selected(name + "_float16")){
+                half_seconds = best_seconds(o, [&](){ float16(); keep(out16[0]); });
+                report_workload(o, name + "_float16", half_seconds * 1e3, "ms");
+                report_workload(o, name + "_float16_bandwidth", 3.0 * sizeof(f16vec4) * elements / half_seconds * 1e-9, "GB/s");
+            }
+
+            if(float_seconds > 0.0 && half_seconds > 0.0){ report_workload(o, name + "_speedup", float_seconds / half_seconds, "x"); }
+        };
+
+        compare("half/mix",
+            [&](){ lazy::into(out) = mix(lazy::ref(a), lazy::ref(b), t); },
+            [&](){ lazy::into(out16) = mix(lazy::ref(a16), lazy::ref(b16), t); });
+
+        compare("half/mix_normalize",
+            [&](){ lazy::into(out) = normalize(mix(lazy::ref(a), lazy::ref(b), t)); },
+            [&](){ lazy::into(out16) = normalize(mix(lazy::ref(a16), lazy::ref(b16), t)); });
+
+        // read plus written bytes
+        if(o.selected("half/to_half")){
+            const double seconds = best_seconds(o, [&](){ batch::to_half(a, out16); keep(out16[0]); });
+            report_workload(o, "half/to_half", (sizeof(vec4) + sizeof(f16vec4)) * elements / seconds * 1e-9, "GB/s");
+        }
+
+        if(o.selected("half/to_float")){
+            const double seconds = best_seconds(o, [&](){ batch::to_float(a16, out); keep(out[0]); });
+            report_workload(o, "half/to_float", (sizeof(vec4) + sizeof(f16vec4)) * elements / seconds * 1e-9, "GB/s");
+        }
+    }
+
+    // a blend of buffers holding denormals, where every multiply takes a microcode assist unless flush_denormals is active
+    void denormals(const options& o){
+        const std::size_t n = 1u << 16;
+        std::vector<vec4> a(n), b(n), out(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){
+            a[i] = vec4(r.next(1.0f, 8.0f), r.next(1.0f, 8.0f), r.next(1.0f, 8.0f), r.next(1.0f, 8.0f)) * 1e-39f;
+            b[i] = vec4(r.next(1.0f, 8.0f), r.next(1.0f, 8.0f), r.next(1.0f, 8.0f), r.next(1.0f, 8.0f)) * 1e-39f;
+        }
+        const float t = 0.3f;
+        const double elements = static_cast<double>(n);
+
+        double plain_seconds = 0.0, flushed_seconds = 0.0;
+        if(o.selected("denormal/mix")){
+            plain_seconds = best_seconds(o, [&](){ lazy::into(out) = mix(lazy::ref(a), lazy::ref(b), t); keep(out[0]); });
+            report_workload(o, "denormal/mix", plain_seconds / elements * 1e9, "ns/element");
+        }
+
+        if(o.selected("denormal/mix_flushed")){
+            const flush_denormals mode;
+            flushed_seconds = best_seconds(o, [&](){ lazy::into(out) = mix(lazy::ref(a), lazy::ref(b), t); keep(out[0]); });
+            report_workload(o, "denormal/mix_flushed", flushed_seconds / elements * 1e9, "ns/element");
+        }
+
+        if(plain_seconds > 0.0 && flushed_seconds > 0.0){ report_workload(o, "denormal/flush_speedup", plain_seconds / flushed_seconds, "x"); }
+    }
+
+    // the gradient noise most shaders carry around: a sin based hash and a gradient from its angle, evaluated one sample
+    // at a time, as the reference for the noise section
+    float reference_hash(const vec2 p){ return fract(sin(dot(p, vec2(127.1f, 311.7f))) * 43758.5453f); }
+    float reference_hash(const vec3 p){ return fract(sin(dot(p, vec3(127.1f, 311.7f, 74.7f))) * 43758.5453f); }
+
+    float reference_ramp(const vec2 i, const vec2 f){
+        const float angle = 6.2831853f * reference_hash(i);
+        return dot(vec2(cos(angle), sin(angle)), f);
+    }
+
+    float reference_ramp(const vec3 i, const vec3 f){
+        const vec3 g = vec3(reference_hash(i), reference_hash(i + 19.19f), reference_hash(i + 47.47f)) * 2.0f - 1.0f;
+        return dot(g, f);
+    }
+
+    float reference_gradient(const vec2 p){
+        const vec2 i = floor(p), f = fract(p), u = f * f * (3.0f - 2.0f * f);
+        return mix(
+            mix(reference_ramp(i, f), reference_ramp(i + vec2(1, 0), f - vec2(1, 0)), u.x),
+            mix(reference_ramp(i + vec2(0, 1), f - vec2(0, 1)), reference_ramp(i + vec2(1, 1), f - vec2(1, 1)), u.x), u.y);
+    }
+
+    float reference_gradient(const vec3 p){
+        const vec3 i = floor(p), f = fract(p), u = f * f * (3.0f - 2.0f * f);
+        return mix(
+            mix(mix(reference_ramp(i, f), reference_ramp(i + vec3(1, 0, 0), f - vec3(1, 0, 0)), u.x),
+                mix(reference_ramp(i + vec3(0, 1, 0), f - vec3(0, 1, 0)), reference_ramp(i + vec3(1, 1, 0), f - vec3(1, 1, 0)), u.x), u.y),
+            mix(mix(reference_ramp(i + vec3(0, 0, 1), f - vec3(0, 0, 1)), reference_ramp(i + vec3(1, 0, 1), f - vec3(1, 0, 1)), u.x),
+                mix(reference_ramp(i + vec3(0, 1, 1), f - vec3(0, 1, 1)), reference_ramp(i + vec3(1, 1, 1), f - vec3(1, 1, 1)), u.x), u.y), u.z);
+    }
+
+    // million samples per second on one core, the glic functions through their batch overloads
+    void noise_functions(const options& o){
+        const std::size_t n = 1u << 14;
+        std::vector<vec2> p2(n);
+        std::vector<vec3> p3(n);
+        std::vector<vec4> p4(n);
+        std::vector<float> out(n);
+        std::vector<vec2> cells(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){
+            p2[i] = vec2(r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f));
+            p3[i] = vec3(r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f));
+            p4[i] = vec4(r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f));
+        }
+
+        const auto measure = [&](const std::string& name, const auto& kernel){
+            if(!o.selected(name)){ return 0.0; }
+            const double seconds = best_seconds(o, kernel);
+            report_workload(o, name, n / seconds * 1e-6, "Msamples/s");
+            return seconds;
+        };
+
+        const double reference2 = measure("noise/reference_gradient2", [&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = reference_gradient(p2[i]); } keep(out[0]); });
+        const double gradient2 = measure("noise/gradient2", [&](){ noise::gradient(p2, out); keep(out[0]); });
+        if(reference2 > 0.0 && gradient2 > 0.0){ report_workload(o, "noise/gradient2_speedup", reference2 / gradient2, "x"); }
+
+        const double reference3 = measure("noise/reference_gradient3", [&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = reference_gradient(p3[i]); } keep(out[0]); });
+        const double gradient3 = measure("noise/gradient3", [&](){ noise::gradient(p3, out); keep(out[0]); });
+        if(reference3 > 0.0 && gradient3 > 0.0){ report_workload(o, "noise/gradient3_speedup", reference3 / gradient3, "x"); }
+
+        measure("noise/gradient4", [&](){ noise::gradient(p4, out); keep(out[0]); });
+        measure("noise/value3", [&](){ noise::value(p3, out); keep(out[0]); });
+        measure("noise/simplex2", [&](){ noise::simplex(p2, out); keep(out[0]); });
+        measure("noise/simplex3", [&](){ noise::simplex(p3, out); keep(out[0]); });
+        measure("noise/simplex4", [&](){ noise::simplex(p4, out); keep(out[0]); });
+        measure("noise/worley2", [&](){ noise::worley(p2, cells); keep(cells[0]); });
+        measure("noise/worley3", [&](){ noise::worley(p3, cells); keep(cells[0]); });
+        measure("noise/fbm5_simplex3", [&](){ noise::fbm([](const vec3 q){ return noise::simplex(q); }, batch::span<const vec3>(p3), batch::span<float>(out), 5); keep(out[0]); });
+    }
+
+    // the cosine palette of many shaders, gamma corrected, against the same palette baked into a 256 sample table
+    // (by the compiler from c++20 on, where cos and pow are constexpr; at startup before)
+    GLIC_CONSTEXPR20 vec3 palette(const float t){ return pow(0.5f + 0.5f * cos(6.2831853f * (t + vec3(0.0f, 0.33f, 0.67f))), vec3(2.2f)); }
+
+    #if defined(GLIC_CONSTEXPR_MATH)
+        constexpr auto palette_table = bake<256>(0.0f, 1.0f, palette);
+    #else
+        const auto palette_table = bake<256>(0.0f, 1.0f, palette);
+    #endif
+
+    void tables(const options& o){
+        const std::size_t n = 1u << 14;
+        std::vector<float> t(n);
+        std::vector<vec3> out(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){ t[i] = r.next(0.0f, 1.0f); }
+
+        double direct_seconds = 0.0, baked_seconds = 0.0;
+        if(o.selected("table/palette_direct")){
+            direct_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = palette(t[i]); } keep(out[0]); });
+            report_workload(o, "table/palette_direct", direct_seconds / n * 1e9, "ns/sample");
+        }
+
+        if(o.selected("table/palette_baked")){
+            baked_seconds = best_seconds(o, [&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = palette_table(t[i]); } keep(out[0]); });
+            report_workload(o, "table/palette_baked", baked_seconds / n * 1e9, "ns/sample");
+        }
+
+        if(direct_seconds > 0.0 && baked_seconds > 0.0){ report_workload(o, "table/palette_speedup", direct_seconds / baked_seconds, "x"); }
+    }
+
+    // the batch kernels at every dispatch level the cpu supports, in ns per element over buffers that stay in L2
+    // (the other sections run at the selected level, set GLIC_FORCE_ISA to pin it)
+    void dispatch_levels(const options& o){
+        const std::size_t n = 1u << 14;
+        std::vector<float> angle(n), exponent(n), scalars(n);
+        std::vector<vec3> normals(n), normals_out(n);
+        std::vector<vec4> a(n), b(n);
+        std::vector<f16vec4> packed(n);
+        random r;
+        for(std::size_t i = 0; i < n; ++i){
+            angle[i] = r.next(-8.0f, 8.0f);
+            exponent[i] = r.next(-20.0f, 20.0f);
+            normals[i] = vec3(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f));
+            a[i] = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f));
+            b[i] = vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f));
+        }
+
+        const isa previous = dispatch::selected();
+        for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+            if(level > dispatch::detect()){ break; }
+            dispatch::use(level);
+            const std::string suffix = std::string("_") + dispatch::name(level);
+
+            const auto measure = [&](const std::string& name, const auto& kernel){
+                if(!o.selected(name + suffix)){ return; }
+                const double seconds = best_seconds(o, kernel);
+                report_workload(o, name + suffix, seconds / n * 1e9, "ns/element");
+            };
+
+            measure("dispatch/sin", [&](){ batch::sin(angle, scalars); keep(scalars[0]); });
+            measure("dispatch/sin_fast", [&](){ batch::sin(angle, scalars, precision::fast); keep(scalars[0]); });
+            measure("dispatch/exp2_fast", [&](){ batch::exp2(exponent, scalars, precision::fast); keep(scalars[0]); });
+            measure("dispatch/normalize_vec3", [&](){ batch::normalize(normals, normals_out); keep(normals_out[0]); });
+            measure("dispatch/length_vec3", [&](){ batch::length(normals, scalars); keep(scalars[0]); });
+            measure("dispatch/dot_vec4", [&](){ batch::dot(a, b, scalars); keep(scalars[0]); });
+            measure("dispatch/to_half_vec4", [&](){ batch::to_half(a, packed); keep(packed[0]); });
+        }
+        dispatch::use(previous);
+    }
+};
+
+int main(int argc, char** argv){
+    options o;
+    for(int i = 1; i < argc; ++i){
+        if(!std::strcmp(argv[i], "--csv")){
+            o.csv = true;
+        } else if(!std::strcmp(argv[i], "--quick")){
+            o.quick = true;
+        } else if(!std::strcmp(argv[i], "--filter") && i + 1 < argc){
+            o.filter = argv[++i];
+        } else {
+            std::fprintf(stderr, "usage: %s [--csv] [--quick] [--filter text]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    builtins(o);
+    if(!o.csv){ std::printf("\n%-42s %12s\n", "workload", "value"); }
+    lane_dispatch(o);
+    rounding(o);
+    shaders(o);
+    textures(o);
+    transforms(o);
+    fusion(o);
+    half_storage(o);
+    denormals(o);
+    noise_functions(o);
+    tables(o);
+    dispatch_levels(o);
+
+    #if defined(GLIC_INSTRUMENT)
+        std::fprintf(stderr, "\n");
+        instrument::report(stderr);
+    #endif
+    return 0;
+}
@@ -0,0 +1,178 @@
+#ifndef GLIC_APPROX_HEADER
+#define GLIC_APPROX_HEADER
+
+#include <cstdint>
+#include <cstring>
+#include "constant.h"
+
+// branch free polynomial versions of the transcendental builtins, used by the precision::fast tier
+// every lane runs the same instruction sequence so loops over them vectorize; choices between lanes go through detail::select,
+// which blends with integer masks so the compiler cannot sink either side into a branch (with the default -ftrapping-math it
+// would then refuse to if-convert the loop)
+// the coefficients are the cephes single precision minimax polynomials
+//
+// max error against the double precision libm result, measured over every float in the listed domain:
+//   sin, cos      |x| <= pi            1.5 ulp
+//                 |x| <= 8192          7.9e-8 absolute   (the reduction error is absolute, so ulp grows near the zeros;
+//                                                         larger |x| is not bounded)
+//   tan           sin(x) / cos(x) of the above, so the relative error grows near the zeros and poles
+//   exp           [-105, 88.7]         1 ulp    (denormal results included, below rounds to zero, above is inf)
+//   exp2          [-151, 128)          1.3 ulp  (denormal results included, below rounds to zero, above is inf)
+//   log           positive normals     0.9 ulp  (zero, negatives, denormals and inf are unspecified)
+//   log2          positive normals     1.5 ulp
+//   inversesqrt   positive normals     3.2 ulp
+//   pow           x > 0                the error of exp2(y * log2(x)), as GLSL defines pow; grows with |y * log2(x)|
+// nan inputs produce unspecified results, though never undefined behaviour (the conversions to int go through truncate)
+// from c++20 on they are constexpr (bits and from_bits become std::bit_cast), and give the same results at compile time
+
+namespace glic {
+    namespace approx {
+        namespace detail {
+            #if defined(GLIC_CONSTEXPR_MATH)
+                constexpr std::uint32_t bits(const float x){ return std::bit_cast<std::uint32_t>(x); }
+                constexpr float from_bits(const std::uint32_t u){ return std::bit_cast<float>(u); }
+            #else
+                inline std::uint32_t bits(const float x){ std::uint32_t u; std::memcpy(&u, &x, sizeof(u)); return u; }
+                inline float from_bits(const std::uint32_t u){ float x; std::memcpy(&x, &u, sizeof(x)); return x; }
+            #endif
+
+            // a where condition holds, b otherwise
+            GLIC_CONSTEXPR20 float select(const bool condition, const float a, const float b){
+                const std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+                return from_bits((bits(a) & mask) | (bits(b) & ~mask));
+            }
+
+            GLIC_CONSTEXPR20 float clamp(const float x, const float minval, const float maxval){
+                const float low = select(x < minval, minval, x);
+                return select(low > maxval, maxval, low);
+            }
+
+            // x >= 0 truncated to an int, with nan and x >= 2^29 taken as 0 first: converting either is undefined behaviour in
+            // c++, and the margin leaves room to add to the result
+            GLIC_CONSTEXPR20 std::int32_t truncate(const float x){ return static_cast<std::int32_t>(select(x < 536870912.0f, x, 0.0f)); }
+
+            // 2^n for integer n in [-126, 127]
+            GLIC_CONSTEXPR20 float exponent(const std::int32_t n){ return from_bits(static_cast<std::uint32_t>(n + 127) << 23); }
+
+            // p * 2^n for n in [-160, 128], applied in two halves so denormal results and 2^128 * p < 1 still come out right
+            GLIC_CONSTEXPR20 float scale(const float p, const std::int32_t n){
+                const std::int32_t half = n >> 1;
+                return p * exponent(half) * exponent(n - half);
+            }
+
+            // sin and cos share the cephes reduction to [-pi/4, pi/4] and pick a polynomial per octant
+            GLIC_CONSTEXPR20 float sincos(const float x, const std::int32_t shift){
+                const float ax = from_bits(bits(x) & 0x7fffffffu);
+                const std::int32_t j = (truncate(ax * 1.27323954473516f) + 1) & ~1;
+                const float y = static_cast<float>(j);
+                const float r = ((ax - y * 0.78515625f) - y * 2.4187564849853515625e-4f) - y * 3.77489497744594108e-8f;
+                const float z = r * r;
+
+                const float s = ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+                const float c = ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+
+                // shift is 0 for sin and 2 for cos, which moves the octant a quarter turn
+                const std::int32_t octant = j + shift;
+                const float value = select((octant & 2) != 0, c, s);
+                const std::uint32_t sign = (static_cast<std::uint32_t>(octant & 4) << 29) ^ (shift ? 0u : (bits(x) & 0x80000000u));
+                return from_bits(bits(value) ^ sign);
+            }
+
+            // splits x into exponent e and mantissa m in [sqrt(1/2), sqrt(2)), returns m - 1 with the polynomial tail of log(m) in y
+            GLIC_CONSTEXPR20 float log_parts(const float x, float& e, float& y){
+                const std::uint32_t u = bits(x);
+                const std::int32_t exponent = static_cast<std::int32_t>(u >> 23) - 126;
+                const float m = from_bits((u & 0x007fffffu) | 0x3f000000u);
+
+                const bool low = m < 0.707106781186547524f;
+                e = static_cast<float>(exponent - static_cast<std::int32_t>(low));
+                const float doubled = m + m;
+                const float t = select(low, doubled, m) - 1.0f;
+
+                const float z = t * t;
+                float p = 7.0376836292e-2f;
+                p = p * t - 1.1514610310e-1f;
+                p = p * t + 1.1676998740e-1f;
+                p = p * t - 1.2420140846e-1f;
+                p = p * t + 1.4249322787e-1f;
+                p = p * t - 1.6668057665e-1f;
+                p = p * t + 2.0000714765e-1f;
+                p = p * t - 2.4999993993e-1f;
+                p = p * t + 3.3333331174e-1f;
+                y = p * t * z - 0.5f * z;
+                return t;
+            }
+        };
+
+        GLIC_CONSTEXPR20 float sin(const float x){ return detail::sincos(x, 0); }
+        GLIC_CONSTEXPR20 float cos(const float x){ return detail::sincos(x, 2); }
+        GLIC_CONSTEXPR20 float tan(const float x){ return detail::sincos(x, 0) / detail::sincos(x, 2); }
+
+        GLIC_CONSTEXPR20 float exp2(const float x){
+            // out of range inputs clamp to values whose result rounds to zero or overflows to inf by itself
+            const float clamped = detail::clamp(x, -151.0f, 128.0f);
+
+            // round to nearest, the offset keeps the truncating conversion positive
+            const std::int32_t n = detail::truncate(clamped + 160.5f) - 160;
+            const float f = clamped - static_cast<float>(n);
+
+            float p = 1.535336188319500e-4f;
+            p = p * f + 1.339887440266574e-3f;
+            p = p * f + 9.618437357674640e-3f;
+            p = p * f + 5.550332471162809e-2f;
+            p = p * f + 2.402264791363012e-1f;
+            p = p * f + 6.931472028550421e-1f;
+            p = p * f + 1.0f;
+
+            return detail::scale(p, n);
+        }
+
+        GLIC_CONSTEXPR20 float exp(const float x){
+            const float clamped = detail::clamp(x, -105.0f, 89.0f);
+
+            // x = n * ln(2) + r with ln(2) split in two so r keeps full precision
+            const std::int32_t n = detail::truncate(clamped * 1.44269504088896341f + 160.5f) - 160;
+            const float fn = static_cast<float>(n);
+            const float r = (clamped - fn * 0.693359375f) + fn * 2.12194440e-4f;
+            const float z = r * r;
+
+            float p = 1.9875691500e-4f;
+            p = p * r + 1.3981999507e-3f;
+            p = p * r + 8.3334519073e-3f;
+            p = p * r + 4.1665795894e-2f;
+            p = p * r + 1.6666665459e-1f;
+            p = p * r + 5.0000001201e-1f;
+            p = p * z + r + 1.0f;
+
+            return detail::scale(p, n);
+        }
+
+        GLIC_CONSTEXPR20 float log(const float x){
+            float e, y;
+            const float t = detail::log_parts(x, e, y);
+            return (t + (y + e * -2.12194440e-4f)) + e * 0.693359375f;
+        }
+
+        GLIC_CONSTEXPR20 float log2(const float x){
+            float e, y;
+            const float t = detail::log_parts(x, e, y);
+            return (((y * 0.44269504088896340736f + t * 0.44269504088896340736f) + y) + t) + e;
+        }
+
+        GLIC_CONSTEXPR20 float pow(const float x, const float y){
+            const float result = exp2(y * log2(x));
+            return detail::select(x == 0.0f, 0.0f, result);
+        }
+
+        GLIC_CONSTEXPR20 float inversesqrt(const float x){
+            float y = detail::from_bits(0x5f375a86u - (detail::bits(x) >> 1));
+            const float half = 0.5f * x;
+            y = y * (1.5f - half * y * y);
+            y = y * (1.5f - half * y * y);
+            y = y * (1.5f - half * y * y);
+            return y;
+        }
+    };
+};
+
+#endif
\ No newline at end of file
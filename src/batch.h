@@ -0,0 +1,618 @@
+#ifndef GLIC_BATCH_HEADER
+#define GLIC_BATCH_HEADER
+
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "dispatch.h"
+#include "glic.h"
+
+#if defined(GLIC_DISPATCH)
+    #include <immintrin.h>
+#endif
+
+// array versions of the builtins, for running one function over a whole buffer at a time
+// every function writes its result into a caller provided output of the same length as its inputs
+// inputs and outputs may be the same buffer
+// every loop runs through dispatch::run, so it is compiled for each instruction set level and the cpu's best one is used
+
+namespace glic {
+    namespace batch {
+        // non owning view of contiguous elements, used for array of structs buffers (span<vec3>) and single streams (span<float>)
+        template <typename T> struct span {
+            T* data;
+            std::size_t size;
+
+            span() : data(nullptr), size(0) {}
+            span(T* data, std::size_t size) : data(data), size(size) {}
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value || std::is_same<U, T>::value>::type>
+            span(std::vector<U>& v) : data(v.data()), size(v.size()) {}
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            span(const std::vector<U>& v) : data(v.data()), size(v.size()) {}
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            span(const span<U>& v) : data(v.data), size(v.size) {}
+
+            T& operator[](const std::size_t i) const { return data[i]; }
+
+            T* begin() const { return data; }
+            T* end() const { return data + size; }
+        };
+
+        // structure of arrays views, one stream per component
+        // T is float for outputs and const float for inputs, a mutable view converts to a read only one
+
+        template <typename T> struct vec2_soa_view {
+            span<T> x, y;
+
+            vec2_soa_view() {}
+            vec2_soa_view(span<T> x, span<T> y) : x(x), y(y) { assert(x.size == y.size); }
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            vec2_soa_view(const vec2_soa_view<U>& v) : x(v.x), y(v.y) {}
+
+            std::size_t size() const { return x.size; }
+
+            vec2 operator[](const std::size_t i) const { return vec2(x[i], y[i]); }
+            void set(const std::size_t i, const vec2& v) const { x[i] = v.x; y[i] = v.y; }
+        };
+
+        template <typename T> struct vec3_soa_view {
+            span<T> x, y, z;
+
+            vec3_soa_view() {}
+            vec3_soa_view(span<T> x, span<T> y, span<T> z) : x(x), y(y), z(z) { assert(x.size == y.size && x.size == z.size); }
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            vec3_soa_view(const vec3_soa_view<U>& v) : x(v.x), y(v.y), z(v.z) {}
+
+            std::size_t size() const { return x.size; }
+
+            vec3 operator[](const std::size_t i) const { return vec3(x[i], y[i], z[i]); }
+            void set(const std::size_t i, const vec3& v) const { x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+        };
+
+        template <typename T> struct vec4_soa_view {
+            span<T> x, y, z, w;
+
+            vec4_soa_view() {}
+            vec4_soa_view(span<T> x, span<T> y, span<T> z, span<T> w) : x(x), y(y), z(z), w(w) { assert(x.size == y.size && x.size == z.size && x.size == w.size); }
+
+            template <typename U, typename = typename std::enable_if<std::is_same<const U, T>::value>::type>
+            vec4_soa_view(const vec4_soa_view<U>& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+            std::size_t size() const { return x.size; }
+
+            vec4 operator[](const std::size_t i) const { return vec4(x[i], y[i], z[i], w[i]); }
+            void set(const std::size_t i, const vec4& v) const { x[i] = v.x; y[i] = v.y; z[i] = v.z; w[i] = v.w; }
+        };
+
+        // conversion between array of structs and structure of arrays
+
+        inline void to_soa(const span<const vec2> aos, const vec2_soa_view<float> soa){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ soa.set(i, aos[i]); } });
+        }
+
+        inline void to_soa(const span<const vec3> aos, const vec3_soa_view<float> soa){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ soa.set(i, aos[i]); } });
+        }
+
+        inline void to_soa(const span<const vec4> aos, const vec4_soa_view<float> soa){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ soa.set(i, aos[i]); } });
+        }
+
+        inline void to_aos(const vec2_soa_view<const float> soa, const span<vec2> aos){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ aos[i] = soa[i]; } });
+        }
+
+        inline void to_aos(const vec3_soa_view<const float> soa, const span<vec3> aos){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ aos[i] = soa[i]; } });
+        }
+
+        inline void to_aos(const vec4_soa_view<const float> soa, const span<vec4> aos){
+            assert(aos.size == soa.size());
+            dispatch::run([&](){ for(std::size_t i = 0; i < aos.size; ++i){ aos[i] = soa[i]; } });
+        }
+
+        // conversion between float and half precision buffers (see half.h), eight lanes at a time with F16C (compiled in, or
+        // picked by the dispatch level)
+        // vecN buffers are converted as one flat float stream, except the padded vec3 of GLIC_SIMD builds
+
+        namespace detail {
+            #if defined(GLIC_HALF_F16C) || defined(GLIC_DISPATCH)
+                // the avx2 and avx512 dispatch levels always have F16C, so these also run when half.h was compiled without it
+                #if defined(__GNUC__)
+                    #define GLIC_F16C_TARGET __attribute__((target("f16c")))
+                #else
+                    #define GLIC_F16C_TARGET
+                #endif
+
+                GLIC_F16C_TARGET inline void to_half_f16c(const float* in, half* out, const std::size_t n){
+                    std::size_t i = 0;
+                    for(; i + 8 <= n; i += 8){ _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm256_cvtps_ph(_mm256_loadu_ps(in + i), 0)); }
+                    for(; i < n; ++i){ out[i].bits = static_cast<std::uint16_t>(_cvtss_sh(in[i], 0)); }
+                }
+
+                GLIC_F16C_TARGET inline void to_float_f16c(const half* in, float* out, const std::size_t n){
+                    std::size_t i = 0;
+                    for(; i + 8 <= n; i += 8){ _mm256_storeu_ps(out + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i)))); }
+                    for(; i < n; ++i){ out[i] = _cvtsh_ss(in[i].bits); }
+                }
+
+                #undef GLIC_F16C_TARGET
+            #endif
+
+            inline void to_half(const float* in, half* out, const std::size_t n){
+                #if defined(GLIC_HALF_F16C)
+                    to_half_f16c(in, out, n);
+                #else
+                    #if defined(GLIC_DISPATCH)
+                        if(dispatch::selected() >= isa::avx2){ to_half_f16c(in, out, n); return; }
+                    #endif
+                    dispatch::run([&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = half(in[i]); } });
+                #endif
+            }
+
+            inline void to_float(const half* in, float* out, const std::size_t n){
+                #if defined(GLIC_HALF_F16C)
+                    to_float_f16c(in, out, n);
+                #else
+                    #if defined(GLIC_DISPATCH)
+                        if(dispatch::selected() >= isa::avx2){ to_float_f16c(in, out, n); return; }
+                    #endif
+                    dispatch::run([&](){ for(std::size_t i = 0; i < n; ++i){ out[i] = in[i]; } });
+                #endif
+            }
+        };
+
+        inline void to_half(const span<const float> in, const span<half> out){ assert(in.size == out.size); detail::to_half(in.data, out.data, in.size); }
+        inline void to_half(const span<const vec2> in, const span<f16vec2> out){ assert(in.size == out.size); detail::to_half(reinterpret_cast<const float*>(in.data), reinterpret_cast<half*>(out.data), 2 * in.size); }
+        inline void to_half(const span<const vec4> in, const span<f16vec4> out){ assert(in.size == out.size); detail::to_half(reinterpret_cast<const float*>(in.data), reinterpret_cast<half*>(out.data), 4 * in.size); }
+
+        inline void to_half(const span<const vec3> in, const span<f16vec3> out){
+            assert(in.size == out.size);
+            #if defined(GLIC_SIMD)
+                dispatch::run([&](){ for(std::size_t i = 0; i < in.size; ++i){ out[i] = f16vec3(in[i]); } });
+            #else
+                detail::to_half(reinterpret_cast<const float*>(in.data), reinterpret_cast<half*>(out.data), 3 * in.size);
+            #endif
+        }
+
+        inline void to_float(const span<const half> in, const span<float> out){ assert(in.size == out.size); detail::to_float(in.data, out.data, in.size); }
+        inline void to_float(const span<const f16vec2> in, const span<vec2> out){ assert(in.size == out.size); detail::to_float(reinterpret_cast<const half*>(in.data), reinterpret_cast<float*>(out.data), 2 * in.size); }
+        inline void to_float(const span<const f16vec4> in, const span<vec4> out){ assert(in.size == out.size); detail::to_float(reinterpret_cast<const half*>(in.data), reinterpret_cast<float*>(out.data), 4 * in.size); }
+
+        inline void to_float(const span<const f16vec3> in, const span<vec3> out){
+            assert(in.size == out.size);
+            #if defined(GLIC_SIMD)
+                dispatch::run([&](){ for(std::size_t i = 0; i < in.size; ++i){ out[i] = in[i]; } });
+            #else
+                detail::to_float(reinterpret_cast<const half*>(in.data), reinterpret_cast<float*>(out.data), 3 * in.size);
+            #endif
+        }
+
+        // owning structure of arrays containers
+
+        struct vec2_soa {
+            std::vector<float> x, y;
+
+            vec2_soa() {}
+            explicit vec2_soa(const std::size_t size) : x(size), y(size) {}
+            explicit vec2_soa(const span<const vec2> aos) : x(aos.size), y(aos.size) { to_soa(aos, *this); }
+
+            std::size_t size() const { return x.size(); }
+            void resize(const std::size_t size){ x.resize(size); y.resize(size); }
+
+            vec2 operator[](const std::size_t i) const { return vec2(x[i], y[i]); }
+            void set(const std::size_t i, const vec2& v){ x[i] = v.x; y[i] = v.y; }
+
+            operator vec2_soa_view<float>(){ return vec2_soa_view<float>(x, y); }
+            operator vec2_soa_view<const float>() const { return vec2_soa_view<const float>(x, y); }
+        };
+
+        struct vec3_soa {
+            std::vector<float> x, y, z;
+
+            vec3_soa() {}
+            explicit vec3_soa(const std::size_t size) : x(size), y(size), z(size) {}
+            explicit vec3_soa(const span<const vec3> aos) : x(aos.size), y(aos.size), z(aos.size) { to_soa(aos, *this); }
+
+            std::size_t size() const { return x.size(); }
+            void resize(const std::size_t size){ x.resize(size); y.resize(size); z.resize(size); }
+
+            vec3 operator[](const std::size_t i) const { return vec3(x[i], y[i], z[i]); }
+            void set(const std::size_t i, const vec3& v){ x[i] = v.x; y[i] = v.y; z[i] = v.z; }
+
+            operator vec3_soa_view<float>(){ return vec3_soa_view<float>(x, y, z); }
+            operator vec3_soa_view<const float>() const { return vec3_soa_view<const float>(x, y, z); }
+        };
+
+        struct vec4_soa {
+            std::vector<float> x, y, z, w;
+
+            vec4_soa() {}
+            explicit vec4_soa(const std::size_t size) : x(size), y(size), z(size), w(size) {}
+            explicit vec4_soa(const span<const vec4> aos) : x(aos.size), y(aos.size), z(aos.size), w(aos.size) { to_soa(aos, *this); }
+
+            std::size_t size() const { return x.size(); }
+            void resize(const std::size_t size){ x.resize(size); y.resize(size); z.resize(size); w.resize(size); }
+
+            vec4 operator[](const std::size_t i) const { return vec4(x[i], y[i], z[i], w[i]); }
+            void set(const std::size_t i, const vec4& v){ x[i] = v.x; y[i] = v.y; z[i] = v.z; w[i] = v.w; }
+
+            operator vec4_soa_view<float>(){ return vec4_soa_view<float>(x, y, z, w); }
+            operator vec4_soa_view<const float>() const { return vec4_soa_view<const float>(x, y, z, w); }
+        };
+
+        // loop kernels, the builtin is a template argument so it inlines into the loop body
+        namespace detail {
+            template <typename T, T (*function)(T)> void map(const span<const T> x, const span<T> out){
+                assert(x.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(x[i]); } });
+            }
+
+            template <typename T, T (*function)(T, T)> void map(const span<const T> x, const span<const T> y, const span<T> out){
+                assert(x.size == out.size && y.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(x[i], y[i]); } });
+            }
+
+            template <typename T, typename F> void map(const span<const T> x, const span<T> out, const F& function){
+                assert(x.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(x[i]); } });
+            }
+
+            template <typename T, typename F> void map(const span<const T> x, const span<const T> y, const span<const T> z, const span<T> out, const F& function){
+                assert(x.size == out.size && y.size == out.size && z.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(x[i], y[i], z[i]); } });
+            }
+
+            template <typename T, typename F> void map(const span<const T> x, const span<const T> y, const span<T> out, const F& function){
+                assert(x.size == out.size && y.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(x[i], y[i]); } });
+            }
+
+            template <typename T> void reduce(const span<const T> x, const span<const T> y, const span<float> out){
+                assert(x.size == out.size && y.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = glic::dot(x[i], y[i]); } });
+            }
+        };
+
+        // trigonometry and exponential, the untagged versions follow the translation unit's default tier (see glic.h)
+        // and the tagged versions pick one explicitly: batch::sin(x, out, precision::fast)
+
+        inline namespace GLIC_PRECISION_NAMESPACE {
+            inline void sin(const span<const float> angle, const span<float> out){ detail::map<float, glic::sin>(angle, out); }
+            inline void sin(const span<const vec2> angle, const span<vec2> out){ detail::map<vec2, glic::sin>(angle, out); }
+            inline void sin(const span<const vec3> angle, const span<vec3> out){ detail::map<vec3, glic::sin>(angle, out); }
+            inline void sin(const span<const vec4> angle, const span<vec4> out){ detail::map<vec4, glic::sin>(angle, out); }
+
+            inline void sin(const vec2_soa_view<const float> angle, const vec2_soa_view<float> out){ sin(angle.x, out.x); sin(angle.y, out.y); }
+            inline void sin(const vec3_soa_view<const float> angle, const vec3_soa_view<float> out){ sin(angle.x, out.x); sin(angle.y, out.y); sin(angle.z, out.z); }
+            inline void sin(const vec4_soa_view<const float> angle, const vec4_soa_view<float> out){ sin(angle.x, out.x); sin(angle.y, out.y); sin(angle.z, out.z); sin(angle.w, out.w); }
+
+            inline void cos(const span<const float> angle, const span<float> out){ detail::map<float, glic::cos>(angle, out); }
+            inline void cos(const span<const vec2> angle, const span<vec2> out){ detail::map<vec2, glic::cos>(angle, out); }
+            inline void cos(const span<const vec3> angle, const span<vec3> out){ detail::map<vec3, glic::cos>(angle, out); }
+            inline void cos(const span<const vec4> angle, const span<vec4> out){ detail::map<vec4, glic::cos>(angle, out); }
+
+            inline void cos(const vec2_soa_view<const float> angle, const vec2_soa_view<float> out){ cos(angle.x, out.x); cos(angle.y, out.y); }
+            inline void cos(const vec3_soa_view<const float> angle, const vec3_soa_view<float> out){ cos(angle.x, out.x); cos(angle.y, out.y); cos(angle.z, out.z); }
+            inline void cos(const vec4_soa_view<const float> angle, const vec4_soa_view<float> out){ cos(angle.x, out.x); cos(angle.y, out.y); cos(angle.z, out.z); cos(angle.w, out.w); }
+
+            inline void pow(const span<const float> x, const span<const float> y, const span<float> out){ detail::map<float, glic::pow>(x, y, out); }
+            inline void pow(const span<const vec2> x, const span<const vec2> y, const span<vec2> out){ detail::map<vec2, glic::pow>(x, y, out); }
+            inline void pow(const span<const vec3> x, const span<const vec3> y, const span<vec3> out){ detail::map<vec3, glic::pow>(x, y, out); }
+            inline void pow(const span<const vec4> x, const span<const vec4> y, const span<vec4> out){ detail::map<vec4, glic::pow>(x, y, out); }
+
+            inline void pow(const vec2_soa_view<const float> x, const vec2_soa_view<const float> y, const vec2_soa_view<float> out){ pow(x.x, y.x, out.x); pow(x.y, y.y, out.y); }
+            inline void pow(const vec3_soa_view<const float> x, const vec3_soa_view<const float> y, const vec3_soa_view<float> out){ pow(x.x, y.x, out.x); pow(x.y, y.y, out.y); pow(x.z, y.z, out.z); }
+            inline void pow(const vec4_soa_view<const float> x, const vec4_soa_view<const float> y, const vec4_soa_view<float> out){ pow(x.x, y.x, out.x); pow(x.y, y.y, out.y); pow(x.z, y.z, out.z); pow(x.w, y.w, out.w); }
+
+            inline void exp2(const span<const float> x, const span<float> out){ detail::map<float, glic::exp2>(x, out); }
+            inline void exp2(const span<const vec2> x, const span<vec2> out){ detail::map<vec2, glic::exp2>(x, out); }
+            inline void exp2(const span<const vec3> x, const span<vec3> out){ detail::map<vec3, glic::exp2>(x, out); }
+            inline void exp2(const span<const vec4> x, const span<vec4> out){ detail::map<vec4, glic::exp2>(x, out); }
+
+            inline void exp2(const vec2_soa_view<const float> x, const vec2_soa_view<float> out){ exp2(x.x, out.x); exp2(x.y, out.y); }
+            inline void exp2(const vec3_soa_view<const float> x, const vec3_soa_view<float> out){ exp2(x.x, out.x); exp2(x.y, out.y); exp2(x.z, out.z); }
+            inline void exp2(const vec4_soa_view<const float> x, const vec4_soa_view<float> out){ exp2(x.x, out.x); exp2(x.y, out.y); exp2(x.z, out.z); exp2(x.w, out.w); }
+
+            inline void log2(const span<const float> x, const span<float> out){ detail::map<float, glic::log2>(x, out); }
+            inline void log2(const span<const vec2> x, const span<vec2> out){ detail::map<vec2, glic::log2>(x, out); }
+            inline void log2(const span<const vec3> x, const span<vec3> out){ detail::map<vec3, glic::log2>(x, out); }
+            inline void log2(const span<const vec4> x, const span<vec4> out){ detail::map<vec4, glic::log2>(x, out); }
+
+            inline void log2(const vec2_soa_view<const float> x, const vec2_soa_view<float> out){ log2(x.x, out.x); log2(x.y, out.y); }
+            inline void log2(const vec3_soa_view<const float> x, const vec3_soa_view<float> out){ log2(x.x, out.x); log2(x.y, out.y); log2(x.z, out.z); }
+            inline void log2(const vec4_soa_view<const float> x, const vec4_soa_view<float> out){ log2(x.x, out.x); log2(x.y, out.y); log2(x.z, out.z); log2(x.w, out.w); }
+        };
+
+        template <typename Tier> void sin(const span<const float> angle, const span<float> out, const Tier tier){ detail::map(angle, out, [=](const float v){ return glic::sin(v, tier); }); }
+        template <typename Tier> void sin(const span<const vec2> angle, const span<vec2> out, const Tier tier){ detail::map(angle, out, [=](const vec2 v){ return glic::sin(v, tier); }); }
+        template <typename Tier> void sin(const span<const vec3> angle, const span<vec3> out, const Tier tier){ detail::map(angle, out, [=](const vec3 v){ return glic::sin(v, tier); }); }
+        template <typename Tier> void sin(const span<const vec4> angle, const span<vec4> out, const Tier tier){ detail::map(angle, out, [=](const vec4 v){ return glic::sin(v, tier); }); }
+
+        template <typename Tier> void sin(const vec2_soa_view<const float> angle, const vec2_soa_view<float> out, const Tier tier){ sin(angle.x, out.x, tier); sin(angle.y, out.y, tier); }
+        template <typename Tier> void sin(const vec3_soa_view<const float> angle, const vec3_soa_view<float> out, const Tier tier){ sin(angle.x, out.x, tier); sin(angle.y, out.y, tier); sin(angle.z, out.z, tier); }
+        template <typename Tier> void sin(const vec4_soa_view<const float> angle, const vec4_soa_view<float> out, const Tier tier){ sin(angle.x, out.x, tier); sin(angle.y, out.y, tier); sin(angle.z, out.z, tier); sin(angle.w, out.w, tier); }
+
+        template <typename Tier> void cos(const span<const float> angle, const span<float> out, const Tier tier){ detail::map(angle, out, [=](const float v){ return glic::cos(v, tier); }); }
+        template <typename Tier> void cos(const span<const vec2> angle, const span<vec2> out, const Tier tier){ detail::map(angle, out, [=](const vec2 v){ return glic::cos(v, tier); }); }
+        template <typename Tier> void cos(const span<const vec3> angle, const span<vec3> out, const Tier tier){ detail::map(angle, out, [=](const vec3 v){ return glic::cos(v, tier); }); }
+        template <typename Tier> void cos(const span<const vec4> angle, const span<vec4> out, const Tier tier){ detail::map(angle, out, [=](const vec4 v){ return glic::cos(v, tier); }); }
+
+        template <typename Tier> void cos(const vec2_soa_view<const float> angle, const vec2_soa_view<float> out, const Tier tier){ cos(angle.x, out.x, tier); cos(angle.y, out.y, tier); }
+        template <typename Tier> void cos(const vec3_soa_view<const float> angle, const vec3_soa_view<float> out, const Tier tier){ cos(angle.x, out.x, tier); cos(angle.y, out.y, tier); cos(angle.z, out.z, tier); }
+        template <typename Tier> void cos(const vec4_soa_view<const float> angle, const vec4_soa_view<float> out, const Tier tier){ cos(angle.x, out.x, tier); cos(angle.y, out.y, tier); cos(angle.z, out.z, tier); cos(angle.w, out.w, tier); }
+
+        template <typename Tier> void pow(const span<const float> x, const span<const float> y, const span<float> out, const Tier tier){ detail::map(x, y, out, [=](const float a, const float b){ return glic::pow(a, b, tier); }); }
+        template <typename Tier> void pow(const span<const vec2> x, const span<const vec2> y, const span<vec2> out, const Tier tier){ detail::map(x, y, out, [=](const vec2 a, const vec2 b){ return glic::pow(a, b, tier); }); }
+        template <typename Tier> void pow(const span<const vec3> x, const span<const vec3> y, const span<vec3> out, const Tier tier){ detail::map(x, y, out, [=](const vec3 a, const vec3 b){ return glic::pow(a, b, tier); }); }
+        template <typename Tier> void pow(const span<const vec4> x, const span<const vec4> y, const span<vec4> out, const Tier tier){ detail::map(x, y, out, [=](const vec4 a, const vec4 b){ return glic::pow(a, b, tier); }); }
+
+        template <typename Tier> void pow(const vec2_soa_view<const float> x, const vec2_soa_view<const float> y, const vec2_soa_view<float> out, const Tier tier){ pow(x.x, y.x, out.x, tier); pow(x.y, y.y, out.y, tier); }
+        template <typename Tier> void pow(const vec3_soa_view<const float> x, const vec3_soa_view<const float> y, const vec3_soa_view<float> out, const Tier tier){ pow(x.x, y.x, out.x, tier); pow(x.y, y.y, out.y, tier); pow(x.z, y.z, out.z, tier); }
+        template <typename Tier> void pow(const vec4_soa_view<const float> x, const vec4_soa_view<const float> y, const vec4_soa_view<float> out, const Tier tier){ pow(x.x, y.x, out.x, tier); pow(x.y, y.y, out.y, tier); pow(x.z, y.z, out.z, tier); pow(x.w, y.w, out.w, tier); }
+
+        template <typename Tier> void exp2(const span<const float> x, const span<float> out, const Tier tier){ detail::map(x, out, [=](const float v){ return glic::exp2(v, tier); }); }
+        template <typename Tier> void exp2(const span<const vec2> x, const span<vec2> out, const Tier tier){ detail::map(x, out, [=](const vec2 v){ return glic::exp2(v, tier); }); }
+        template <typename Tier> void exp2(const span<const vec3> x, const span<vec3> out, const Tier tier){ detail::map(x, out, [=](const vec3 v){ return glic::exp2(v, tier); }); }
+        template <typename Tier> void exp2(const span<const vec4> x, const span<vec4> out, const Tier tier){ detail::map(x, out, [=](const vec4 v){ return glic::exp2(v, tier); }); }
+
+        template <typename Tier> void exp2(const vec2_soa_view<const float> x, const vec2_soa_view<float> out, const Tier tier){ exp2(x.x, out.x, tier); exp2(x.y, out.y, tier); }
+        template <typename Tier> void exp2(const vec3_soa_view<const float> x, const vec3_soa_view<float> out, const Tier tier){ exp2(x.x, out.x, tier); exp2(x.y, out.y, tier); exp2(x.z, out.z, tier); }
+        template <typename Tier> void exp2(const vec4_soa_view<const float> x, const vec4_soa_view<float> out, const Tier tier){ exp2(x.x, out.x, tier); exp2(x.y, out.y, tier); exp2(x.z, out.z, tier); exp2(x.w, out.w, tier); }
+
+        template <typename Tier> void log2(const span<const float> x, const span<float> out, const Tier tier){ detail::map(x, out, [=](const float v){ return glic::log2(v, tier); }); }
+        template <typename Tier> void log2(const span<const vec2> x, const span<vec2> out, const Tier tier){ detail::map(x, out, [=](const vec2 v){ return glic::log2(v, tier); }); }
+        template <typename Tier> void log2(const span<const vec3> x, const span<vec3> out, const Tier tier){ detail::map(x, out, [=](const vec3 v){ return glic::log2(v, tier); }); }
+        template <typename Tier> void log2(const span<const vec4> x, const span<vec4> out, const Tier tier){ detail::map(x, out, [=](const vec4 v){ return glic::log2(v, tier); }); }
+
+        template <typename Tier> void log2(const vec2_soa_view<const float> x, const vec2_soa_view<float> out, const Tier tier){ log2(x.x, out.x, tier); log2(x.y, out.y, tier); }
+        template <typename Tier> void log2(const vec3_soa_view<const float> x, const vec3_soa_view<float> out, const Tier tier){ log2(x.x, out.x, tier); log2(x.y, out.y, tier); log2(x.z, out.z, tier); }
+        template <typename Tier> void log2(const vec4_soa_view<const float> x, const vec4_soa_view<float> out, const Tier tier){ log2(x.x, out.x, tier); log2(x.y, out.y, tier); log2(x.z, out.z, tier); log2(x.w, out.w, tier); }
+
+        inline void sqrt(const span<const float> x, const span<float> out){ detail::map<float, glic::sqrt>(x, out); }
+        inline void sqrt(const span<const vec2> x, const span<vec2> out){ detail::map<vec2, glic::sqrt>(x, out); }
+        inline void sqrt(const span<const vec3> x, const span<vec3> out){ detail::map<vec3, glic::sqrt>(x, out); }
+        inline void sqrt(const span<const vec4> x, const span<vec4> out){ detail::map<vec4, glic::sqrt>(x, out); }
+
+        // common
+
+        inline void clamp(const span<const float> x, const float minval, const float maxval, const span<float> out){ detail::map(x, out, [=](const float v){ return glic::clamp(v, minval, maxval); }); }
+        inline void clamp(const span<const vec2> x, const float minval, const float maxval, const span<vec2> out){ detail::map(x, out, [=](const vec2 v){ return glic::clamp(v, minval, maxval); }); }
+        inline void clamp(const span<const vec3> x, const float minval, const float maxval, const span<vec3> out){ detail::map(x, out, [=](const vec3 v){ return glic::clamp(v, minval, maxval); }); }
+        inline void clamp(const span<const vec4> x, const float minval, const float maxval, const span<vec4> out){ detail::map(x, out, [=](const vec4 v){ return glic::clamp(v, minval, maxval); }); }
+
+        inline void mix(const span<const float> x, const span<const float> y, const span<const float> a, const span<float> out){ detail::map(x, y, a, out, [](const float x, const float y, const float a){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec2> x, const span<const vec2> y, const span<const vec2> a, const span<vec2> out){ detail::map(x, y, a, out, [](const vec2 x, const vec2 y, const vec2 a){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec3> x, const span<const vec3> y, const span<const vec3> a, const span<vec3> out){ detail::map(x, y, a, out, [](const vec3 x, const vec3 y, const vec3 a){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec4> x, const span<const vec4> y, const span<const vec4> a, const span<vec4> out){ detail::map(x, y, a, out, [](const vec4 x, const vec4 y, const vec4 a){ return glic::mix(x, y, a); }); }
+
+        inline void mix(const span<const float> x, const span<const float> y, const float a, const span<float> out){ detail::map(x, y, out, [=](const float x, const float y){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec2> x, const span<const vec2> y, const float a, const span<vec2> out){ detail::map(x, y, out, [=](const vec2 x, const vec2 y){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec3> x, const span<const vec3> y, const float a, const span<vec3> out){ detail::map(x, y, out, [=](const vec3 x, const vec3 y){ return glic::mix(x, y, a); }); }
+        inline void mix(const span<const vec4> x, const span<const vec4> y, const float a, const span<vec4> out){ detail::map(x, y, out, [=](const vec4 x, const vec4 y){ return glic::mix(x, y, a); }); }
+
+        inline void smoothstep(const float edge0, const float edge1, const span<const float> x, const span<float> out){ detail::map(x, out, [=](const float v){ return glic::smoothstep(edge0, edge1, v); }); }
+        inline void smoothstep(const float edge0, const float edge1, const span<const vec2> x, const span<vec2> out){ detail::map(x, out, [=](const vec2 v){ return glic::smoothstep(edge0, edge1, v); }); }
+        inline void smoothstep(const float edge0, const float edge1, const span<const vec3> x, const span<vec3> out){ detail::map(x, out, [=](const vec3 v){ return glic::smoothstep(edge0, edge1, v); }); }
+        inline void smoothstep(const float edge0, const float edge1, const span<const vec4> x, const span<vec4> out){ detail::map(x, out, [=](const vec4 v){ return glic::smoothstep(edge0, edge1, v); }); }
+
+        inline void clamp(const vec2_soa_view<const float> x, const float minval, const float maxval, const vec2_soa_view<float> out){ clamp(x.x, minval, maxval, out.x); clamp(x.y, minval, maxval, out.y); }
+        inline void clamp(const vec3_soa_view<const float> x, const float minval, const float maxval, const vec3_soa_view<float> out){ clamp(x.x, minval, maxval, out.x); clamp(x.y, minval, maxval, out.y); clamp(x.z, minval, maxval, out.z); }
+        inline void clamp(const vec4_soa_view<const float> x, const float minval, const float maxval, const vec4_soa_view<float> out){ clamp(x.x, minval, maxval, out.x); clamp(x.y, minval, maxval, out.y); clamp(x.z, minval, maxval, out.z); clamp(x.w, minval, maxval, out.w); }
+
+        inline void mix(const vec2_soa_view<const float> x, const vec2_soa_view<const float> y, const vec2_soa_view<const float> a, const vec2_soa_view<float> out){ mix(x.x, y.x, a.x, out.x); mix(x.y, y.y, a.y, out.y); }
+        inline void mix(const vec3_soa_view<const float> x, const vec3_soa_view<const float> y, const vec3_soa_view<const float> a, const vec3_soa_view<float> out){ mix(x.x, y.x, a.x, out.x); mix(x.y, y.y, a.y, out.y); mix(x.z, y.z, a.z, out.z); }
+        inline void mix(const vec4_soa_view<const float> x, const vec4_soa_view<const float> y, const vec4_soa_view<const float> a, const vec4_soa_view<float> out){ mix(x.x, y.x, a.x, out.x); mix(x.y, y.y, a.y, out.y); mix(x.z, y.z, a.z, out.z); mix(x.w, y.w, a.w, out.w); }
+
+        inline void mix(const vec2_soa_view<const float> x, const vec2_soa_view<const float> y, const float a, const vec2_soa_view<float> out){ mix(x.x, y.x, a, out.x); mix(x.y, y.y, a, out.y); }
+        inline void mix(const vec3_soa_view<const float> x, const vec3_soa_view<const float> y, const float a, const vec3_soa_view<float> out){ mix(x.x, y.x, a, out.x); mix(x.y, y.y, a, out.y); mix(x.z, y.z, a, out.z); }
+        inline void mix(const vec4_soa_view<const float> x, const vec4_soa_view<const float> y, const float a, const vec4_soa_view<float> out){ mix(x.x, y.x, a, out.x); mix(x.y, y.y, a, out.y); mix(x.z, y.z, a, out.z); mix(x.w, y.w, a, out.w); }
+
+        inline void smoothstep(const float edge0, const float edge1, const vec2_soa_view<const float> x, const vec2_soa_view<float> out){ smoothstep(edge0, edge1, x.x, out.x); smoothstep(edge0, edge1, x.y, out.y); }
+        inline void smoothstep(const float edge0, const float edge1, const vec3_soa_view<const float> x, const vec3_soa_view<float> out){ smoothstep(edge0, edge1, x.x, out.x); smoothstep(edge0, edge1, x.y, out.y); smoothstep(edge0, edge1, x.z, out.z); }
+        inline void smoothstep(const float edge0, const float edge1, const vec4_soa_view<const float> x, const vec4_soa_view<float> out){ smoothstep(edge0, edge1, x.x, out.x); smoothstep(edge0, edge1, x.y, out.y); smoothstep(edge0, edge1, x.z, out.z); smoothstep(edge0, edge1, x.w, out.w); }
+
+        // geometric
+
+        inline void dot(const span<const vec2> x, const span<const vec2> y, const span<float> out){ detail::reduce(x, y, out); }
+        inline void dot(const span<const vec3> x, const span<const vec3> y, const span<float> out){ detail::reduce(x, y, out); }
+        inline void dot(const span<const vec4> x, const span<const vec4> y, const span<float> out){ detail::reduce(x, y, out); }
+
+        inline void length(const span<const vec2> x, const span<float> out){ detail::reduce(x, x, out); sqrt(out, out); }
+        inline void length(const span<const vec3> x, const span<float> out){ detail::reduce(x, x, out); sqrt(out, out); }
+        inline void length(const span<const vec4> x, const span<float> out){ detail::reduce(x, x, out); sqrt(out, out); }
+
+        inline void normalize(const span<const vec2> x, const span<vec2> out){ detail::map<vec2, glic::normalize>(x, out); }
+        inline void normalize(const span<const vec3> x, const span<vec3> out){ detail::map<vec3, glic::normalize>(x, out); }
+        inline void normalize(const span<const vec4> x, const span<vec4> out){ detail::map<vec4, glic::normalize>(x, out); }
+
+        inline void reflect(const span<const vec2> i, const span<const vec2> n, const span<vec2> out){ detail::map<vec2, glic::reflect>(i, n, out); }
+        inline void reflect(const span<const vec3> i, const span<const vec3> n, const span<vec3> out){ detail::map<vec3, glic::reflect>(i, n, out); }
+        inline void reflect(const span<const vec4> i, const span<const vec4> n, const span<vec4> out){ detail::map<vec4, glic::reflect>(i, n, out); }
+
+        inline void refract(const span<const vec2> i, const span<const vec2> n, const float eta, const span<vec2> out){ detail::map(i, n, out, [=](const vec2 i, const vec2 n){ return glic::refract(i, n, eta); }); }
+        inline void refract(const span<const vec3> i, const span<const vec3> n, const float eta, const span<vec3> out){ detail::map(i, n, out, [=](const vec3 i, const vec3 n){ return glic::refract(i, n, eta); }); }
+        inline void refract(const span<const vec4> i, const span<const vec4> n, const float eta, const span<vec4> out){ detail::map(i, n, out, [=](const vec4 i, const vec4 n){ return glic::refract(i, n, eta); }); }
+
+        // structure of arrays versions work stream by stream so every loop is over plain floats
+
+        inline void dot(const vec2_soa_view<const float> x, const vec2_soa_view<const float> y, const span<float> out){
+            assert(x.size() == out.size && y.size() == out.size);
+            dispatch::run([&](){ for(std::size_t i = 0; i < out.size; ++i){ out[i] = x.x[i] * y.x[i] + x.y[i] * y.y[i]; } });
+        }
+
+        inline void dot(const vec3_soa_view<const float> x, const vec3_soa_view<const float> y, const span<float> out){
+            assert(x.size() == out.size && y.size() == out.size);
+            dispatch::run([&](){ for(std::size_t i = 0; i < out.size; ++i){ out[i] = x.x[i] * y.x[i] + x.y[i] * y.y[i] + x.z[i] * y.z[i]; } });
+        }
+
+        inline void dot(const vec4_soa_view<const float> x, const vec4_soa_view<const float> y, const span<float> out){
+            assert(x.size() == out.size && y.size() == out.size);
+            dispatch::run([&](){ for(std::size_t i = 0; i < out.size; ++i){ out[i] = x.x[i] * y.x[i] + x.y[i] * y.y[i] + x.z[i] * y.z[i] + x.w[i] * y.w[i]; } });
+        }
+
+        inline void length(const vec2_soa_view<const float> x, const span<float> out){ dot(x, x, out); sqrt(out, out); }
+        inline void length(const vec3_soa_view<const float> x, const span<float> out){ dot(x, x, out); sqrt(out, out); }
+        inline void length(const vec4_soa_view<const float> x, const span<float> out){ dot(x, x, out); sqrt(out, out); }
+
+        inline void normalize(const vec2_soa_view<const float> x, const vec2_soa_view<float> out){
+            assert(x.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t i = 0; i < out.size(); ++i){
+                    const float length = glic::sqrt(x.x[i] * x.x[i] + x.y[i] * x.y[i]);
+                    out.x[i] = x.x[i] / length; out.y[i] = x.y[i] / length;
+                }
+            });
+        }
+
+        inline void normalize(const vec3_soa_view<const float> x, const vec3_soa_view<float> out){
+            assert(x.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t i = 0; i < out.size(); ++i){
+                    const float length = glic::sqrt(x.x[i] * x.x[i] + x.y[i] * x.y[i] + x.z[i] * x.z[i]);
+                    out.x[i] = x.x[i] / length; out.y[i] = x.y[i] / length; out.z[i] = x.z[i] / length;
+                }
+            });
+        }
+
+        inline void normalize(const vec4_soa_view<const float> x, const vec4_soa_view<float> out){
+            assert(x.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t i = 0; i < out.size(); ++i){
+                    const float length = glic::sqrt(x.x[i] * x.x[i] + x.y[i] * x.y[i] + x.z[i] * x.z[i] + x.w[i] * x.w[i]);
+                    out.x[i] = x.x[i] / length; out.y[i] = x.y[i] / length; out.z[i] = x.z[i] / length; out.w[i] = x.w[i] / length;
+                }
+            });
+        }
+
+        inline void reflect(const vec2_soa_view<const float> i, const vec2_soa_view<const float> n, const vec2_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t k = 0; k < out.size(); ++k){
+                    const float d = 2 * (n.x[k] * i.x[k] + n.y[k] * i.y[k]);
+                    out.x[k] = i.x[k] - d * n.x[k]; out.y[k] = i.y[k] - d * n.y[k];
+                }
+            });
+        }
+
+        inline void reflect(const vec3_soa_view<const float> i, const vec3_soa_view<const float> n, const vec3_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t k = 0; k < out.size(); ++k){
+                    const float d = 2 * (n.x[k] * i.x[k] + n.y[k] * i.y[k] + n.z[k] * i.z[k]);
+                    out.x[k] = i.x[k] - d * n.x[k]; out.y[k] = i.y[k] - d * n.y[k]; out.z[k] = i.z[k] - d * n.z[k];
+                }
+            });
+        }
+
+        inline void reflect(const vec4_soa_view<const float> i, const vec4_soa_view<const float> n, const vec4_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t k = 0; k < out.size(); ++k){
+                    const float d = 2 * (n.x[k] * i.x[k] + n.y[k] * i.y[k] + n.z[k] * i.z[k] + n.w[k] * i.w[k]);
+                    out.x[k] = i.x[k] - d * n.x[k]; out.y[k] = i.y[k] - d * n.y[k]; out.z[k] = i.z[k] - d * n.z[k]; out.w[k] = i.w[k] - d * n.w[k];
+                }
+            });
+        }
+
+        // total internal reflection lanes are +0 through a select, as in glic::refract (multiplying by a 0 / 1 mask would give
+        // -0 or nan there), and the square root is clamped so they do not take a nan through it
+
+        inline void refract(const vec2_soa_view<const float> i, const vec2_soa_view<const float> n, const float eta, const vec2_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t j = 0; j < out.size(); ++j){
+                    const float dotni = n.x[j] * i.x[j] + n.y[j] * i.y[j];
+                    const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+                    const float scale = eta * dotni + glic::sqrt(std::max(k, 0.0f));
+                    out.x[j] = k < 0.0f ? 0.0f : eta * i.x[j] - scale * n.x[j]; out.y[j] = k < 0.0f ? 0.0f : eta * i.y[j] - scale * n.y[j];
+                }
+            });
+        }
+
+        inline void refract(const vec3_soa_view<const float> i, const vec3_soa_view<const float> n, const float eta, const vec3_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t j = 0; j < out.size(); ++j){
+                    const float dotni = n.x[j] * i.x[j] + n.y[j] * i.y[j] + n.z[j] * i.z[j];
+                    const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+                    const float scale = eta * dotni + glic::sqrt(std::max(k, 0.0f));
+                    out.x[j] = k < 0.0f ? 0.0f : eta * i.x[j] - scale * n.x[j]; out.y[j] = k < 0.0f ? 0.0f : eta * i.y[j] - scale * n.y[j]; out.z[j] = k < 0.0f ? 0.0f : eta * i.z[j] - scale * n.z[j];
+                }
+            });
+        }
+
+        inline void refract(const vec4_soa_view<const float> i, const vec4_soa_view<const float> n, const float eta, const vec4_soa_view<float> out){
+            assert(i.size() == out.size() && n.size() == out.size());
+            dispatch::run([&](){
+                for(std::size_t j = 0; j < out.size(); ++j){
+                    const float dotni = n.x[j] * i.x[j] + n.y[j] * i.y[j] + n.z[j] * i.z[j] + n.w[j] * i.w[j];
+                    const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+                    const float scale = eta * dotni + glic::sqrt(std::max(k, 0.0f));
+                    out.x[j] = k < 0.0f ? 0.0f : eta * i.x[j] - scale * n.x[j]; out.y[j] = k < 0.0f ? 0.0f : eta * i.y[j] - scale * n.y[j]; out.z[j] = k < 0.0f ? 0.0f : eta * i.z[j] - scale * n.z[j]; out.w[j] = k < 0.0f ? 0.0f : eta * i.w[j] - scale * n.w[j];
+                }
+            });
+        }
+
+        // matrix, for running a vertex stage transform over a whole mesh
+        // the matrix is copied into locals first so stores to out cannot force it to be reloaded every element
+
+        inline void transform(const mat3& m, const span<const vec3> v, const span<vec3> out){
+            assert(v.size == out.size);
+            const mat3 matrix(m);
+            dispatch::run([&](){ for(std::size_t i = 0; i < out.size; ++i){ out[i] = matrix * v[i]; } });
+        }
+
+        inline void transform(const mat4& m, const span<const vec4> v, const span<vec4> out){
+            assert(v.size == out.size);
+            const mat4 matrix(m);
+            dispatch::run([&](){ for(std::size_t i = 0; i < out.size; ++i){ out[i] = matrix * v[i]; } });
+        }
+
+        inline void transform(const mat3& m, const vec3_soa_view<const float> v, const vec3_soa_view<float> out){
+            assert(v.size() == out.size());
+            const mat3 matrix(m);
+            dispatch::run([&](){
+                for(std::size_t i = 0; i < out.size(); ++i){
+                    const float x = v.x[i], y = v.y[i], z = v.z[i];
+                    out.x[i] = matrix[0].x * x + matrix[1].x * y + matrix[2].x * z;
+                    out.y[i] = matrix[0].y * x + matrix[1].y * y + matrix[2].y * z;
+                    out.z[i] = matrix[0].z * x + matrix[1].z * y + matrix[2].z * z;
+                }
+            });
+        }
+
+        inline void transform(const mat4& m, const vec4_soa_view<const float> v, const vec4_soa_view<float> out){
+            assert(v.size() == out.size());
+            const mat4 matrix(m);
+            dispatch::run([&](){
+                for(std::size_t i = 0; i < out.size(); ++i){
+                    const float x = v.x[i], y = v.y[i], z = v.z[i], w = v.w[i];
+                    out.x[i] = matrix[0].x * x + matrix[1].x * y + matrix[2].x * z + matrix[3].x * w;
+                    out.y[i] = matrix[0].y * x + matrix[1].y * y + matrix[2].y * z + matrix[3].y * w;
+                    out.z[i] = matrix[0].z * x + matrix[1].z * y + matrix[2].z * z + matrix[3].z * w;
+                    out.w[i] = matrix[0].w * x + matrix[1].w * y + matrix[2].w * z + matrix[3].w * w;
+                }
+            });
+        }
+    };
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,291 @@
+#ifndef GLIC_CONSTANT_HEADER
+#define GLIC_CONSTANT_HEADER
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if __cplusplus >= 202002L || (defined(_MSVC_LANG) && _MSVC_LANG >= 202002L)
+    #include <bit>
+#endif
+
+// compile time evaluation of the vector types and builtins
+// the vector types and the builtins that only add, multiply, compare and select are constexpr, so gradient ramps, palettes
+// and easing tables (see table.h) can be computed by the compiler; GLIC_CONSTEXPR marks them
+// abs, floor, ceil, fract and mod keep std:: at run time and use the compare and convert versions in detail below in constant
+// evaluation, which only needs to know which of the two it is: gcc >= 9, clang >= 9 and msvc >= 19.25 tell that in c++17 as
+// well (GLIC_CONSTEXPR_ROUNDING is defined then), GLIC_CONSTEXPR_ROUND marks them
+// builtins that go through <cmath> (sin, pow, sqrt, ...), the approx.h polynomials and the bit casts also need
+// std::is_constant_evaluated and std::bit_cast, so they are constexpr from c++20 on (GLIC_CONSTEXPR_MATH is defined then)
+// and plain inline functions before; GLIC_CONSTEXPR20 marks them
+// under GLIC_SIMD the vector operators are intrinsics, which only have a scalar twin for constant evaluation from c++20 on,
+// and the same holds for the counting wrapper of GLIC_INSTRUMENT, so in c++17 either one leaves GLIC_CONSTEXPR as inline
+//
+// in constant evaluation the cmath functions below use the double precision versions in glic::constant, so compile time
+// results of the exact tier are within an ulp of the run time ones (sqrt is exact, and abs, floor and ceil give the run time
+// bits); sin, cos and tan are only that accurate for |x| < 1e5, beyond that the reduction error grows with |x|
+
+#if defined(__cpp_lib_is_constant_evaluated) && defined(__cpp_lib_bit_cast)
+    #define GLIC_CONSTEXPR_MATH
+    #define GLIC_CONSTEXPR20 constexpr
+#else
+    #define GLIC_CONSTEXPR20 inline
+#endif
+
+#if defined(GLIC_CONSTEXPR_MATH) || (!defined(GLIC_SIMD) && !defined(GLIC_INSTRUMENT))
+    #define GLIC_CONSTEXPR constexpr
+#else
+    #define GLIC_CONSTEXPR inline
+#endif
+
+#if defined(GLIC_CONSTEXPR_MATH)
+    #define GLIC_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__clang__)
+    #if __has_builtin(__builtin_is_constant_evaluated)
+        #define GLIC_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+    #endif
+#elif (defined(__GNUC__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+    #define GLIC_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if defined(GLIC_CONSTANT_EVALUATED)
+    #define GLIC_CONSTEXPR_ROUNDING
+    #if defined(GLIC_CONSTEXPR_MATH) || (!defined(GLIC_SIMD) && !defined(GLIC_INSTRUMENT))
+        #define GLIC_CONSTEXPR_ROUND constexpr
+    #else
+        #define GLIC_CONSTEXPR_ROUND inline
+    #endif
+#else
+    #define GLIC_CONSTEXPR_ROUND inline
+#endif
+
+namespace glic {
+    namespace detail {
+        // true while the compiler evaluates a constant expression, always false before c++20
+        constexpr bool constant_evaluated(){
+            #if defined(GLIC_CONSTEXPR_MATH)
+                return std::is_constant_evaluated();
+            #else
+                return false;
+            #endif
+        }
+
+        // abs, floor and ceil from compares and an int conversion, for constant evaluation in c++17 too; they give what the std
+        // versions give down to the sign of zero, except that abs of a nan keeps its sign bit
+        // |x| >= 2^23 is already integral and so are inf and nan, which come back unchanged
+        constexpr float abs(const float x){ return x < 0.0f ? -x : x == 0.0f ? 0.0f : x; }
+
+        // floor for |x| < 2^31 through a truncating conversion, without the -0 and range cases; loops over it vectorize where
+        // std::floor does not (gcc keeps floorf scalar under -ftrapping-math, and a select for the range stops it too), which
+        // is what the noise.h lattice lookups use it for
+        constexpr float truncated_floor(const float x){
+            const std::int32_t i = static_cast<std::int32_t>(x);
+            return static_cast<float>(i - (x < static_cast<float>(i)));
+        }
+
+        constexpr float floor(const float x){
+            if(!(x > -8388608.0f && x < 8388608.0f)){ return x; }
+            const float t = truncated_floor(x);
+            return t == 0.0f ? x * 0.0f : t;
+        }
+
+        constexpr float ceil(const float x){ return -floor(-x); }
+    };
+
+    #if defined(GLIC_CONSTEXPR_MATH)
+    // constexpr double precision math for constant evaluation: plain argument reduction and series, slow but close to
+    // correctly rounded once narrowed to float
+    namespace constant {
+        constexpr double pi = 3.14159265358979323846;
+        constexpr double ln2 = 0.693147180559945309417;
+        constexpr double inf = std::numeric_limits<double>::infinity();
+        constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+
+        constexpr bool isnan(const double x){ return x != x; }
+        constexpr bool isinf(const double x){ return x == inf || x == -inf; }
+        constexpr bool signbit(const double x){ return (std::bit_cast<std::uint64_t>(x) >> 63) != 0; }
+
+        // exact for every double, -0.0 and values beyond 2^52 come back unchanged
+        constexpr double floor(const double x){
+            if(isnan(x) || x >= 4503599627370496.0 || x <= -4503599627370496.0){ return x; }
+            const double t = static_cast<double>(static_cast<std::int64_t>(x));
+            if(t == 0.0){ return x < 0.0 ? -1.0 : x * 0.0; }
+            return t > x ? t - 1.0 : t;
+        }
+
+        constexpr double ceil(const double x){ return -floor(-x); }
+        constexpr double abs(const double x){ return signbit(x) ? -x : x; }
+
+        // x * 2^n, one doubling at a time so denormal results round only once
+        constexpr double scale(double x, int n){
+            for(; n > 0; --n){ x *= 2.0; }
+            for(; n < 0; ++n){ x *= 0.5; }
+            return x;
+        }
+
+        // newton from a guess with half the exponent of x
+        constexpr double sqrt(const double x){
+            if(isnan(x) || x < 0.0){ return nan; }
+            if(x == 0.0 || isinf(x)){ return x; }
+            double y = 1.0;
+            for(double m = x; m > 4.0; m *= 0.25){ y *= 2.0; }
+            for(double m = x; m < 0.25; m *= 4.0){ y *= 0.5; }
+            for(int i = 0; i < 8; ++i){ y = 0.5 * (y + x / y); }
+            return y;
+        }
+
+        constexpr double exp(const double x){
+            if(isnan(x)){ return x; }
+            if(x > 710.0){ return inf; }
+            if(x < -746.0){ return 0.0; }
+
+            // x = k ln(2) + r with |r| <= ln(2) / 2, ln(2) in two parts so k * ln2_high is exact
+            const double k = floor(x / ln2 + 0.5);
+            const double r = (x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;
+            double term = 1.0, sum = 1.0;
+            for(int i = 1; i < 18; ++i){ term *= r / i; sum += term; }
+            return scale(sum, static_cast<int>(k));
+        }
+
+        constexpr double log(const double x){
+            if(isnan(x) || x < 0.0){ return nan; }
+            if(x == 0.0){ return -inf; }
+            if(isinf(x)){ return x; }
+
+            // x = m 2^e with m in [sqrt(1/2), sqrt(2)), log(m) = 2 atanh(s) for s = (m - 1) / (m + 1), |s| < 0.172
+            double m = x;
+            int e = 0;
+            for(; m >= 1.41421356237309504880; ++e){ m *= 0.5; }
+            for(; m < 0.70710678118654752440; --e){ m *= 2.0; }
+            const double s = (m - 1.0) / (m + 1.0), s2 = s * s;
+            double power = s, sum = 0.0;
+            for(int i = 1; i < 40; i += 2){ sum += power / i; power *= s2; }
+            return e * ln2 + 2.0 * sum;
+        }
+
+        // sin and cos of r in [-pi/4, pi/4] after taking out the quadrant, pi/2 in three parts for the reduction
+        constexpr double sincos(const double x, const int shift){
+            if(isnan(x) || isinf(x)){ return nan; }
+            const double k = floor(x / (0.5 * pi) + 0.5);
+            const double r = ((x - k * 1.57079632673412561417e+00) - k * 6.07710050630396597660e-11) - k * 2.02226624879595063154e-21;
+            const double r2 = r * r;
+
+            double sine = r, cosine = 1.0, term_s = r, term_c = 1.0;
+            for(int i = 1; i < 12; ++i){
+                term_s *= -r2 / ((2 * i) * (2 * i + 1));
+                term_c *= -r2 / ((2 * i - 1) * (2 * i));
+                sine += term_s;
+                cosine += term_c;
+            }
+
+            const double quadrant = k - 4.0 * floor(k * 0.25);
+            switch((static_cast<int>(quadrant) + shift) & 3){
+                case 0: return sine;
+                case 1: return cosine;
+                case 2: return -sine;
+                default: return -cosine;
+            }
+        }
+
+        constexpr double sin(const double x){ return sincos(x, 0); }
+        constexpr double cos(const double x){ return sincos(x, 1); }
+        constexpr double tan(const double x){ return sincos(x, 0) / sincos(x, 1); }
+
+        constexpr double exp2(const double x){ return exp(x * ln2); }
+        constexpr double log2(const double x){ return log(x) / ln2; }
+
+        constexpr double atan(const double x){
+            if(isnan(x)){ return x; }
+            if(x < 0.0){ return -atan(-x); }
+            if(x > 1.0){ return 0.5 * pi - atan(1.0 / x); }
+
+            // atan(x) = pi/6 + atan((x sqrt(3) - 1) / (x + sqrt(3))) brings x under tan(pi/12) = 0.268
+            const double sqrt3 = 1.73205080756887729353;
+            const bool shifted = x > 0.26794919243112270647;
+            const double t = shifted ? (x * sqrt3 - 1.0) / (x + sqrt3) : x;
+            const double t2 = t * t;
+            double power = t, sum = 0.0;
+            for(int i = 0; i < 30; ++i){ sum += (i & 1 ? -power : power) / (2 * i + 1); power *= t2; }
+            return shifted ? pi / 6.0 + sum : sum;
+        }
+
+        constexpr double atan2(const double y, const double x){
+            if(isnan(x) || isnan(y)){ return x + y; }
+            const double sign = signbit(y) ? -1.0 : 1.0;
+            const bool negative_x = signbit(x);
+            if(y == 0.0){ return negative_x ? sign * pi : y; }
+            if(x == 0.0){ return sign * 0.5 * pi; }
+            if(isinf(x) && isinf(y)){ return sign * (negative_x ? 0.75 * pi : 0.25 * pi); }
+            if(isinf(x)){ return negative_x ? sign * pi : sign * 0.0; }
+            if(isinf(y)){ return sign * 0.5 * pi; }
+            const double a = atan(abs(y / x));
+            return sign * (negative_x ? pi - a : a);
+        }
+
+        constexpr double asin(const double x){ return x < -1.0 || x > 1.0 ? nan : atan2(x, sqrt((1.0 - x) * (1.0 + x))); }
+        constexpr double acos(const double x){ return x < -1.0 || x > 1.0 ? nan : atan2(sqrt((1.0 - x) * (1.0 + x)), x); }
+
+        // the special cases of std::pow that matter for shaders, otherwise exp(y log|x|) with the sign of an odd power
+        constexpr double pow(const double x, const double y){
+            if(y == 0.0 || x == 1.0){ return 1.0; }
+            if(isnan(x) || isnan(y)){ return x + y; }
+            const bool integer = floor(y) == y;
+            const bool odd = integer && abs(y) < 9007199254740992.0 && floor(y * 0.5) != y * 0.5;
+            if(x < 0.0 && !integer){ return nan; }
+            if(x == 0.0){ return y < 0.0 ? (odd && signbit(x) ? -inf : inf) : (odd ? x : 0.0); }
+            if(x == -1.0 && isinf(y)){ return 1.0; }
+            const double magnitude = exp(y * log(abs(x)));
+            return x < 0.0 && odd ? -magnitude : magnitude;
+        }
+    };
+    #endif
+
+    // the <cmath> functions the builtins are made of: std:: at run time, glic::constant in constant evaluation
+    namespace cmath {
+        #if defined(GLIC_CONSTEXPR_MATH)
+            #define GLIC_CMATH(name, ...) (std::is_constant_evaluated() ? static_cast<float>(constant::name(__VA_ARGS__)) : std::name(__VA_ARGS__))
+        #else
+            #define GLIC_CMATH(name, ...) std::name(__VA_ARGS__)
+        #endif
+
+        GLIC_CONSTEXPR20 float sin(const float x){ return GLIC_CMATH(sin, x); }
+        GLIC_CONSTEXPR20 float cos(const float x){ return GLIC_CMATH(cos, x); }
+        GLIC_CONSTEXPR20 float tan(const float x){ return GLIC_CMATH(tan, x); }
+        GLIC_CONSTEXPR20 float asin(const float x){ return GLIC_CMATH(asin, x); }
+        GLIC_CONSTEXPR20 float acos(const float x){ return GLIC_CMATH(acos, x); }
+        GLIC_CONSTEXPR20 float atan(const float x){ return GLIC_CMATH(atan, x); }
+        GLIC_CONSTEXPR20 float atan2(const float y, const float x){ return GLIC_CMATH(atan2, y, x); }
+
+        GLIC_CONSTEXPR20 float pow(const float x, const float y){ return GLIC_CMATH(pow, x, y); }
+        GLIC_CONSTEXPR20 float exp(const float x){ return GLIC_CMATH(exp, x); }
+        GLIC_CONSTEXPR20 float log(const float x){ return GLIC_CMATH(log, x); }
+        GLIC_CONSTEXPR20 float sqrt(const float x){ return GLIC_CMATH(sqrt, x); }
+
+        // exp2 and log2 through the natural versions, which is still well inside an ulp after narrowing
+        GLIC_CONSTEXPR20 float exp2(const float x){ return GLIC_CMATH(exp2, x); }
+        GLIC_CONSTEXPR20 float log2(const float x){ return GLIC_CMATH(log2, x); }
+
+        // std:: at run time in every standard, the detail versions in constant evaluation wherever the compiler tells it apart
+        #if defined(GLIC_CONSTEXPR_ROUNDING)
+            constexpr float abs(const float x){ return GLIC_CONSTANT_EVALUATED() ? detail::abs(x) : std::abs(x); }
+            constexpr float floor(const float x){ return GLIC_CONSTANT_EVALUATED() ? detail::floor(x) : std::floor(x); }
+            constexpr float ceil(const float x){ return GLIC_CONSTANT_EVALUATED() ? detail::ceil(x) : std::ceil(x); }
+        #else
+            inline float abs(const float x){ return std::abs(x); }
+            inline float floor(const float x){ return std::floor(x); }
+            inline float ceil(const float x){ return std::ceil(x); }
+        #endif
+
+        #if defined(GLIC_CONSTEXPR_MATH)
+            constexpr bool isnan(const float x){ return std::is_constant_evaluated() ? constant::isnan(x) : std::isnan(x); }
+            constexpr bool isinf(const float x){ return std::is_constant_evaluated() ? constant::isinf(x) : std::isinf(x); }
+        #else
+            inline bool isnan(const float x){ return std::isnan(x); }
+            inline bool isinf(const float x){ return std::isinf(x); }
+        #endif
+
+        #undef GLIC_CMATH
+    };
+};
+
+#endif
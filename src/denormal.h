@@ -0,0 +1,85 @@
+#ifndef GLIC_DENORMAL_HEADER
+#define GLIC_DENORMAL_HEADER
+
+#include <cstdint>
+
+// scoped flush to zero execution mode
+// pow, exp, smoothstep and friends walk values down into the denormal range (below 1.18e-38), where most cpus take a
+// microcode assist on every operation and run 10 to 100 times slower; a shader rarely cares about values that small
+// while a flush_denormals object lives, the current thread treats denormal inputs as zero and flushes denormal results to
+// zero (ftz and daz in mxcsr on x86, fz in fpcr on arm), and its destructor puts the previous mode back
+// the mode is per thread: render_options::flush_denormals sets it on the pool threads for a frame
+// it changes results that involve denormals, and constants the compiler folds are still computed with them
+// on other targets (and msvc on arm) it does nothing, flush_denormals::supported says which
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+    #include <xmmintrin.h>
+    #define GLIC_DENORMAL_MXCSR
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    #define GLIC_DENORMAL_FPCR
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__arm__) && defined(__ARM_FP)
+    #define GLIC_DENORMAL_FPSCR
+#endif
+
+namespace glic {
+    class flush_denormals {
+        public:
+            #if defined(GLIC_DENORMAL_MXCSR) || defined(GLIC_DENORMAL_FPCR) || defined(GLIC_DENORMAL_FPSCR)
+                static constexpr bool supported = true;
+            #else
+                static constexpr bool supported = false;
+            #endif
+
+            flush_denormals() : saved(read()) {
+                #if defined(GLIC_DENORMAL_MXCSR)
+                    write(saved | 0x8040u); // ftz (bit 15) and daz (bit 6)
+                #elif defined(GLIC_DENORMAL_FPCR) || defined(GLIC_DENORMAL_FPSCR)
+                    write(saved | (1u << 24)); // fz, which covers both inputs and results
+                #endif
+            }
+
+            ~flush_denormals(){ write(saved); }
+
+            flush_denormals(const flush_denormals&) = delete;
+            flush_denormals& operator=(const flush_denormals&) = delete;
+
+        private:
+            #if defined(GLIC_DENORMAL_FPCR)
+                using state = std::uint64_t;
+            #else
+                using state = std::uint32_t;
+            #endif
+
+            state saved;
+
+            static state read(){
+                #if defined(GLIC_DENORMAL_MXCSR)
+                    return _mm_getcsr();
+                #elif defined(GLIC_DENORMAL_FPCR)
+                    state value;
+                    __asm__ __volatile__("mrs %0, fpcr" : "=r"(value));
+                    return value;
+                #elif defined(GLIC_DENORMAL_FPSCR)
+                    state value;
+                    __asm__ __volatile__("vmrs %0, fpscr" : "=r"(value));
+                    return value;
+                #else
+                    return 0;
+                #endif
+            }
+
+            static void write(const state value){
+                #if defined(GLIC_DENORMAL_MXCSR)
+                    _mm_setcsr(value);
+                #elif defined(GLIC_DENORMAL_FPCR)
+                    __asm__ __volatile__("msr fpcr, %0" : : "r"(value));
+                #elif defined(GLIC_DENORMAL_FPSCR)
+                    __asm__ __volatile__("vmsr fpscr, %0" : : "r"(value));
+                #else
+                    (void)value;
+                #endif
+            }
+    };
+};
+
+#endif
@@ -0,0 +1,107 @@
+#ifndef GLIC_DISPATCH_HEADER
+#define GLIC_DISPATCH_HEADER
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+
+// run time instruction set dispatch for the array kernels (batch.h, and the loop of a lazy.h expression)
+// dispatch::run compiles a kernel loop once per level below, with everything the loop calls inlined into it, and calls the
+// one for the level picked on first use from cpuid; so a binary built for the baseline still runs avx2 or avx512 loops on
+// machines that have them
+// GLIC_FORCE_ISA=scalar|sse4.2|avx2|avx512 in the environment pins a level (for reproducible benchmarks), a level the cpu
+// lacks falls back to the best one it has, and dispatch::use switches level at run time
+// no level contracts a * b + c into an fma, so every level gives the same results bit for bit
+// there is only the scalar level on other architectures, on compilers without the target attribute (msvc) or with
+// GLIC_NO_DISPATCH defined
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__)) && !defined(GLIC_NO_DISPATCH)
+    #define GLIC_DISPATCH
+#endif
+
+namespace glic {
+    // scalar is whatever the translation unit itself was compiled for
+    enum class isa { scalar, sse42, avx2, avx512 };
+
+    namespace dispatch {
+        inline const char* name(const isa level){
+            switch(level){
+                case isa::sse42: return "sse4.2";
+                case isa::avx2: return "avx2";
+                case isa::avx512: return "avx512";
+                default: return "scalar";
+            }
+        }
+
+        // the best level this cpu (and os, for the avx register state) supports
+        inline isa detect(){
+            static const isa best = [](){
+                #if defined(GLIC_DISPATCH)
+                    __builtin_cpu_init();
+                    if(__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw") && __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("f16c")){ return isa::avx512; }
+                    if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("f16c")){ return isa::avx2; }
+                    if(__builtin_cpu_supports("sse4.2")){ return isa::sse42; }
+                #endif
+                return isa::scalar;
+            }();
+            return best;
+        }
+
+        namespace detail {
+            // GLIC_FORCE_ISA, or the detected level when it is unset or not a level name
+            inline isa requested(){
+                const char* force = std::getenv("GLIC_FORCE_ISA");
+                if(force){
+                    for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+                        if(!std::strcmp(force, name(level))){ return level < detect() ? level : detect(); }
+                    }
+                }
+                return detect();
+            }
+
+            inline std::atomic<int>& current(){
+                static std::atomic<int> level(static_cast<int>(requested()));
+                return level;
+            }
+        };
+
+        // the level kernels run at, chosen once and cached
+        inline isa selected(){ return static_cast<isa>(detail::current().load(std::memory_order_relaxed)); }
+
+        // switches every kernel to level (clamped to what the cpu supports), returns the level now in use
+        inline isa use(const isa level){
+            const isa chosen = level < detect() ? level : detect();
+            detail::current().store(static_cast<int>(chosen), std::memory_order_relaxed);
+            return chosen;
+        }
+
+        #if defined(GLIC_DISPATCH)
+            namespace detail {
+                // flatten inlines the whole call tree of the loop, so the builtins it uses are compiled for the level too
+                template <typename Loop> __attribute__((flatten)) void run_scalar(const Loop& loop){ loop(); }
+                template <typename Loop> __attribute__((target("sse4.2"), flatten)) void run_sse42(const Loop& loop){ loop(); }
+                template <typename Loop> __attribute__((target("avx2,f16c"), flatten)) void run_avx2(const Loop& loop){ loop(); }
+
+                // avx512f implies fma, so contraction of a * b + c is turned off again to keep the results of the other levels
+                // (clang decides contraction in the front end and ignores the optimize attribute, so glic::glic adds -ffp-contract=off
+                // there; builds that include the headers without cmake need to pass it themselves)
+                #if defined(__clang__)
+                    template <typename Loop> __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,f16c"), flatten)) void run_avx512(const Loop& loop){ loop(); }
+                #else
+                    template <typename Loop> __attribute__((target("avx512f,avx512vl,avx512bw,avx512dq,f16c"), optimize("fp-contract=off"), flatten)) void run_avx512(const Loop& loop){ loop(); }
+                #endif
+            };
+        #endif
+
+        // runs loop (a callable taking no arguments) compiled for the selected level, through a table of its compilations
+        template <typename Loop> void run(const Loop& loop){
+            #if defined(GLIC_DISPATCH)
+                static void (*const table[])(const Loop&) = {detail::run_scalar<Loop>, detail::run_sse42<Loop>, detail::run_avx2<Loop>, detail::run_avx512<Loop>};
+                table[static_cast<int>(selected())](loop);
+            #else
+                loop();
+            #endif
+        }
+    };
+};
+#endif
@@ -3,257 +3,630 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include "approx.h"
+#include "constant.h"
+#include "half.h"
+#include "instrument.h"
+#include "ivec.h"
+#include "mat.h"
 #include "vec.h"
 
+// the untagged transcendentals use the exact tier unless GLIC_PRECISION_FAST is defined before including glic.h
+// they live in an inline namespace named after the tier so translation units built with different defaults do not collide
+#if defined(GLIC_PRECISION_FAST)
+    #define GLIC_PRECISION_TIER fast
+    #define GLIC_PRECISION_NAMESPACE precision_fast
+#else
+    #define GLIC_PRECISION_TIER exact
+    #define GLIC_PRECISION_NAMESPACE precision_exact
+#endif
+
 namespace glic {
+    // precision tiers, passed as a trailing argument to pick one per call site: sin(x, precision::fast)
+    // exact forwards to the standard library, fast uses the polynomials in approx.h (see there for the error bounds)
+    // GLIC_CONSTEXPR builtins are constexpr, GLIC_CONSTEXPR_ROUND ones where the compiler can tell constant evaluation apart
+    // and GLIC_CONSTEXPR20 ones from c++20 on (see constant.h for all three)
+    namespace precision {
+        struct exact_t {};
+        struct fast_t {};
+
+        constexpr exact_t exact{};
+        constexpr fast_t fast{};
+    };
+
     // trigonometry
 
-    float radians(const float degrees){ return degrees * 180.0 / M_PI; }
-    vec2 radians(const vec2 degrees){ return degrees.apply(radians); }
-    vec3 radians(const vec3 degrees){ return degrees.apply(radians); }
-    vec4 radians(const vec4 degrees){ return  degrees.apply(radians); }
-
-    float degrees(const float radians){ return radians * M_PI / 180.0; }
-    vec2 degrees(const vec2 radians){ return radians.apply(degrees); }
-    vec3 degrees(const vec3 radians){ return radians.apply(degrees); }
-    vec4 degrees(const vec4 radians){ return radians.apply(degrees); }
-
-    float sin(const float angle){ return std::sin(angle); }
-    vec2 sin(const vec2 angle){ return angle.apply(std::sin); }
-    vec3 sin(const vec3 angle){ return angle.apply(std::sin); }
-    vec4 sin(const vec4 angle){ return angle.apply(std::sin); }
-
-    float cos(const float angle){ return std::cos(angle); }
-    vec2 cos(const vec2 angle){ return angle.apply(std::cos); }
-    vec3 cos(const vec3 angle){ return angle.apply(std::cos); }
-    vec4 cos(const vec4 angle){ return angle.apply(std::cos); }
-
-    float tan(const float angle){ return std::tan(angle); }
-    vec2 tan(const vec2 angle){ return angle.apply(std::tan); }
-    vec3 tan(const vec3 angle){ return angle.apply(std::tan); }
-    vec4 tan(const vec4 angle){ return angle.apply(std::tan); }
-
-    float asin(const float angle){ return std::asin(angle); }
-    vec2 asin(const vec2 angle){ return angle.apply(std::asin); }
-    vec3 asin(const vec3 angle){ return angle.apply(std::asin); }
-    vec4 asin(const vec4 angle){ return angle.apply(std::asin); }
-
-    float acos(const float angle){ return std::acos(angle); }
-    vec2 acos(const vec2 angle){ return angle.apply(std::acos); }
-    vec3 acos(const vec3 angle){ return angle.apply(std::acos); }
-    vec4 acos(const vec4 angle){ return angle.apply(std::acos); }
-
-    float atan(const float angle){ return std::atan(angle); }
-    vec2 atan(const vec2 angle){ return angle.apply(std::atan); }
-    vec3 atan(const vec3 angle){ return angle.apply(std::atan); }
-    vec4 atan(const vec4 angle){ return angle.apply(std::atan); }
-
-    float atan(const float y, const float x){ return std::atan2(y, x); }
-    vec2 atan(const vec2 y, const vec2 x){ return vec2::zip(std::atan2, y, x); }
-    vec3 atan(const vec3 y, const vec3 x){ return vec3::zip(std::atan2, y, x); }
-    vec4 atan(const vec4 y, const vec4 x){ return vec4::zip(std::atan2, y, x); }
+    GLIC_CONSTEXPR float radians(const float degrees){ return GLIC_COUNTED(radians, degrees * 0.0174532925199432958f, degrees); }
+    GLIC_CONSTEXPR vec2 radians(const vec2 degrees){ return GLIC_COUNTED(radians, degrees.apply<radians>(), degrees); }
+    GLIC_CONSTEXPR vec3 radians(const vec3 degrees){ return GLIC_COUNTED(radians, degrees.apply<radians>(), degrees); }
+    GLIC_CONSTEXPR vec4 radians(const vec4 degrees){ return GLIC_COUNTED(radians, degrees.apply<radians>(), degrees); }
+
+    GLIC_CONSTEXPR float degrees(const float radians){ return GLIC_COUNTED(degrees, radians * 57.2957795130823209f, radians); }
+    GLIC_CONSTEXPR vec2 degrees(const vec2 radians){ return GLIC_COUNTED(degrees, radians.apply<degrees>(), radians); }
+    GLIC_CONSTEXPR vec3 degrees(const vec3 radians){ return GLIC_COUNTED(degrees, radians.apply<degrees>(), radians); }
+    GLIC_CONSTEXPR vec4 degrees(const vec4 radians){ return GLIC_COUNTED(degrees, radians.apply<degrees>(), radians); }
+
+    GLIC_CONSTEXPR20 float sin(const float angle, precision::exact_t){ return GLIC_COUNTED(sin, cmath::sin(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 sin(const vec2 angle, precision::exact_t){ return GLIC_COUNTED(sin, angle.apply<cmath::sin>(), angle); }
+    GLIC_CONSTEXPR20 vec3 sin(const vec3 angle, precision::exact_t){ return GLIC_COUNTED(sin, angle.apply<cmath::sin>(), angle); }
+    GLIC_CONSTEXPR20 vec4 sin(const vec4 angle, precision::exact_t){ return GLIC_COUNTED(sin, angle.apply<cmath::sin>(), angle); }
+
+    GLIC_CONSTEXPR20 float sin(const float angle, precision::fast_t){ return GLIC_COUNTED(sin, approx::sin(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 sin(const vec2 angle, precision::fast_t){ return GLIC_COUNTED(sin, angle.apply<approx::sin>(), angle); }
+    GLIC_CONSTEXPR20 vec3 sin(const vec3 angle, precision::fast_t){ return GLIC_COUNTED(sin, angle.apply<approx::sin>(), angle); }
+    GLIC_CONSTEXPR20 vec4 sin(const vec4 angle, precision::fast_t){ return GLIC_COUNTED(sin, angle.apply<approx::sin>(), angle); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float sin(const float angle){ return GLIC_COUNTED(sin, glic::sin(angle, precision::GLIC_PRECISION_TIER), angle); }
+        GLIC_CONSTEXPR20 vec2 sin(const vec2 angle){ return GLIC_COUNTED(sin, angle.apply<sin>(), angle); }
+        GLIC_CONSTEXPR20 vec3 sin(const vec3 angle){ return GLIC_COUNTED(sin, angle.apply<sin>(), angle); }
+        GLIC_CONSTEXPR20 vec4 sin(const vec4 angle){ return GLIC_COUNTED(sin, angle.apply<sin>(), angle); }
+    };
+
+    GLIC_CONSTEXPR20 float cos(const float angle, precision::exact_t){ return GLIC_COUNTED(cos, cmath::cos(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 cos(const vec2 angle, precision::exact_t){ return GLIC_COUNTED(cos, angle.apply<cmath::cos>(), angle); }
+    GLIC_CONSTEXPR20 vec3 cos(const vec3 angle, precision::exact_t){ return GLIC_COUNTED(cos, angle.apply<cmath::cos>(), angle); }
+    GLIC_CONSTEXPR20 vec4 cos(const vec4 angle, precision::exact_t){ return GLIC_COUNTED(cos, angle.apply<cmath::cos>(), angle); }
+
+    GLIC_CONSTEXPR20 float cos(const float angle, precision::fast_t){ return GLIC_COUNTED(cos, approx::cos(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 cos(const vec2 angle, precision::fast_t){ return GLIC_COUNTED(cos, angle.apply<approx::cos>(), angle); }
+    GLIC_CONSTEXPR20 vec3 cos(const vec3 angle, precision::fast_t){ return GLIC_COUNTED(cos, angle.apply<approx::cos>(), angle); }
+    GLIC_CONSTEXPR20 vec4 cos(const vec4 angle, precision::fast_t){ return GLIC_COUNTED(cos, angle.apply<approx::cos>(), angle); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float cos(const float angle){ return GLIC_COUNTED(cos, glic::cos(angle, precision::GLIC_PRECISION_TIER), angle); }
+        GLIC_CONSTEXPR20 vec2 cos(const vec2 angle){ return GLIC_COUNTED(cos, angle.apply<cos>(), angle); }
+        GLIC_CONSTEXPR20 vec3 cos(const vec3 angle){ return GLIC_COUNTED(cos, angle.apply<cos>(), angle); }
+        GLIC_CONSTEXPR20 vec4 cos(const vec4 angle){ return GLIC_COUNTED(cos, angle.apply<cos>(), angle); }
+    };
+
+    GLIC_CONSTEXPR20 float tan(const float angle, precision::exact_t){ return GLIC_COUNTED(tan, cmath::tan(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 tan(const vec2 angle, precision::exact_t){ return GLIC_COUNTED(tan, angle.apply<cmath::tan>(), angle); }
+    GLIC_CONSTEXPR20 vec3 tan(const vec3 angle, precision::exact_t){ return GLIC_COUNTED(tan, angle.apply<cmath::tan>(), angle); }
+    GLIC_CONSTEXPR20 vec4 tan(const vec4 angle, precision::exact_t){ return GLIC_COUNTED(tan, angle.apply<cmath::tan>(), angle); }
+
+    GLIC_CONSTEXPR20 float tan(const float angle, precision::fast_t){ return GLIC_COUNTED(tan, approx::tan(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 tan(const vec2 angle, precision::fast_t){ return GLIC_COUNTED(tan, angle.apply<approx::tan>(), angle); }
+    GLIC_CONSTEXPR20 vec3 tan(const vec3 angle, precision::fast_t){ return GLIC_COUNTED(tan, angle.apply<approx::tan>(), angle); }
+    GLIC_CONSTEXPR20 vec4 tan(const vec4 angle, precision::fast_t){ return GLIC_COUNTED(tan, angle.apply<approx::tan>(), angle); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float tan(const float angle){ return GLIC_COUNTED(tan, glic::tan(angle, precision::GLIC_PRECISION_TIER), angle); }
+        GLIC_CONSTEXPR20 vec2 tan(const vec2 angle){ return GLIC_COUNTED(tan, angle.apply<tan>(), angle); }
+        GLIC_CONSTEXPR20 vec3 tan(const vec3 angle){ return GLIC_COUNTED(tan, angle.apply<tan>(), angle); }
+        GLIC_CONSTEXPR20 vec4 tan(const vec4 angle){ return GLIC_COUNTED(tan, angle.apply<tan>(), angle); }
+    };
+
+    GLIC_CONSTEXPR20 float asin(const float angle){ return GLIC_COUNTED(asin, cmath::asin(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 asin(const vec2 angle){ return GLIC_COUNTED(asin, angle.apply<asin>(), angle); }
+    GLIC_CONSTEXPR20 vec3 asin(const vec3 angle){ return GLIC_COUNTED(asin, angle.apply<asin>(), angle); }
+    GLIC_CONSTEXPR20 vec4 asin(const vec4 angle){ return GLIC_COUNTED(asin, angle.apply<asin>(), angle); }
+
+    GLIC_CONSTEXPR20 float acos(const float angle){ return GLIC_COUNTED(acos, cmath::acos(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 acos(const vec2 angle){ return GLIC_COUNTED(acos, angle.apply<acos>(), angle); }
+    GLIC_CONSTEXPR20 vec3 acos(const vec3 angle){ return GLIC_COUNTED(acos, angle.apply<acos>(), angle); }
+    GLIC_CONSTEXPR20 vec4 acos(const vec4 angle){ return GLIC_COUNTED(acos, angle.apply<acos>(), angle); }
+
+    GLIC_CONSTEXPR20 float atan(const float angle){ return GLIC_COUNTED(atan, cmath::atan(angle), angle); }
+    GLIC_CONSTEXPR20 vec2 atan(const vec2 angle){ return GLIC_COUNTED(atan, angle.apply<atan>(), angle); }
+    GLIC_CONSTEXPR20 vec3 atan(const vec3 angle){ return GLIC_COUNTED(atan, angle.apply<atan>(), angle); }
+    GLIC_CONSTEXPR20 vec4 atan(const vec4 angle){ return GLIC_COUNTED(atan, angle.apply<atan>(), angle); }
+
+    GLIC_CONSTEXPR20 float atan(const float y, const float x){ return GLIC_COUNTED(atan, cmath::atan2(y, x), y, x); }
+    GLIC_CONSTEXPR20 vec2 atan(const vec2 y, const vec2 x){ return GLIC_COUNTED(atan, vec2::zip<atan>(y, x), y, x); }
+    GLIC_CONSTEXPR20 vec3 atan(const vec3 y, const vec3 x){ return GLIC_COUNTED(atan, vec3::zip<atan>(y, x), y, x); }
+    GLIC_CONSTEXPR20 vec4 atan(const vec4 y, const vec4 x){ return GLIC_COUNTED(atan, vec4::zip<atan>(y, x), y, x); }
 
     // exponential
 
-    float pow(const float x, const float y){ return std::pow(x, y); }
-    vec2 pow(const vec2 x, const vec2 y){ return vec2::zip(std::pow, x, y); }
-    vec3 pow(const vec3 x, const vec3 y){ return vec3::zip(std::pow, x, y); }
-    vec4 pow(const vec4 x, const vec4 y){ return vec4::zip(std::pow, x, y); }
-
-    float exp(const float x){ return std::exp(x); }
-    vec2 exp(const vec2 x){ return x.apply(std::exp); }
-    vec3 exp(const vec3 x){ return x.apply(std::exp); }
-    vec4 exp(const vec4 x){ return x.apply(std::exp); }
-
-    float exp2(const float x){ return std::exp2(x); }
-    vec2 exp2(const vec2 x){ return x.apply(std::exp2); }
-    vec3 exp2(const vec3 x){ return x.apply(std::exp2); }
-    vec4 exp2(const vec4 x){ return x.apply(std::exp2); }
-
-    float log(const float x){ return std::log(x); }
-    vec2 log(const vec2 x){ return x.apply(std::log); }
-    vec3 log(const vec3 x){ return x.apply(std::log); }
-    vec4 log(const vec4 x){ return x.apply(std::log); }
-
-    float log2(const float x){ return std::log2(x); }
-    vec2 log2(const vec2 x){ return x.apply(std::log2); }
-    vec3 log2(const vec3 x){ return x.apply(std::log2); }
-    vec4 log2(const vec4 x){ return x.apply(std::log2); }
-
-    float sqrt(const float x){ return std::sqrt(x); }
-    vec2 sqrt(const vec2 x){ return x.apply(std::sqrt); }
-    vec3 sqrt(const vec3 x){ return x.apply(std::sqrt); }
-    vec4 sqrt(const vec4 x){ return x.apply(std::sqrt); }
-
-    float inversesqrt(const float x){ return 1.0 / std::sqrt(x); }
-    vec2 inversesqrt(const vec2 x){ return x.apply(inversesqrt); }
-    vec3 inversesqrt(const vec3 x){ return x.apply(inversesqrt); }
-    vec4 inversesqrt(const vec4 x){ return x.apply(inversesqrt); }
+    GLIC_CONSTEXPR20 float pow(const float x, const float y, precision::exact_t){ return GLIC_COUNTED(pow, cmath::pow(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec2 pow(const vec2 x, const vec2 y, precision::exact_t){ return GLIC_COUNTED(pow, vec2::zip<cmath::pow>(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec3 pow(const vec3 x, const vec3 y, precision::exact_t){ return GLIC_COUNTED(pow, vec3::zip<cmath::pow>(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec4 pow(const vec4 x, const vec4 y, precision::exact_t){ return GLIC_COUNTED(pow, vec4::zip<cmath::pow>(x, y), x, y); }
+
+    GLIC_CONSTEXPR20 float pow(const float x, const float y, precision::fast_t){ return GLIC_COUNTED(pow, approx::pow(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec2 pow(const vec2 x, const vec2 y, precision::fast_t){ return GLIC_COUNTED(pow, vec2::zip<approx::pow>(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec3 pow(const vec3 x, const vec3 y, precision::fast_t){ return GLIC_COUNTED(pow, vec3::zip<approx::pow>(x, y), x, y); }
+    GLIC_CONSTEXPR20 vec4 pow(const vec4 x, const vec4 y, precision::fast_t){ return GLIC_COUNTED(pow, vec4::zip<approx::pow>(x, y), x, y); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float pow(const float x, const float y){ return GLIC_COUNTED(pow, glic::pow(x, y, precision::GLIC_PRECISION_TIER), x, y); }
+        GLIC_CONSTEXPR20 vec2 pow(const vec2 x, const vec2 y){ return GLIC_COUNTED(pow, vec2::zip<pow>(x, y), x, y); }
+        GLIC_CONSTEXPR20 vec3 pow(const vec3 x, const vec3 y){ return GLIC_COUNTED(pow, vec3::zip<pow>(x, y), x, y); }
+        GLIC_CONSTEXPR20 vec4 pow(const vec4 x, const vec4 y){ return GLIC_COUNTED(pow, vec4::zip<pow>(x, y), x, y); }
+    };
+
+    GLIC_CONSTEXPR20 float exp(const float x, precision::exact_t){ return GLIC_COUNTED(exp, cmath::exp(x), x); }
+    GLIC_CONSTEXPR20 vec2 exp(const vec2 x, precision::exact_t){ return GLIC_COUNTED(exp, x.apply<cmath::exp>(), x); }
+    GLIC_CONSTEXPR20 vec3 exp(const vec3 x, precision::exact_t){ return GLIC_COUNTED(exp, x.apply<cmath::exp>(), x); }
+    GLIC_CONSTEXPR20 vec4 exp(const vec4 x, precision::exact_t){ return GLIC_COUNTED(exp, x.apply<cmath::exp>(), x); }
+
+    GLIC_CONSTEXPR20 float exp(const float x, precision::fast_t){ return GLIC_COUNTED(exp, approx::exp(x), x); }
+    GLIC_CONSTEXPR20 vec2 exp(const vec2 x, precision::fast_t){ return GLIC_COUNTED(exp, x.apply<approx::exp>(), x); }
+    GLIC_CONSTEXPR20 vec3 exp(const vec3 x, precision::fast_t){ return GLIC_COUNTED(exp, x.apply<approx::exp>(), x); }
+    GLIC_CONSTEXPR20 vec4 exp(const vec4 x, precision::fast_t){ return GLIC_COUNTED(exp, x.apply<approx::exp>(), x); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float exp(const float x){ return GLIC_COUNTED(exp, glic::exp(x, precision::GLIC_PRECISION_TIER), x); }
+        GLIC_CONSTEXPR20 vec2 exp(const vec2 x){ return GLIC_COUNTED(exp, x.apply<exp>(), x); }
+        GLIC_CONSTEXPR20 vec3 exp(const vec3 x){ return GLIC_COUNTED(exp, x.apply<exp>(), x); }
+        GLIC_CONSTEXPR20 vec4 exp(const vec4 x){ return GLIC_COUNTED(exp, x.apply<exp>(), x); }
+    };
+
+    GLIC_CONSTEXPR20 float exp2(const float x, precision::exact_t){ return GLIC_COUNTED(exp2, cmath::exp2(x), x); }
+    GLIC_CONSTEXPR20 vec2 exp2(const vec2 x, precision::exact_t){ return GLIC_COUNTED(exp2, x.apply<cmath::exp2>(), x); }
+    GLIC_CONSTEXPR20 vec3 exp2(const vec3 x, precision::exact_t){ return GLIC_COUNTED(exp2, x.apply<cmath::exp2>(), x); }
+    GLIC_CONSTEXPR20 vec4 exp2(const vec4 x, precision::exact_t){ return GLIC_COUNTED(exp2, x.apply<cmath::exp2>(), x); }
+
+    GLIC_CONSTEXPR20 float exp2(const float x, precision::fast_t){ return GLIC_COUNTED(exp2, approx::exp2(x), x); }
+    GLIC_CONSTEXPR20 vec2 exp2(const vec2 x, precision::fast_t){ return GLIC_COUNTED(exp2, x.apply<approx::exp2>(), x); }
+    GLIC_CONSTEXPR20 vec3 exp2(const vec3 x, precision::fast_t){ return GLIC_COUNTED(exp2, x.apply<approx::exp2>(), x); }
+    GLIC_CONSTEXPR20 vec4 exp2(const vec4 x, precision::fast_t){ return GLIC_COUNTED(exp2, x.apply<approx::exp2>(), x); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float exp2(const float x){ return GLIC_COUNTED(exp2, glic::exp2(x, precision::GLIC_PRECISION_TIER), x); }
+        GLIC_CONSTEXPR20 vec2 exp2(const vec2 x){ return GLIC_COUNTED(exp2, x.apply<exp2>(), x); }
+        GLIC_CONSTEXPR20 vec3 exp2(const vec3 x){ return GLIC_COUNTED(exp2, x.apply<exp2>(), x); }
+        GLIC_CONSTEXPR20 vec4 exp2(const vec4 x){ return GLIC_COUNTED(exp2, x.apply<exp2>(), x); }
+    };
+
+    GLIC_CONSTEXPR20 float log(const float x, precision::exact_t){ return GLIC_COUNTED(log, cmath::log(x), x); }
+    GLIC_CONSTEXPR20 vec2 log(const vec2 x, precision::exact_t){ return GLIC_COUNTED(log, x.apply<cmath::log>(), x); }
+    GLIC_CONSTEXPR20 vec3 log(const vec3 x, precision::exact_t){ return GLIC_COUNTED(log, x.apply<cmath::log>(), x); }
+    GLIC_CONSTEXPR20 vec4 log(const vec4 x, precision::exact_t){ return GLIC_COUNTED(log, x.apply<cmath::log>(), x); }
+
+    GLIC_CONSTEXPR20 float log(const float x, precision::fast_t){ return GLIC_COUNTED(log, approx::log(x), x); }
+    GLIC_CONSTEXPR20 vec2 log(const vec2 x, precision::fast_t){ return GLIC_COUNTED(log, x.apply<approx::log>(), x); }
+    GLIC_CONSTEXPR20 vec3 log(const vec3 x, precision::fast_t){ return GLIC_COUNTED(log, x.apply<approx::log>(), x); }
+    GLIC_CONSTEXPR20 vec4 log(const vec4 x, precision::fast_t){ return GLIC_COUNTED(log, x.apply<approx::log>(), x); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float log(const float x){ return GLIC_COUNTED(log, glic::log(x, precision::GLIC_PRECISION_TIER), x); }
+        GLIC_CONSTEXPR20 vec2 log(const vec2 x){ return GLIC_COUNTED(log, x.apply<log>(), x); }
+        GLIC_CONSTEXPR20 vec3 log(const vec3 x){ return GLIC_COUNTED(log, x.apply<log>(), x); }
+        GLIC_CONSTEXPR20 vec4 log(const vec4 x){ return GLIC_COUNTED(log, x.apply<log>(), x); }
+    };
+
+    GLIC_CONSTEXPR20 float log2(const float x, precision::exact_t){ return GLIC_COUNTED(log2, cmath::log2(x), x); }
+    GLIC_CONSTEXPR20 vec2 log2(const vec2 x, precision::exact_t){ return GLIC_COUNTED(log2, x.apply<cmath::log2>(), x); }
+    GLIC_CONSTEXPR20 vec3 log2(const vec3 x, precision::exact_t){ return GLIC_COUNTED(log2, x.apply<cmath::log2>(), x); }
+    GLIC_CONSTEXPR20 vec4 log2(const vec4 x, precision::exact_t){ return GLIC_COUNTED(log2, x.apply<cmath::log2>(), x); }
+
+    GLIC_CONSTEXPR20 float log2(const float x, precision::fast_t){ return GLIC_COUNTED(log2, approx::log2(x), x); }
+    GLIC_CONSTEXPR20 vec2 log2(const vec2 x, precision::fast_t){ return GLIC_COUNTED(log2, x.apply<approx::log2>(), x); }
+    GLIC_CONSTEXPR20 vec3 log2(const vec3 x, precision::fast_t){ return GLIC_COUNTED(log2, x.apply<approx::log2>(), x); }
+    GLIC_CONSTEXPR20 vec4 log2(const vec4 x, precision::fast_t){ return GLIC_COUNTED(log2, x.apply<approx::log2>(), x); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float log2(const float x){ return GLIC_COUNTED(log2, glic::log2(x, precision::GLIC_PRECISION_TIER), x); }
+        GLIC_CONSTEXPR20 vec2 log2(const vec2 x){ return GLIC_COUNTED(log2, x.apply<log2>(), x); }
+        GLIC_CONSTEXPR20 vec3 log2(const vec3 x){ return GLIC_COUNTED(log2, x.apply<log2>(), x); }
+        GLIC_CONSTEXPR20 vec4 log2(const vec4 x){ return GLIC_COUNTED(log2, x.apply<log2>(), x); }
+    };
+
+    GLIC_CONSTEXPR20 float sqrt(const float x){ return GLIC_COUNTED(sqrt, cmath::sqrt(x), x); }
+    GLIC_CONSTEXPR20 vec2 sqrt(const vec2 x){ return GLIC_COUNTED(sqrt, x.apply<sqrt>(), x); }
+    GLIC_CONSTEXPR20 vec3 sqrt(const vec3 x){ return GLIC_COUNTED(sqrt, x.apply<sqrt>(), x); }
+    GLIC_CONSTEXPR20 vec4 sqrt(const vec4 x){ return GLIC_COUNTED(sqrt, x.apply<sqrt>(), x); }
+
+    GLIC_CONSTEXPR20 float inversesqrt(const float x, precision::exact_t){ return GLIC_COUNTED(inversesqrt, 1.0f / cmath::sqrt(x), x); }
+    GLIC_CONSTEXPR20 vec2 inversesqrt(const vec2 x, precision::exact_t){ return GLIC_COUNTED(inversesqrt, x.apply([](const float v){ return inversesqrt(v, precision::exact); }), x); }
+    GLIC_CONSTEXPR20 vec3 inversesqrt(const vec3 x, precision::exact_t){ return GLIC_COUNTED(inversesqrt, x.apply([](const float v){ return inversesqrt(v, precision::exact); }), x); }
+    GLIC_CONSTEXPR20 vec4 inversesqrt(const vec4 x, precision::exact_t){ return GLIC_COUNTED(inversesqrt, x.apply([](const float v){ return inversesqrt(v, precision::exact); }), x); }
+
+    GLIC_CONSTEXPR20 float inversesqrt(const float x, precision::fast_t){ return GLIC_COUNTED(inversesqrt, approx::inversesqrt(x), x); }
+    GLIC_CONSTEXPR20 vec2 inversesqrt(const vec2 x, precision::fast_t){ return GLIC_COUNTED(inversesqrt, x.apply<approx::inversesqrt>(), x); }
+    GLIC_CONSTEXPR20 vec3 inversesqrt(const vec3 x, precision::fast_t){ return GLIC_COUNTED(inversesqrt, x.apply<approx::inversesqrt>(), x); }
+    GLIC_CONSTEXPR20 vec4 inversesqrt(const vec4 x, precision::fast_t){ return GLIC_COUNTED(inversesqrt, x.apply<approx::inversesqrt>(), x); }
+
+    inline namespace GLIC_PRECISION_NAMESPACE {
+        GLIC_CONSTEXPR20 float inversesqrt(const float x){ return GLIC_COUNTED(inversesqrt, glic::inversesqrt(x, precision::GLIC_PRECISION_TIER), x); }
+        GLIC_CONSTEXPR20 vec2 inversesqrt(const vec2 x){ return GLIC_COUNTED(inversesqrt, x.apply<inversesqrt>(), x); }
+        GLIC_CONSTEXPR20 vec3 inversesqrt(const vec3 x){ return GLIC_COUNTED(inversesqrt, x.apply<inversesqrt>(), x); }
+        GLIC_CONSTEXPR20 vec4 inversesqrt(const vec4 x){ return GLIC_COUNTED(inversesqrt, x.apply<inversesqrt>(), x); }
+    };
 
     // common
 
-    float abs(const float x){ return std::abs(x); }
-    vec2 abs(const vec2 x){ return x.apply(std::abs); }
-    vec3 abs(const vec3 x){ return x.apply(std::abs); }
-    vec4 abs(const vec4 x){ return x.apply(std::abs); }
-
-    float sign(const float x){ return (x > 0) - (x < 0); }
-    vec2 sign(const vec2 x){ return x.apply(sign); }
-    vec3 sign(const vec3 x){ return x.apply(sign); }
-    vec4 sign(const vec4 x){ return x.apply(sign); }
-
-    float floor(const float x){ return std::floor(x); }
-    vec2 floor(const vec2 x){ return x.apply(std::floor); }
-    vec3 floor(const vec3 x){ return x.apply(std::floor); }
-    vec4 floor(const vec4 x){ return x.apply(std::floor); }
-
-    float ceil(const float x){ return std::ceil(x); }
-    vec2 ceil(const vec2 x){ return x.apply(std::ceil); }
-    vec3 ceil(const vec3 x){ return x.apply(std::ceil); }
-    vec4 ceil(const vec4 x){ return x.apply(std::ceil); }
-
-    float fract(const float x){ return x - std::floor(x); }
-    vec2 fract(const vec2 x){ return x.apply(fract); }
-    vec3 fract(const vec3 x){ return x.apply(fract); }
-    vec4 fract(const vec4 x){ return x.apply(fract); }
-
-    float mod(const float x, const float y){ return std::fmod(x, y); }
-    vec2 mod(const vec2 x, const vec2 y){ return vec2::zip(std::fmod, x, y); }
-    vec3 mod(const vec3 x, const vec3 y){ return vec3::zip(std::fmod, x, y); }
-    vec4 mod(const vec4 x, const vec4 y){ return vec4::zip(std::fmod, x, y); }
-
-    vec2 mod(const vec2 x, const float y){ return vec2(std::fmod(x.x, y), std::fmod(x.y, y)); }
-    vec3 mod(const vec3 x, const float y){ return vec3(std::fmod(x.x, y), std::fmod(x.y, y), std::fmod(x.z, y)); }
-    vec4 mod(const vec4 x, const float y){ return vec4(std::fmod(x.x, y), std::fmod(x.y, y), std::fmod(x.z, y), std::fmod(x.w, y)); }
-
-    float min(const float x, const float y){ return std::min(x, y); }
-    vec2 min(const vec2 x, const vec2 y){ return vec2::zip(min, x, y); }
-    vec3 min(const vec3 x, const vec3 y){ return vec3::zip(min, x, y); }
-    vec4 min(const vec4 x, const vec4 y){ return vec4::zip(min, x, y); }
-
-    vec2 min(const vec2 x, const float y){ return vec2(std::min(x.x, y), std::min(x.y, y)); }
-    vec3 min(const vec3 x, const float y){ return vec3(std::min(x.x, y), std::min(x.y, y), std::min(x.z, y)); }
-    vec4 min(const vec4 x, const float y){ return vec4(std::min(x.x, y), std::min(x.y, y), std::min(x.z, y), std::min(x.w, y)); }
-    
-    float max(const float x, const float y){ return std::max(x, y); }
-    vec2 max(const vec2 x, const vec2 y){ return vec2::zip(max, x, y); }
-    vec3 max(const vec3 x, const vec3 y){ return vec3::zip(max, x, y); }
-    vec4 max(const vec4 x, const vec4 y){ return vec4::zip(max, x, y); }
-
-    vec2 max(const vec2 x, const float y){ return vec2(std::max(x.x, y), std::max(x.y, y)); }
-    vec3 max(const vec3 x, const float y){ return vec3(std::max(x.x, y), std::max(x.y, y), std::max(x.z, y)); }
-    vec4 max(const vec4 x, const float y){ return vec4(std::max(x.x, y), std::max(x.y, y), std::max(x.z, y), std::max(x.w, y)); }
-
-    float clamp(const float x, const float minval, const float maxval){ return min(max(x, minval), maxval); }
-    vec2 clamp(const vec2 x, const vec2 minval, const vec2 maxval){ return min(max(x, minval), maxval); }
-    vec3 clamp(const vec3 x, const vec3 minval, const vec3 maxval){ return min(max(x, minval), maxval); }
-    vec4 clamp(const vec4 x, const vec4 minval, const vec4 maxval){ return min(max(x, minval), maxval); }
-
-    vec2 clamp(const vec2 x, const float minval, const float maxval){ return min(max(x, minval), maxval); }
-    vec3 clamp(const vec3 x, const float minval, const float maxval){ return min(max(x, minval), maxval); }
-    vec4 clamp(const vec4 x, const float minval, const float maxval){ return min(max(x, minval), maxval); }
-
-    float mix(const float x, const float y, const float a){
+    GLIC_CONSTEXPR_ROUND float abs(const float x){ return GLIC_COUNTED(abs, cmath::abs(x), x); }
+    GLIC_CONSTEXPR_ROUND vec2 abs(const vec2 x){ return GLIC_COUNTED(abs, x.apply<abs>(), x); }
+    GLIC_CONSTEXPR_ROUND vec3 abs(const vec3 x){ return GLIC_COUNTED(abs, x.apply<abs>(), x); }
+    GLIC_CONSTEXPR_ROUND vec4 abs(const vec4 x){ return GLIC_COUNTED(abs, x.apply<abs>(), x); }
+
+    GLIC_CONSTEXPR ivec2 abs(const ivec2 x){ return x.apply([](const std::int32_t v){ return v < 0 ? -v : v; }); }
+    GLIC_CONSTEXPR ivec3 abs(const ivec3 x){ return x.apply([](const std::int32_t v){ return v < 0 ? -v : v; }); }
+    GLIC_CONSTEXPR ivec4 abs(const ivec4 x){ return x.apply([](const std::int32_t v){ return v < 0 ? -v : v; }); }
+
+    GLIC_CONSTEXPR float sign(const float x){ return GLIC_COUNTED(sign, (x > 0) - (x < 0), x); }
+    GLIC_CONSTEXPR vec2 sign(const vec2 x){ return GLIC_COUNTED(sign, x.apply<sign>(), x); }
+    GLIC_CONSTEXPR vec3 sign(const vec3 x){ return GLIC_COUNTED(sign, x.apply<sign>(), x); }
+    GLIC_CONSTEXPR vec4 sign(const vec4 x){ return GLIC_COUNTED(sign, x.apply<sign>(), x); }
+
+    GLIC_CONSTEXPR_ROUND float floor(const float x){ return GLIC_COUNTED(floor, cmath::floor(x), x); }
+    GLIC_CONSTEXPR_ROUND vec2 floor(const vec2 x){ return GLIC_COUNTED(floor, x.apply<floor>(), x); }
+    GLIC_CONSTEXPR_ROUND vec3 floor(const vec3 x){ return GLIC_COUNTED(floor, x.apply<floor>(), x); }
+    GLIC_CONSTEXPR_ROUND vec4 floor(const vec4 x){ return GLIC_COUNTED(floor, x.apply<floor>(), x); }
+
+    GLIC_CONSTEXPR_ROUND float ceil(const float x){ return GLIC_COUNTED(ceil, cmath::ceil(x), x); }
+    GLIC_CONSTEXPR_ROUND vec2 ceil(const vec2 x){ return GLIC_COUNTED(ceil, x.apply<ceil>(), x); }
+    GLIC_CONSTEXPR_ROUND vec3 ceil(const vec3 x){ return GLIC_COUNTED(ceil, x.apply<ceil>(), x); }
+    GLIC_CONSTEXPR_ROUND vec4 ceil(const vec4 x){ return GLIC_COUNTED(ceil, x.apply<ceil>(), x); }
+
+    GLIC_CONSTEXPR_ROUND float fract(const float x){ return GLIC_COUNTED(fract, x - cmath::floor(x), x); }
+    GLIC_CONSTEXPR_ROUND vec2 fract(const vec2 x){ return GLIC_COUNTED(fract, x.apply<fract>(), x); }
+    GLIC_CONSTEXPR_ROUND vec3 fract(const vec3 x){ return GLIC_COUNTED(fract, x.apply<fract>(), x); }
+    GLIC_CONSTEXPR_ROUND vec4 fract(const vec4 x){ return GLIC_COUNTED(fract, x.apply<fract>(), x); }
+
+    // GLSL defines mod as x - y * floor(x / y), so the result takes the sign of y (std::fmod follows x)
+    GLIC_CONSTEXPR_ROUND float mod(const float x, const float y){ return GLIC_COUNTED(mod, x - y * cmath::floor(x / y), x, y); }
+    GLIC_CONSTEXPR_ROUND vec2 mod(const vec2 x, const vec2 y){ return GLIC_COUNTED(mod, vec2::zip<mod>(x, y), x, y); }
+    GLIC_CONSTEXPR_ROUND vec3 mod(const vec3 x, const vec3 y){ return GLIC_COUNTED(mod, vec3::zip<mod>(x, y), x, y); }
+    GLIC_CONSTEXPR_ROUND vec4 mod(const vec4 x, const vec4 y){ return GLIC_COUNTED(mod, vec4::zip<mod>(x, y), x, y); }
+
+    GLIC_CONSTEXPR_ROUND vec2 mod(const vec2 x, const float y){ return GLIC_COUNTED(mod, vec2(mod(x.x, y), mod(x.y, y)), x, y); }
+    GLIC_CONSTEXPR_ROUND vec3 mod(const vec3 x, const float y){ return GLIC_COUNTED(mod, vec3(mod(x.x, y), mod(x.y, y), mod(x.z, y)), x, y); }
+    GLIC_CONSTEXPR_ROUND vec4 mod(const vec4 x, const float y){ return GLIC_COUNTED(mod, vec4(mod(x.x, y), mod(x.y, y), mod(x.z, y), mod(x.w, y)), x, y); }
+
+    // min, max and clamp never branch, the vector forms are whole register operations under GLIC_SIMD
+    GLIC_CONSTEXPR float min(const float x, const float y){ return GLIC_COUNTED(min, std::min(x, y), x, y); }
+    GLIC_CONSTEXPR vec2 min(const vec2 x, const vec2 y){ return GLIC_COUNTED(min, vec2::min(x, y), x, y); }
+    GLIC_CONSTEXPR vec3 min(const vec3 x, const vec3 y){ return GLIC_COUNTED(min, vec3::min(x, y), x, y); }
+    GLIC_CONSTEXPR vec4 min(const vec4 x, const vec4 y){ return GLIC_COUNTED(min, vec4::min(x, y), x, y); }
+
+    GLIC_CONSTEXPR vec2 min(const vec2 x, const float y){ return GLIC_COUNTED(min, vec2::min(x, vec2(y)), x, y); }
+    GLIC_CONSTEXPR vec3 min(const vec3 x, const float y){ return GLIC_COUNTED(min, vec3::min(x, vec3(y)), x, y); }
+    GLIC_CONSTEXPR vec4 min(const vec4 x, const float y){ return GLIC_COUNTED(min, vec4::min(x, vec4(y)), x, y); }
+
+    template <typename T> constexpr tvec2<T> min(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return std::min(a, b); }, x, y); }
+    template <typename T> constexpr tvec3<T> min(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return std::min(a, b); }, x, y); }
+    template <typename T> constexpr tvec4<T> min(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return std::min(a, b); }, x, y); }
+
+    template <typename T> constexpr tvec2<T> min(const tvec2<T> x, const typename tvec2<T>::value_type y){ return min(x, tvec2<T>(y)); }
+    template <typename T> constexpr tvec3<T> min(const tvec3<T> x, const typename tvec3<T>::value_type y){ return min(x, tvec3<T>(y)); }
+    template <typename T> constexpr tvec4<T> min(const tvec4<T> x, const typename tvec4<T>::value_type y){ return min(x, tvec4<T>(y)); }
+
+    GLIC_CONSTEXPR float max(const float x, const float y){ return GLIC_COUNTED(max, std::max(x, y), x, y); }
+    GLIC_CONSTEXPR vec2 max(const vec2 x, const vec2 y){ return GLIC_COUNTED(max, vec2::max(x, y), x, y); }
+    GLIC_CONSTEXPR vec3 max(const vec3 x, const vec3 y){ return GLIC_COUNTED(max, vec3::max(x, y), x, y); }
+    GLIC_CONSTEXPR vec4 max(const vec4 x, const vec4 y){ return GLIC_COUNTED(max, vec4::max(x, y), x, y); }
+
+    GLIC_CONSTEXPR vec2 max(const vec2 x, const float y){ return GLIC_COUNTED(max, vec2::max(x, vec2(y)), x, y); }
+    GLIC_CONSTEXPR vec3 max(const vec3 x, const float y){ return GLIC_COUNTED(max, vec3::max(x, vec3(y)), x, y); }
+    GLIC_CONSTEXPR vec4 max(const vec4 x, const float y){ return GLIC_COUNTED(max, vec4::max(x, vec4(y)), x, y); }
+
+    template <typename T> constexpr tvec2<T> max(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return std::max(a, b); }, x, y); }
+    template <typename T> constexpr tvec3<T> max(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return std::max(a, b); }, x, y); }
+    template <typename T> constexpr tvec4<T> max(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return std::max(a, b); }, x, y); }
+
+    template <typename T> constexpr tvec2<T> max(const tvec2<T> x, const typename tvec2<T>::value_type y){ return max(x, tvec2<T>(y)); }
+    template <typename T> constexpr tvec3<T> max(const tvec3<T> x, const typename tvec3<T>::value_type y){ return max(x, tvec3<T>(y)); }
+    template <typename T> constexpr tvec4<T> max(const tvec4<T> x, const typename tvec4<T>::value_type y){ return max(x, tvec4<T>(y)); }
+
+    GLIC_CONSTEXPR float clamp(const float x, const float minval, const float maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+    GLIC_CONSTEXPR vec2 clamp(const vec2 x, const vec2 minval, const vec2 maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+    GLIC_CONSTEXPR vec3 clamp(const vec3 x, const vec3 minval, const vec3 maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+    GLIC_CONSTEXPR vec4 clamp(const vec4 x, const vec4 minval, const vec4 maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+
+    GLIC_CONSTEXPR vec2 clamp(const vec2 x, const float minval, const float maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+    GLIC_CONSTEXPR vec3 clamp(const vec3 x, const float minval, const float maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+    GLIC_CONSTEXPR vec4 clamp(const vec4 x, const float minval, const float maxval){ return GLIC_COUNTED(clamp, min(max(x, minval), maxval), x, minval, maxval); }
+
+    template <typename T> constexpr tvec2<T> clamp(const tvec2<T> x, const tvec2<T> minval, const tvec2<T> maxval){ return min(max(x, minval), maxval); }
+    template <typename T> constexpr tvec3<T> clamp(const tvec3<T> x, const tvec3<T> minval, const tvec3<T> maxval){ return min(max(x, minval), maxval); }
+    template <typename T> constexpr tvec4<T> clamp(const tvec4<T> x, const tvec4<T> minval, const tvec4<T> maxval){ return min(max(x, minval), maxval); }
+
+    template <typename T> constexpr tvec2<T> clamp(const tvec2<T> x, const typename tvec2<T>::value_type minval, const typename tvec2<T>::value_type maxval){ return min(max(x, minval), maxval); }
+    template <typename T> constexpr tvec3<T> clamp(const tvec3<T> x, const typename tvec3<T>::value_type minval, const typename tvec3<T>::value_type maxval){ return min(max(x, minval), maxval); }
+    template <typename T> constexpr tvec4<T> clamp(const tvec4<T> x, const typename tvec4<T>::value_type minval, const typename tvec4<T>::value_type maxval){ return min(max(x, minval), maxval); }
+
+    GLIC_CONSTEXPR float mix(const float x, const float y, const float a){
         #if __cplusplus >= 202002L
-            return std::lerp(x, y, a);
+            return GLIC_COUNTED(mix, std::lerp(x, y, a), x, y, a);
         #else
-            return x + a * (y - x);
+            return GLIC_COUNTED(mix, x + a * (y - x), x, y, a);
         #endif
     }
 
-    vec2 mix(const vec2 x, const vec2 y, const vec2 a){ return vec2(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y)); }
-    vec3 mix(const vec3 x, const vec3 y, const vec3 a){ return vec3(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y), mix(x.z, y.z, a.z)); }
-    vec4 mix(const vec4 x, const vec4 y, const vec4 a){ return vec4(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y), mix(x.z, y.z, a.z), mix(x.w, y.w, a.w)); }
-
-    vec2 mix(const vec2 x, const vec2 y, const float a){ return vec2(mix(x.x, y.x, a), mix(x.y, y.y, a)); }
-    vec3 mix(const vec3 x, const vec3 y, const float a){ return vec3(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a)); }
-    vec4 mix(const vec4 x, const vec4 y, const float a){ return vec4(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a), mix(x.w, y.w, a)); }
-
-    float smoothstep(const float edge0, const float edge1, const float x){
-        const float t = clamp((x - edge0) / (edge1 - edge0), 0.0, 1.0);
-        return t * t * (3.0 - 2.0 * t);
+    GLIC_CONSTEXPR vec2 mix(const vec2 x, const vec2 y, const vec2 a){ return GLIC_COUNTED(mix, vec2(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y)), x, y, a); }
+    GLIC_CONSTEXPR vec3 mix(const vec3 x, const vec3 y, const vec3 a){ return GLIC_COUNTED(mix, vec3(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y), mix(x.z, y.z, a.z)), x, y, a); }
+    GLIC_CONSTEXPR vec4 mix(const vec4 x, const vec4 y, const vec4 a){ return GLIC_COUNTED(mix, vec4(mix(x.x, y.x, a.x), mix(x.y, y.y, a.y), mix(x.z, y.z, a.z), mix(x.w, y.w, a.w)), x, y, a); }
+
+    GLIC_CONSTEXPR vec2 mix(const vec2 x, const vec2 y, const float a){ return GLIC_COUNTED(mix, vec2(mix(x.x, y.x, a), mix(x.y, y.y, a)), x, y, a); }
+    GLIC_CONSTEXPR vec3 mix(const vec3 x, const vec3 y, const float a){ return GLIC_COUNTED(mix, vec3(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a)), x, y, a); }
+    GLIC_CONSTEXPR vec4 mix(const vec4 x, const vec4 y, const float a){ return GLIC_COUNTED(mix, vec4(mix(x.x, y.x, a), mix(x.y, y.y, a), mix(x.z, y.z, a), mix(x.w, y.w, a)), x, y, a); }
+
+    // select(condition, a, b) is a where condition holds and b elsewhere, lane by lane for a bvec condition
+    // it is condition ? a : b with both sides evaluated up front, which the compiler turns into conditional moves or blends,
+    // so divergent lanes cost a blend instead of a mispredicted branch (not GLSL, which only has mix with a bvec, below)
+    GLIC_CONSTEXPR float select(const bool condition, const float a, const float b){ return condition ? a : b; }
+    GLIC_CONSTEXPR vec2 select(const bvec2 condition, const vec2 a, const vec2 b){ return vec2::select(condition, a, b); }
+    GLIC_CONSTEXPR vec3 select(const bvec3 condition, const vec3 a, const vec3 b){ return vec3::select(condition, a, b); }
+    GLIC_CONSTEXPR vec4 select(const bvec4 condition, const vec4 a, const vec4 b){ return vec4::select(condition, a, b); }
+
+    GLIC_CONSTEXPR vec2 select(const bool condition, const vec2 a, const vec2 b){ return vec2::select(condition, a, b); }
+    GLIC_CONSTEXPR vec3 select(const bool condition, const vec3 a, const vec3 b){ return vec3::select(condition, a, b); }
+    GLIC_CONSTEXPR vec4 select(const bool condition, const vec4 a, const vec4 b){ return vec4::select(condition, a, b); }
+
+    template <typename T> constexpr tvec2<T> select(const bvec2 condition, const tvec2<T> a, const tvec2<T> b){ return tvec2<T>(condition.x ? a.x : b.x, condition.y ? a.y : b.y); }
+    template <typename T> constexpr tvec3<T> select(const bvec3 condition, const tvec3<T> a, const tvec3<T> b){ return tvec3<T>(condition.x ? a.x : b.x, condition.y ? a.y : b.y, condition.z ? a.z : b.z); }
+    template <typename T> constexpr tvec4<T> select(const bvec4 condition, const tvec4<T> a, const tvec4<T> b){ return tvec4<T>(condition.x ? a.x : b.x, condition.y ? a.y : b.y, condition.z ? a.z : b.z, condition.w ? a.w : b.w); }
+
+    template <typename T> constexpr tvec2<T> select(const bool condition, const tvec2<T> a, const tvec2<T> b){ return select(bvec2(condition), a, b); }
+    template <typename T> constexpr tvec3<T> select(const bool condition, const tvec3<T> a, const tvec3<T> b){ return select(bvec3(condition), a, b); }
+    template <typename T> constexpr tvec4<T> select(const bool condition, const tvec4<T> a, const tvec4<T> b){ return select(bvec4(condition), a, b); }
+
+    // y where a is true, x elsewhere
+    // (the scalar form only takes a real bool, so mix(x, y, 1) keeps meaning the float blend)
+    template <typename B, typename = typename std::enable_if<std::is_same<B, bool>::value>::type> constexpr float mix(const float x, const float y, const B a){ return select(a, y, x); }
+    GLIC_CONSTEXPR vec2 mix(const vec2 x, const vec2 y, const bvec2 a){ return GLIC_COUNTED(mix, select(a, y, x), x, y, a); }
+    GLIC_CONSTEXPR vec3 mix(const vec3 x, const vec3 y, const bvec3 a){ return GLIC_COUNTED(mix, select(a, y, x), x, y, a); }
+    GLIC_CONSTEXPR vec4 mix(const vec4 x, const vec4 y, const bvec4 a){ return GLIC_COUNTED(mix, select(a, y, x), x, y, a); }
+
+    GLIC_CONSTEXPR float smoothstep(const float edge0, const float edge1, const float x){
+        return GLIC_COUNTED(smoothstep, [&](){
+            const float t = clamp((x - edge0) / (edge1 - edge0), 0.0f, 1.0f);
+            return t * t * (3.0f - 2.0f * t);
+        }(), edge0, edge1, x);
     }
 
-    vec2 smoothstep(const vec2 edge0, const vec2 edge1, const vec2 x){ return vec2(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y)); }
-    vec3 smoothstep(const vec3 edge0, const vec3 edge1, const vec3 x){ return vec3(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y), smoothstep(edge0.z, edge1.z, x.z)); }
-    vec4 smoothstep(const vec4 edge0, const vec4 edge1, const vec4 x){ return vec4(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y), smoothstep(edge0.z, edge1.z, x.z), smoothstep(edge0.w, edge1.w, x.w)); }
+    GLIC_CONSTEXPR vec2 smoothstep(const vec2 edge0, const vec2 edge1, const vec2 x){ return GLIC_COUNTED(smoothstep, vec2(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y)), edge0, edge1, x); }
+    GLIC_CONSTEXPR vec3 smoothstep(const vec3 edge0, const vec3 edge1, const vec3 x){ return GLIC_COUNTED(smoothstep, vec3(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y), smoothstep(edge0.z, edge1.z, x.z)), edge0, edge1, x); }
+    GLIC_CONSTEXPR vec4 smoothstep(const vec4 edge0, const vec4 edge1, const vec4 x){ return GLIC_COUNTED(smoothstep, vec4(smoothstep(edge0.x, edge1.x, x.x), smoothstep(edge0.y, edge1.y, x.y), smoothstep(edge0.z, edge1.z, x.z), smoothstep(edge0.w, edge1.w, x.w)), edge0, edge1, x); }
 
-    vec2 smoothstep(const float edge0, const float edge1, const vec2 x){ return vec2(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y)); }
-    vec3 smoothstep(const float edge0, const float edge1, const vec3 x){ return vec3(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z)); }
-    vec4 smoothstep(const float edge0, const float edge1, const vec4 x){ return vec4(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z), smoothstep(edge0, edge1, x.w)); }
+    GLIC_CONSTEXPR vec2 smoothstep(const float edge0, const float edge1, const vec2 x){ return GLIC_COUNTED(smoothstep, vec2(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y)), edge0, edge1, x); }
+    GLIC_CONSTEXPR vec3 smoothstep(const float edge0, const float edge1, const vec3 x){ return GLIC_COUNTED(smoothstep, vec3(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z)), edge0, edge1, x); }
+    GLIC_CONSTEXPR vec4 smoothstep(const float edge0, const float edge1, const vec4 x){ return GLIC_COUNTED(smoothstep, vec4(smoothstep(edge0, edge1, x.x), smoothstep(edge0, edge1, x.y), smoothstep(edge0, edge1, x.z), smoothstep(edge0, edge1, x.w)), edge0, edge1, x); }
 
-    float step(const float edge, const float x){ return x >= edge; }
-    vec2 step(const vec2 edge, const vec2 x){ return vec2::zip(step, edge, x); }
-    vec3 step(const vec3 edge, const vec3 x){ return vec3::zip(step, edge, x); }
-    vec4 step(const vec4 edge, const vec4 x){ return vec4::zip(step, edge, x); }
+    GLIC_CONSTEXPR float step(const float edge, const float x){ return GLIC_COUNTED(step, x >= edge, edge, x); }
+    GLIC_CONSTEXPR vec2 step(const vec2 edge, const vec2 x){ return GLIC_COUNTED(step, vec2::zip<step>(edge, x), edge, x); }
+    GLIC_CONSTEXPR vec3 step(const vec3 edge, const vec3 x){ return GLIC_COUNTED(step, vec3::zip<step>(edge, x), edge, x); }
+    GLIC_CONSTEXPR vec4 step(const vec4 edge, const vec4 x){ return GLIC_COUNTED(step, vec4::zip<step>(edge, x), edge, x); }
 
-    float step(const float edge, const float x){ return x >= edge; }
-    vec2 step(const float edge, const vec2 x){ return vec2(step(edge, x.x), step(edge, x.y)); }
-    vec3 step(const float edge, const vec3 x){ return vec3(step(edge, x.x), step(edge, x.y), step(edge, x.z)); }
-    vec4 step(const float edge, const vec4 x){ return vec4(step(edge, x.x), step(edge, x.y), step(edge, x.z), step(edge, x.w)); }
+    GLIC_CONSTEXPR vec2 step(const float edge, const vec2 x){ return GLIC_COUNTED(step, vec2(step(edge, x.x), step(edge, x.y)), edge, x); }
+    GLIC_CONSTEXPR vec3 step(const float edge, const vec3 x){ return GLIC_COUNTED(step, vec3(step(edge, x.x), step(edge, x.y), step(edge, x.z)), edge, x); }
+    GLIC_CONSTEXPR vec4 step(const float edge, const vec4 x){ return GLIC_COUNTED(step, vec4(step(edge, x.x), step(edge, x.y), step(edge, x.z), step(edge, x.w)), edge, x); }
     
     // geometric
 
-    float length(const float x){ return std::abs(x); }
-    float length(const vec2 x){ return std::sqrt(x.x * x.x + x.y * x.y); }
-    float length(const vec3 x){ return std::sqrt(x.x * x.x + x.y * x.y + x.z * x.z); }
-    float length(const vec4 x){ return std::sqrt(x.x * x.x + x.y * x.y + x.z * x.z + x.w * x.w); }
+    GLIC_CONSTEXPR_ROUND float length(const float x){ return GLIC_COUNTED(length, cmath::abs(x), x); }
+    GLIC_CONSTEXPR20 float length(const vec2 x){ return GLIC_COUNTED(length, cmath::sqrt(x.x * x.x + x.y * x.y), x); }
+    GLIC_CONSTEXPR20 float length(const vec3 x){ return GLIC_COUNTED(length, cmath::sqrt(x.x * x.x + x.y * x.y + x.z * x.z), x); }
+    GLIC_CONSTEXPR20 float length(const vec4 x){ return GLIC_COUNTED(length, cmath::sqrt(x.x * x.x + x.y * x.y + x.z * x.z + x.w * x.w), x); }
 
-    float distance(const float p0, const float p1){ length(p1 - p0); }
-    float distance(const vec2 p0, const vec2 p1){ length(p1 - p0); }
-    float distance(const vec3 p0, const vec3 p1){ length(p1 - p0); }
-    float distance(const vec4 p0, const vec4 p1){ length(p1 - p0); }
+    GLIC_CONSTEXPR_ROUND float distance(const float p0, const float p1){ return GLIC_COUNTED(distance, length(p1 - p0), p0, p1); }
+    GLIC_CONSTEXPR20 float distance(const vec2 p0, const vec2 p1){ return GLIC_COUNTED(distance, length(p1 - p0), p0, p1); }
+    GLIC_CONSTEXPR20 float distance(const vec3 p0, const vec3 p1){ return GLIC_COUNTED(distance, length(p1 - p0), p0, p1); }
+    GLIC_CONSTEXPR20 float distance(const vec4 p0, const vec4 p1){ return GLIC_COUNTED(distance, length(p1 - p0), p0, p1); }
 
-    float dot(const float x, const float y){ return x * y; }
-    float dot(const vec2 x, const vec2 y){ return x.x * y.x + x.y * y.y; }
-    float dot(const vec3 x, const vec3 y){ return x.x * y.x + x.y * y.y + x.z * y.z; }
-    float dot(const vec4 x, const vec4 y){ return x.x * y.x + x.y * y.y + x.z * y.z + x.w * y.w; }
+    GLIC_CONSTEXPR float dot(const float x, const float y){ return GLIC_COUNTED(dot, x * y, x, y); }
+    GLIC_CONSTEXPR float dot(const vec2 x, const vec2 y){ return GLIC_COUNTED(dot, x.x * y.x + x.y * y.y, x, y); }
+    GLIC_CONSTEXPR float dot(const vec3 x, const vec3 y){ return GLIC_COUNTED(dot, x.x * y.x + x.y * y.y + x.z * y.z, x, y); }
+    GLIC_CONSTEXPR float dot(const vec4 x, const vec4 y){ return GLIC_COUNTED(dot, x.x * y.x + x.y * y.y + x.z * y.z + x.w * y.w, x, y); }
 
-    vec3 cross(const vec3 x, const vec3 y){
-        return vec3(
+    GLIC_CONSTEXPR vec3 cross(const vec3 x, const vec3 y){
+        return GLIC_COUNTED(cross, vec3(
             x.y * y.z - x.z * y.y,
             x.z * y.x - x.x * y.z,
             x.x * y.y - x.y * y.x
-        );
+        ), x, y);
+    }
+
+    GLIC_CONSTEXPR20 float normalize(const float x){ return GLIC_COUNTED(normalize, x / length(x), x); }
+    GLIC_CONSTEXPR20 vec2 normalize(const vec2 x){ return GLIC_COUNTED(normalize, x / length(x), x); }
+    GLIC_CONSTEXPR20 vec3 normalize(const vec3 x){ return GLIC_COUNTED(normalize, x / length(x), x); }
+    GLIC_CONSTEXPR20 vec4 normalize(const vec4 x){ return GLIC_COUNTED(normalize, x / length(x), x); }
+
+    GLIC_CONSTEXPR float faceforward(const float n, const float i, const float nref){ return GLIC_COUNTED(faceforward, select(dot(nref, i) < 0.0f, n, -n), n, i, nref); }
+    GLIC_CONSTEXPR vec2 faceforward(const vec2 n, const vec2 i, const vec2 nref){ return GLIC_COUNTED(faceforward, select(dot(nref, i) < 0.0f, n, -n), n, i, nref); }
+    GLIC_CONSTEXPR vec3 faceforward(const vec3 n, const vec3 i, const vec3 nref){ return GLIC_COUNTED(faceforward, select(dot(nref, i) < 0.0f, n, -n), n, i, nref); }
+    GLIC_CONSTEXPR vec4 faceforward(const vec4 n, const vec4 i, const vec4 nref){ return GLIC_COUNTED(faceforward, select(dot(nref, i) < 0.0f, n, -n), n, i, nref); }
+
+    GLIC_CONSTEXPR float reflect(const float i, const float n){ return GLIC_COUNTED(reflect, i - 2 * dot(n, i) * n, i, n); }
+    GLIC_CONSTEXPR vec2 reflect(const vec2 i, const vec2 n){ return GLIC_COUNTED(reflect, i - 2 * dot(n, i) * n, i, n); }
+    GLIC_CONSTEXPR vec3 reflect(const vec3 i, const vec3 n){ return GLIC_COUNTED(reflect, i - 2 * dot(n, i) * n, i, n); }
+    GLIC_CONSTEXPR vec4 reflect(const vec4 i, const vec4 n){ return GLIC_COUNTED(reflect, i - 2 * dot(n, i) * n, i, n); }
+
+    // both outcomes are computed and blended, the square root is clamped so total internal reflection does not take a nan
+    // through it
+    GLIC_CONSTEXPR20 float refract(const float i, const float n, const float eta){
+        return GLIC_COUNTED(refract, [&](){
+            const float dotni = dot(n, i);
+            const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+            return select(k < 0.0f, 0.0f, eta * i - (eta * dotni + cmath::sqrt(std::max(k, 0.0f))) * n);
+        }(), i, n, eta);
     }
 
-    float normalize(const float x){ return x / x; }
-    vec2 normalize(const vec2 x){ return x / length(x); }
-    vec3 normalize(const vec3 x){ return x / length(x); }
-    vec4 normalize(const vec4 x){ return x / length(x); }
-
-    float faceforward(const float n, const float i, const float nref){ return dot(nref, i) < 0 ? n : -n; }
-    vec2 faceforward(const vec2 n, const vec2 i, const vec2 nref){ return dot(nref, i) < 0 ? n : -n; }
-    vec3 faceforward(const vec3 n, const vec3 i, const vec3 nref){ return dot(nref, i) < 0 ? n : -n; }
-    vec4 faceforward(const vec4 n, const vec4 i, const vec4 nref){ return dot(nref, i) < 0 ? n : -n; }
-
-    float reflect(const float i, const float n){ return i - 2 * dot(n, i) * n; }
-    vec2 reflect(const vec2 i, const vec2 n){ return i - 2 * dot(n, i) * n; }
-    vec3 reflect(const vec3 i, const vec3 n){ return i - 2 * dot(n, i) * n; }
-    vec4 reflect(const vec4 i, const vec4 n){ return i - 2 * dot(n, i) * n; }
-
-    float refract(const float i, const float n, const float eta){
-        const float dotni = dot(n, i);
-        float k = 1.0 - eta * eta * (1.0 - dotni * dotni);
-        return (k < 0.0) ? 0.0 : (eta * i - (eta * dotni + sqrt(k)) * n);
+    GLIC_CONSTEXPR20 vec2 refract(const vec2 i, const vec2 n, const float eta){
+        return GLIC_COUNTED(refract, [&](){
+            const float dotni = dot(n, i);
+            const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+            return select(k < 0.0f, vec2(0.0f), eta * i - (eta * dotni + cmath::sqrt(std::max(k, 0.0f))) * n);
+        }(), i, n, eta);
     }
 
-    vec2 refract(const vec2 i, const vec2 n, const float eta){
-        const float dotni = dot(n, i);
-        float k = 1.0 - eta * eta * (1.0 - dotni * dotni);
-        return (k < 0.0) ? vec2(0.0) : (eta * i - (eta * dotni + sqrt(k)) * n);
+    GLIC_CONSTEXPR20 vec3 refract(const vec3 i, const vec3 n, const float eta){
+        return GLIC_COUNTED(refract, [&](){
+            const float dotni = dot(n, i);
+            const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+            return select(k < 0.0f, vec3(0.0f), eta * i - (eta * dotni + cmath::sqrt(std::max(k, 0.0f))) * n);
+        }(), i, n, eta);
     }
 
-    vec3 refract(const vec3 i, const vec3 n, const float eta){
-        const float dotni = dot(n, i);
-        float k = 1.0 - eta * eta * (1.0 - dotni * dotni);
-        return (k < 0.0) ? vec3(0.0) : (eta * i - (eta * dotni + sqrt(k)) * n);
+    GLIC_CONSTEXPR20 vec4 refract(const vec4 i, const vec4 n, const float eta){
+        return GLIC_COUNTED(refract, [&](){
+            const float dotni = dot(n, i);
+            const float k = 1.0f - eta * eta * (1.0f - dotni * dotni);
+            return select(k < 0.0f, vec4(0.0f), eta * i - (eta * dotni + cmath::sqrt(std::max(k, 0.0f))) * n);
+        }(), i, n, eta);
     }
 
-    vec4 refract(const vec4 i, const vec4 n, const float eta){
-        const float dotni = dot(n, i);
-        float k = 1.0 - eta * eta * (1.0 - dotni * dotni);
-        return (k < 0.0) ? vec4(0.0) : (eta * i - (eta * dotni + sqrt(k)) * n);
+    // matrix
+
+    inline mat2 matrixCompMult(const mat2& x, const mat2& y){ return mat2(x[0] * y[0], x[1] * y[1]); }
+    inline mat3 matrixCompMult(const mat3& x, const mat3& y){ return mat3(x[0] * y[0], x[1] * y[1], x[2] * y[2]); }
+    inline mat4 matrixCompMult(const mat4& x, const mat4& y){ return mat4(x[0] * y[0], x[1] * y[1], x[2] * y[2], x[3] * y[3]); }
+
+    // column c times row r, so result[i] = c * r[i]
+    inline mat2 outerProduct(const vec2 c, const vec2 r){ return mat2(c * r.x, c * r.y); }
+    inline mat3 outerProduct(const vec3 c, const vec3 r){ return mat3(c * r.x, c * r.y, c * r.z); }
+    inline mat4 outerProduct(const vec4 c, const vec4 r){ return mat4(c * r.x, c * r.y, c * r.z, c * r.w); }
+
+    inline mat2 transpose(const mat2& m){ return mat2(m[0].x, m[1].x, m[0].y, m[1].y); }
+    inline mat3 transpose(const mat3& m){ return mat3(m[0].x, m[1].x, m[2].x, m[0].y, m[1].y, m[2].y, m[0].z, m[1].z, m[2].z); }
+    inline mat4 transpose(const mat4& m){
+        return mat4(
+            m[0].x, m[1].x, m[2].x, m[3].x,
+            m[0].y, m[1].y, m[2].y, m[3].y,
+            m[0].z, m[1].z, m[2].z, m[3].z,
+            m[0].w, m[1].w, m[2].w, m[3].w
+        );
+    }
+
+    inline float determinant(const mat2& m){ return m[0].x * m[1].y - m[1].x * m[0].y; }
+    inline float determinant(const mat3& m){ return dot(m[0], cross(m[1], m[2])); }
+
+    // the 4 x 4 determinant and inverse share the twelve 2 x 2 minors of the upper two and lower two rows
+    // (laplace expansion), written for a[column][row] storage
+    namespace detail {
+        struct minors4 {
+            float s0, s1, s2, s3, s4, s5, c0, c1, c2, c3, c4, c5;
+
+            minors4(const mat4& m) :
+                s0(m[0].x * m[1].y - m[1].x * m[0].y), s1(m[0].x * m[1].z - m[1].x * m[0].z), s2(m[0].x * m[1].w - m[1].x * m[0].w),
+                s3(m[0].y * m[1].z - m[1].y * m[0].z), s4(m[0].y * m[1].w - m[1].y * m[0].w), s5(m[0].z * m[1].w - m[1].z * m[0].w),
+                c0(m[2].x * m[3].y - m[3].x * m[2].y), c1(m[2].x * m[3].z - m[3].x * m[2].z), c2(m[2].x * m[3].w - m[3].x * m[2].w),
+                c3(m[2].y * m[3].z - m[3].y * m[2].z), c4(m[2].y * m[3].w - m[3].y * m[2].w), c5(m[2].z * m[3].w - m[3].z * m[2].w) {}
+
+            float determinant() const { return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0; }
+        };
+    };
+
+    inline float determinant(const mat4& m){ return detail::minors4(m).determinant(); }
+
+    // singular matrices give inf or nan elements, as GLSL leaves them undefined
+    inline mat2 inverse(const mat2& m){ return mat2(m[1].y, -m[0].y, -m[1].x, m[0].x) / determinant(m); }
+
+    inline mat3 inverse(const mat3& m){
+        // the rows of the inverse are the cross products of column pairs
+        const vec3 r0 = cross(m[1], m[2]), r1 = cross(m[2], m[0]), r2 = cross(m[0], m[1]);
+        return transpose(mat3(r0, r1, r2)) / dot(m[0], r0);
     }
+
+    inline mat4 inverse(const mat4& m){
+        const detail::minors4 k(m);
+        const vec4 a = m[0], b = m[1], c = m[2], d = m[3];
+        return mat4(
+            vec4( b.y * k.c5 - b.z * k.c4 + b.w * k.c3, -a.y * k.c5 + a.z * k.c4 - a.w * k.c3,  d.y * k.s5 - d.z * k.s4 + d.w * k.s3, -c.y * k.s5 + c.z * k.s4 - c.w * k.s3),
+            vec4(-b.x * k.c5 + b.z * k.c2 - b.w * k.c1,  a.x * k.c5 - a.z * k.c2 + a.w * k.c1, -d.x * k.s5 + d.z * k.s2 - d.w * k.s1,  c.x * k.s5 - c.z * k.s2 + c.w * k.s1),
+            vec4( b.x * k.c4 - b.y * k.c2 + b.w * k.c0, -a.x * k.c4 + a.y * k.c2 - a.w * k.c0,  d.x * k.s4 - d.y * k.s2 + d.w * k.s0, -c.x * k.s4 + c.y * k.s2 - c.w * k.s0),
+            vec4(-b.x * k.c3 + b.y * k.c1 - b.z * k.c0,  a.x * k.c3 - a.y * k.c1 + a.z * k.c0, -d.x * k.s3 + d.y * k.s1 - d.z * k.s0,  c.x * k.s3 - c.y * k.s1 + c.z * k.s0)
+        ) / k.determinant();
+    }
+
+    // vector relational
+    // comparisons give a bvec, which any, all, not_, select and mix(x, y, bvec) consume without branching
+
+    GLIC_CONSTEXPR bvec2 lessThan(const vec2 x, const vec2 y){ return bvec2(x.x < y.x, x.y < y.y); }
+    GLIC_CONSTEXPR bvec3 lessThan(const vec3 x, const vec3 y){ return bvec3(x.x < y.x, x.y < y.y, x.z < y.z); }
+    GLIC_CONSTEXPR bvec4 lessThan(const vec4 x, const vec4 y){ return bvec4(x.x < y.x, x.y < y.y, x.z < y.z, x.w < y.w); }
+
+    GLIC_CONSTEXPR bvec2 lessThanEqual(const vec2 x, const vec2 y){ return bvec2(x.x <= y.x, x.y <= y.y); }
+    GLIC_CONSTEXPR bvec3 lessThanEqual(const vec3 x, const vec3 y){ return bvec3(x.x <= y.x, x.y <= y.y, x.z <= y.z); }
+    GLIC_CONSTEXPR bvec4 lessThanEqual(const vec4 x, const vec4 y){ return bvec4(x.x <= y.x, x.y <= y.y, x.z <= y.z, x.w <= y.w); }
+
+    GLIC_CONSTEXPR bvec2 greaterThan(const vec2 x, const vec2 y){ return bvec2(x.x > y.x, x.y > y.y); }
+    GLIC_CONSTEXPR bvec3 greaterThan(const vec3 x, const vec3 y){ return bvec3(x.x > y.x, x.y > y.y, x.z > y.z); }
+    GLIC_CONSTEXPR bvec4 greaterThan(const vec4 x, const vec4 y){ return bvec4(x.x > y.x, x.y > y.y, x.z > y.z, x.w > y.w); }
+
+    GLIC_CONSTEXPR bvec2 greaterThanEqual(const vec2 x, const vec2 y){ return bvec2(x.x >= y.x, x.y >= y.y); }
+    GLIC_CONSTEXPR bvec3 greaterThanEqual(const vec3 x, const vec3 y){ return bvec3(x.x >= y.x, x.y >= y.y, x.z >= y.z); }
+    GLIC_CONSTEXPR bvec4 greaterThanEqual(const vec4 x, const vec4 y){ return bvec4(x.x >= y.x, x.y >= y.y, x.z >= y.z, x.w >= y.w); }
+
+    GLIC_CONSTEXPR bvec2 equal(const vec2 x, const vec2 y){ return bvec2(x.x == y.x, x.y == y.y); }
+    GLIC_CONSTEXPR bvec3 equal(const vec3 x, const vec3 y){ return bvec3(x.x == y.x, x.y == y.y, x.z == y.z); }
+    GLIC_CONSTEXPR bvec4 equal(const vec4 x, const vec4 y){ return bvec4(x.x == y.x, x.y == y.y, x.z == y.z, x.w == y.w); }
+
+    GLIC_CONSTEXPR bvec2 notEqual(const vec2 x, const vec2 y){ return bvec2(x.x != y.x, x.y != y.y); }
+    GLIC_CONSTEXPR bvec3 notEqual(const vec3 x, const vec3 y){ return bvec3(x.x != y.x, x.y != y.y, x.z != y.z); }
+    GLIC_CONSTEXPR bvec4 notEqual(const vec4 x, const vec4 y){ return bvec4(x.x != y.x, x.y != y.y, x.z != y.z, x.w != y.w); }
+
+    template <typename T> constexpr bvec2 lessThan(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a < b; }, x, y); }
+    template <typename T> constexpr bvec3 lessThan(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a < b; }, x, y); }
+    template <typename T> constexpr bvec4 lessThan(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a < b; }, x, y); }
+
+    template <typename T> constexpr bvec2 lessThanEqual(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a <= b; }, x, y); }
+    template <typename T> constexpr bvec3 lessThanEqual(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a <= b; }, x, y); }
+    template <typename T> constexpr bvec4 lessThanEqual(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a <= b; }, x, y); }
+
+    template <typename T> constexpr bvec2 greaterThan(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a > b; }, x, y); }
+    template <typename T> constexpr bvec3 greaterThan(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a > b; }, x, y); }
+    template <typename T> constexpr bvec4 greaterThan(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a > b; }, x, y); }
+
+    template <typename T> constexpr bvec2 greaterThanEqual(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a >= b; }, x, y); }
+    template <typename T> constexpr bvec3 greaterThanEqual(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a >= b; }, x, y); }
+    template <typename T> constexpr bvec4 greaterThanEqual(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a >= b; }, x, y); }
+
+    // equal and notEqual also compare bvecs
+    template <typename T> constexpr bvec2 equal(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a == b; }, x, y); }
+    template <typename T> constexpr bvec3 equal(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a == b; }, x, y); }
+    template <typename T> constexpr bvec4 equal(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a == b; }, x, y); }
+
+    template <typename T> constexpr bvec2 notEqual(const tvec2<T> x, const tvec2<T> y){ return tvec2<T>::zip([](const T a, const T b){ return a != b; }, x, y); }
+    template <typename T> constexpr bvec3 notEqual(const tvec3<T> x, const tvec3<T> y){ return tvec3<T>::zip([](const T a, const T b){ return a != b; }, x, y); }
+    template <typename T> constexpr bvec4 notEqual(const tvec4<T> x, const tvec4<T> y){ return tvec4<T>::zip([](const T a, const T b){ return a != b; }, x, y); }
+
+    // reduced with bitwise operators, so they stay branch free too
+    GLIC_CONSTEXPR bool any(const bvec2 x){ return x.x | x.y; }
+    GLIC_CONSTEXPR bool any(const bvec3 x){ return x.x | x.y | x.z; }
+    GLIC_CONSTEXPR bool any(const bvec4 x){ return x.x | x.y | x.z | x.w; }
+
+    GLIC_CONSTEXPR bool all(const bvec2 x){ return x.x & x.y; }
+    GLIC_CONSTEXPR bool all(const bvec3 x){ return x.x & x.y & x.z; }
+    GLIC_CONSTEXPR bool all(const bvec4 x){ return x.x & x.y & x.z & x.w; }
+
+    // GLSL's not(), renamed since not is a c++ keyword
+    GLIC_CONSTEXPR bvec2 not_(const bvec2 x){ return bvec2(!x.x, !x.y); }
+    GLIC_CONSTEXPR bvec3 not_(const bvec3 x){ return bvec3(!x.x, !x.y, !x.z); }
+    GLIC_CONSTEXPR bvec4 not_(const bvec4 x){ return bvec4(!x.x, !x.y, !x.z, !x.w); }
+
+    GLIC_CONSTEXPR20 bool isnan(const float x){ return cmath::isnan(x); }
+    GLIC_CONSTEXPR20 bvec2 isnan(const vec2 x){ return bvec2(isnan(x.x), isnan(x.y)); }
+    GLIC_CONSTEXPR20 bvec3 isnan(const vec3 x){ return bvec3(isnan(x.x), isnan(x.y), isnan(x.z)); }
+    GLIC_CONSTEXPR20 bvec4 isnan(const vec4 x){ return bvec4(isnan(x.x), isnan(x.y), isnan(x.z), isnan(x.w)); }
+
+    GLIC_CONSTEXPR20 bool isinf(const float x){ return cmath::isinf(x); }
+    GLIC_CONSTEXPR20 bvec2 isinf(const vec2 x){ return bvec2(isinf(x.x), isinf(x.y)); }
+    GLIC_CONSTEXPR20 bvec3 isinf(const vec3 x){ return bvec3(isinf(x.x), isinf(x.y), isinf(x.z)); }
+    GLIC_CONSTEXPR20 bvec4 isinf(const vec4 x){ return bvec4(isinf(x.x), isinf(x.y), isinf(x.z), isinf(x.w)); }
+
+    // bit casts between a float and the 32 bit integer with the same bits
+
+    GLIC_CONSTEXPR20 std::int32_t floatBitsToInt(const float value){ return static_cast<std::int32_t>(approx::detail::bits(value)); }
+    GLIC_CONSTEXPR20 ivec2 floatBitsToInt(const vec2 value){ return ivec2(floatBitsToInt(value.x), floatBitsToInt(value.y)); }
+    GLIC_CONSTEXPR20 ivec3 floatBitsToInt(const vec3 value){ return ivec3(floatBitsToInt(value.x), floatBitsToInt(value.y), floatBitsToInt(value.z)); }
+    GLIC_CONSTEXPR20 ivec4 floatBitsToInt(const vec4 value){ return ivec4(floatBitsToInt(value.x), floatBitsToInt(value.y), floatBitsToInt(value.z), floatBitsToInt(value.w)); }
+
+    GLIC_CONSTEXPR20 std::uint32_t floatBitsToUint(const float value){ return approx::detail::bits(value); }
+    GLIC_CONSTEXPR20 uvec2 floatBitsToUint(const vec2 value){ return uvec2(floatBitsToUint(value.x), floatBitsToUint(value.y)); }
+    GLIC_CONSTEXPR20 uvec3 floatBitsToUint(const vec3 value){ return uvec3(floatBitsToUint(value.x), floatBitsToUint(value.y), floatBitsToUint(value.z)); }
+    GLIC_CONSTEXPR20 uvec4 floatBitsToUint(const vec4 value){ return uvec4(floatBitsToUint(value.x), floatBitsToUint(value.y), floatBitsToUint(value.z), floatBitsToUint(value.w)); }
+
+    GLIC_CONSTEXPR20 float intBitsToFloat(const std::int32_t value){ return approx::detail::from_bits(static_cast<std::uint32_t>(value)); }
+    GLIC_CONSTEXPR20 vec2 intBitsToFloat(const ivec2 value){ return vec2(intBitsToFloat(value.x), intBitsToFloat(value.y)); }
+    GLIC_CONSTEXPR20 vec3 intBitsToFloat(const ivec3 value){ return vec3(intBitsToFloat(value.x), intBitsToFloat(value.y), intBitsToFloat(value.z)); }
+    GLIC_CONSTEXPR20 vec4 intBitsToFloat(const ivec4 value){ return vec4(intBitsToFloat(value.x), intBitsToFloat(value.y), intBitsToFloat(value.z), intBitsToFloat(value.w)); }
+
+    GLIC_CONSTEXPR20 float uintBitsToFloat(const std::uint32_t value){ return approx::detail::from_bits(value); }
+    GLIC_CONSTEXPR20 vec2 uintBitsToFloat(const uvec2 value){ return vec2(uintBitsToFloat(value.x), uintBitsToFloat(value.y)); }
+    GLIC_CONSTEXPR20 vec3 uintBitsToFloat(const uvec3 value){ return vec3(uintBitsToFloat(value.x), uintBitsToFloat(value.y), uintBitsToFloat(value.z)); }
+    GLIC_CONSTEXPR20 vec4 uintBitsToFloat(const uvec4 value){ return vec4(uintBitsToFloat(value.x), uintBitsToFloat(value.y), uintBitsToFloat(value.z), uintBitsToFloat(value.w)); }
+
+    // packing
+    // two halves in one uint, x in the low 16 bits (see half.h for the rounding)
+
+    inline std::uint32_t packHalf2x16(const vec2 v){ return static_cast<std::uint32_t>(half(v.x).bits) | (static_cast<std::uint32_t>(half(v.y).bits) << 16); }
+    inline vec2 unpackHalf2x16(const std::uint32_t v){ return vec2(half::from_bits(static_cast<std::uint16_t>(v & 0xffffu)), half::from_bits(static_cast<std::uint16_t>(v >> 16))); }
 };
 #endif
\ No newline at end of file
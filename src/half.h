@@ -0,0 +1,190 @@
+#ifndef GLIC_HALF_HEADER
+#define GLIC_HALF_HEADER
+
+#include <cstdint>
+#include "approx.h"
+#include "vec.h"
+
+// half precision (IEEE binary16) storage: half, f16vec2, f16vec3 and f16vec4 hold 16 bit floats for buffers where memory
+// bandwidth, not arithmetic, is the limit (normals, colors, blend weights), and widen to float / vecN for all the math
+// widening is exact and implicit, narrowing rounds to nearest even and is explicit: f16vec3(n), then vec3 v = h;
+// out of range values become inf, small ones become half denormals or zero, and nans stay nans (quieted, top payload bits kept)
+//
+// the conversions use the F16C instructions when the compiler targets them (-mf16c or -march=native on gcc and clang,
+// /arch:AVX2 on msvc, or the GLIC_F16C cmake option)
+// and a bit exact integer version otherwise, so results do not depend on which one was compiled in
+// batch::to_half and batch::to_float (batch.h) convert whole buffers, lazy::ref and lazy::into (lazy.h) read and write f16 buffers
+// inside a fused expression
+
+#if defined(__F16C__) || (defined(_MSC_VER) && defined(__AVX2__))
+    #define GLIC_HALF_F16C
+    #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    // no F16C: f16vec4 runs the integer version on four lanes at once
+    #define GLIC_HALF_SSE2
+    #include <emmintrin.h>
+#endif
+
+namespace glic {
+    namespace detail {
+        // a where condition holds, b otherwise, as integer masks like approx::detail::select so the choice never becomes a branch
+        inline std::uint32_t select_bits(const bool condition, const std::uint32_t a, const std::uint32_t b){
+            const std::uint32_t mask = 0u - static_cast<std::uint32_t>(condition);
+            return (a & mask) | (b & ~mask);
+        }
+
+        inline std::uint16_t half_from_float(const float value){
+            #if defined(GLIC_HALF_F16C)
+                return static_cast<std::uint16_t>(_cvtss_sh(value, 0));
+            #else
+                // every case is computed and the right one picked without branching, so loops over buffers vectorize
+                const std::uint32_t u = approx::detail::bits(value) & 0x7fffffffu;
+                const std::uint32_t sign = (approx::detail::bits(value) >> 16) & 0x8000u;
+                const std::int32_t magnitude = static_cast<std::int32_t>(u);
+
+                // inf and nan (a nan keeps the top ten payload bits and gets the quiet bit, like the hardware conversion)
+                const std::uint32_t special = 0x7c00u | select_bits(magnitude > 0x7f800000, 0x200u | ((u >> 13) & 0x3ffu), 0u);
+
+                // below the smallest normal half (2^-14): adding 0.5 lines the denormal mantissa up with the low float mantissa
+                // bits, and the float addition does the round to nearest even (denormal float inputs are below half a half denormal,
+                // so flushing them to zero does not change the result)
+                const std::uint32_t denormal = approx::detail::bits(approx::detail::from_bits(u) + 0.5f) - 0x3f000000u;
+
+                // normal: rebias the exponent and round the 13 dropped mantissa bits to nearest even, a carry out of the
+                // mantissa correctly bumps the exponent (and 65520 and up carries into inf)
+                const std::uint32_t normal = (u - 0x38000000u + 0xfffu + ((u >> 13) & 1u)) >> 13;
+
+                std::uint32_t result = select_bits(magnitude < 0x38800000, denormal, normal);
+                result = select_bits(magnitude >= 0x477ff000, 0x7c00u, result);
+                result = select_bits(magnitude >= 0x7f800000, special, result);
+                return static_cast<std::uint16_t>(sign | result);
+            #endif
+        }
+
+        inline float float_from_half(const std::uint16_t value){
+            #if defined(GLIC_HALF_F16C)
+                return _cvtsh_ss(value);
+            #else
+                const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+                const std::uint32_t exponent = value & 0x7c00u, magnitude = static_cast<std::uint32_t>(value & 0x7fffu) << 13;
+
+                // inf and nan, a signaling nan is quieted like the hardware conversion
+                const std::uint32_t special = magnitude | 0x7f800000u | select_bits((magnitude & 0x7fffffu) != 0u, 0x400000u, 0u);
+
+                // zero and denormals are mantissa * 2^-24, which is (0.5 + mantissa * 2^-24) - 0.5 exactly, the reverse of the trick above
+                // (and a normal float, so it survives flush to zero)
+                const std::uint32_t denormal = approx::detail::bits(approx::detail::from_bits(0x3f000000u | (value & 0x3ffu)) - 0.5f);
+
+                const std::uint32_t normal = magnitude + 0x38000000u;
+
+                std::uint32_t result = select_bits(exponent == 0u, denormal, normal);
+                result = select_bits(exponent == 0x7c00u, special, result);
+                return approx::detail::from_bits(sign | result);
+            #endif
+        }
+    };
+
+    #if defined(GLIC_HALF_SSE2)
+        namespace detail {
+            inline __m128i select_bits(const __m128i condition, const __m128i a, const __m128i b){ return _mm_or_si128(_mm_and_si128(condition, a), _mm_andnot_si128(condition, b)); }
+
+            // half_from_float and float_from_half above, lane for lane (every magnitude fits a signed compare)
+
+            inline void half4_from_float4(const float* in, void* out){
+                const __m128i value = _mm_castps_si128(_mm_loadu_ps(in));
+                const __m128i u = _mm_and_si128(value, _mm_set1_epi32(0x7fffffff));
+                const __m128i sign = _mm_and_si128(_mm_srli_epi32(value, 16), _mm_set1_epi32(0x8000));
+                const __m128i top = _mm_srli_epi32(u, 13);
+
+                const __m128i payload = _mm_and_si128(_mm_cmpgt_epi32(u, _mm_set1_epi32(0x7f800000)), _mm_or_si128(_mm_set1_epi32(0x200), _mm_and_si128(top, _mm_set1_epi32(0x3ff))));
+                const __m128i special = _mm_or_si128(_mm_set1_epi32(0x7c00), payload);
+                const __m128i denormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(u), _mm_set1_ps(0.5f))), _mm_set1_epi32(0x3f000000));
+                const __m128i normal = _mm_srli_epi32(_mm_add_epi32(_mm_add_epi32(u, _mm_set1_epi32(0xfff - 0x38000000)), _mm_and_si128(top, _mm_set1_epi32(1))), 13);
+
+                __m128i result = select_bits(_mm_cmplt_epi32(u, _mm_set1_epi32(0x38800000)), denormal, normal);
+                result = select_bits(_mm_cmpgt_epi32(u, _mm_set1_epi32(0x477fefff)), _mm_set1_epi32(0x7c00), result);
+                result = select_bits(_mm_cmpgt_epi32(u, _mm_set1_epi32(0x7f7fffff)), special, result);
+                result = _mm_or_si128(result, sign);
+
+                // sign extend the low 16 bits so the saturating pack keeps them as they are
+                result = _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+                _mm_storel_epi64(static_cast<__m128i*>(out), _mm_packs_epi32(result, result));
+            }
+
+            inline void float4_from_half4(const void* in, float* out){
+                const __m128i value = _mm_unpacklo_epi16(_mm_loadl_epi64(static_cast<const __m128i*>(in)), _mm_setzero_si128());
+                const __m128i sign = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x8000)), 16);
+                const __m128i exponent = _mm_and_si128(value, _mm_set1_epi32(0x7c00));
+                const __m128i magnitude = _mm_slli_epi32(_mm_and_si128(value, _mm_set1_epi32(0x7fff)), 13);
+
+                const __m128i quiet = _mm_andnot_si128(_mm_cmpeq_epi32(_mm_and_si128(value, _mm_set1_epi32(0x3ff)), _mm_setzero_si128()), _mm_set1_epi32(0x400000));
+                const __m128i special = _mm_or_si128(_mm_or_si128(magnitude, _mm_set1_epi32(0x7f800000)), quiet);
+                const __m128i denormal = _mm_castps_si128(_mm_sub_ps(_mm_castsi128_ps(_mm_or_si128(_mm_and_si128(value, _mm_set1_epi32(0x3ff)), _mm_set1_epi32(0x3f000000))), _mm_set1_ps(0.5f)));
+                const __m128i normal = _mm_add_epi32(magnitude, _mm_set1_epi32(0x38000000));
+
+                __m128i result = select_bits(_mm_cmpeq_epi32(exponent, _mm_setzero_si128()), denormal, normal);
+                result = select_bits(_mm_cmpeq_epi32(exponent, _mm_set1_epi32(0x7c00)), special, result);
+                _mm_storeu_ps(out, _mm_castsi128_ps(_mm_or_si128(result, sign)));
+            }
+        };
+    #endif
+
+    // a 16 bit float, for storage only
+    struct half {
+        std::uint16_t bits;
+
+        half() : bits(0) {}
+        explicit half(const float value) : bits(detail::half_from_float(value)) {}
+
+        operator float() const { return detail::float_from_half(bits); }
+
+        static half from_bits(const std::uint16_t bits){ half h; h.bits = bits; return h; }
+    };
+
+    // half vectors are tightly packed (f16vec3 is 6 bytes, even under GLIC_SIMD)
+
+    struct f16vec2 {
+        half x, y;
+
+        f16vec2() {}
+        f16vec2(const half x, const half y) : x(x), y(y) {}
+        explicit f16vec2(const vec2& v) : x(v.x), y(v.y) {}
+
+        operator vec2() const { return vec2(x, y); }
+    };
+
+    struct f16vec3 {
+        half x, y, z;
+
+        f16vec3() {}
+        f16vec3(const half x, const half y, const half z) : x(x), y(y), z(z) {}
+        explicit f16vec3(const vec3& v) : x(v.x), y(v.y), z(v.z) {}
+
+        operator vec3() const { return vec3(x, y, z); }
+    };
+
+    struct f16vec4 {
+        half x, y, z, w;
+
+        f16vec4() {}
+        f16vec4(const half x, const half y, const half z, const half w) : x(x), y(y), z(z), w(w) {}
+
+        #if defined(GLIC_HALF_F16C)
+            // all four lanes in one instruction each way
+            explicit f16vec4(const vec4& v){ _mm_storel_epi64(reinterpret_cast<__m128i*>(&x), _mm_cvtps_ph(_mm_loadu_ps(&v.x), 0)); }
+
+            operator vec4() const { vec4 v; _mm_storeu_ps(&v.x, _mm_cvtph_ps(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&x)))); return v; }
+        #elif defined(GLIC_HALF_SSE2)
+            explicit f16vec4(const vec4& v){ detail::half4_from_float4(&v.x, &x); }
+
+            operator vec4() const { vec4 v; detail::float4_from_half4(&x, &v.x); return v; }
+        #else
+            explicit f16vec4(const vec4& v) : x(v.x), y(v.y), z(v.z), w(v.w) {}
+
+            operator vec4() const { return vec4(x, y, z, w); }
+        #endif
+    };
+
+    static_assert(sizeof(f16vec2) == 4 && sizeof(f16vec3) == 6 && sizeof(f16vec4) == 8, "half vectors are packed halves");
+};
+#endif
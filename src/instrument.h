@@ -0,0 +1,195 @@
+#ifndef GLIC_INSTRUMENT_HEADER
+#define GLIC_INSTRUMENT_HEADER
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+#include "vec.h"
+
+// opt in counters for the numeric builtins of glic.h, to find where a shader makes denormals, nans and infs
+// define GLIC_INSTRUMENT in every translation unit (the GLIC_INSTRUMENT cmake option does) and every call of a
+// trigonometry, exponential, common or geometric builtin counts, for that builtin:
+//   calls             calls made by the program; builtins that call other builtins count only the outer call
+//   denormal_inputs   argument components that are denormal
+//   denormal_outputs  result components that are denormal
+//   nans, infs        result components that are nan (inf) when no argument component was nan (nan or inf), so each is
+//                     counted where it is made rather than everywhere it flows through
+// the counters are per thread and only ever written by their own thread, so a call costs a handful of uncontended relaxed
+// stores; instrument::report() sums every thread (including ones that have exited) and prints a table
+// without GLIC_INSTRUMENT the builtins contain no counting code at all and the report is empty
+
+namespace glic {
+    namespace instrument {
+        enum class builtin {
+            radians, degrees, sin, cos, tan, asin, acos, atan,
+            pow, exp, log, exp2, log2, sqrt, inversesqrt,
+            abs, sign, floor, ceil, fract, mod, min, max, clamp, mix, step, smoothstep,
+            length, distance, dot, cross, normalize, faceforward, reflect, refract,
+            count
+        };
+
+        inline const char* name(const builtin b){
+            static const char* const names[] = {
+                "radians", "degrees", "sin", "cos", "tan", "asin", "acos", "atan",
+                "pow", "exp", "log", "exp2", "log2", "sqrt", "inversesqrt",
+                "abs", "sign", "floor", "ceil", "fract", "mod", "min", "max", "clamp", "mix", "step", "smoothstep",
+                "length", "distance", "dot", "cross", "normalize", "faceforward", "reflect", "refract"
+            };
+            return names[static_cast<int>(b)];
+        }
+
+        struct counters {
+            std::uint64_t calls = 0;
+            std::uint64_t denormal_inputs = 0;
+            std::uint64_t denormal_outputs = 0;
+            std::uint64_t nans = 0;
+            std::uint64_t infs = 0;
+        };
+
+        namespace detail {
+            constexpr int builtins = static_cast<int>(builtin::count);
+
+            // one thread's counters, atomics only so the report can read them while the thread runs
+            struct thread_counters {
+                std::atomic<std::uint64_t> values[builtins][5];
+
+                thread_counters(){ for(auto& row : values){ for(auto& v : row){ v.store(0, std::memory_order_relaxed); } } }
+
+                void add(const int b, const int field, const std::uint64_t n){
+                    if(n){ values[b][field].store(values[b][field].load(std::memory_order_relaxed) + n, std::memory_order_relaxed); }
+                }
+            };
+
+            // every live thread's counters, plus the totals of threads that have exited
+            struct registry {
+                std::mutex lock;
+                std::vector<thread_counters*> live;
+                std::uint64_t retired[builtins][5] = {};
+
+                static registry& get(){ static registry r; return r; }
+            };
+
+            struct thread_slot {
+                thread_counters counters;
+                int depth = 0;
+
+                thread_slot(){
+                    registry& r = registry::get();
+                    std::lock_guard<std::mutex> guard(r.lock);
+                    r.live.push_back(&counters);
+                }
+
+                ~thread_slot(){
+                    registry& r = registry::get();
+                    std::lock_guard<std::mutex> guard(r.lock);
+                    for(int b = 0; b < builtins; ++b){
+                        for(int f = 0; f < 5; ++f){ r.retired[b][f] += counters.values[b][f].load(std::memory_order_relaxed); }
+                    }
+                    for(auto it = r.live.begin(); it != r.live.end(); ++it){
+                        if(*it == &counters){ r.live.erase(it); break; }
+                    }
+                }
+            };
+
+            inline thread_slot& slot(){ thread_local thread_slot s; return s; }
+
+            // per component classification of an argument or result
+            struct tally {
+                std::uint64_t denormal = 0, nan = 0, inf = 0;
+
+                void add(const float v){
+                    const int kind = std::fpclassify(v);
+                    denormal += kind == FP_SUBNORMAL;
+                    nan += kind == FP_NAN;
+                    inf += kind == FP_INFINITE;
+                }
+                void add(const vec2& v){ add(v.x); add(v.y); }
+                void add(const vec3& v){ add(v.x); add(v.y); add(v.z); }
+                void add(const vec4& v){ add(v.x); add(v.y); add(v.z); add(v.w); }
+
+                // precision tags and other non float arguments are not inspected
+                template <typename T> void add(const T&) {}
+            };
+
+            // runs a builtin body and, for the outermost builtin on this thread, records it
+            template <typename F, typename... A> auto counted(const builtin b, const F& body, const A&... args){
+                thread_slot& s = slot();
+                ++s.depth;
+                const auto result = body();
+                if(--s.depth == 0){
+                    tally in, out;
+                    (in.add(args), ...);
+                    out.add(result);
+
+                    const int i = static_cast<int>(b);
+                    s.counters.add(i, 0, 1);
+                    s.counters.add(i, 1, in.denormal);
+                    s.counters.add(i, 2, out.denormal);
+                    if(!in.nan){ s.counters.add(i, 3, out.nan); }
+                    if(!in.nan && !in.inf){ s.counters.add(i, 4, out.inf); }
+                }
+                return result;
+            }
+        };
+
+        // totals over every thread, indexed by builtin
+        inline std::vector<counters> snapshot(){
+            detail::registry& r = detail::registry::get();
+            std::lock_guard<std::mutex> guard(r.lock);
+
+            std::uint64_t totals[detail::builtins][5];
+            for(int b = 0; b < detail::builtins; ++b){
+                for(int f = 0; f < 5; ++f){
+                    totals[b][f] = r.retired[b][f];
+                    for(const detail::thread_counters* t : r.live){ totals[b][f] += t->values[b][f].load(std::memory_order_relaxed); }
+                }
+            }
+
+            std::vector<counters> result(detail::builtins);
+            for(int b = 0; b < detail::builtins; ++b){
+                result[b].calls = totals[b][0];
+                result[b].denormal_inputs = totals[b][1];
+                result[b].denormal_outputs = totals[b][2];
+                result[b].nans = totals[b][3];
+                result[b].infs = totals[b][4];
+            }
+            return result;
+        }
+
+        // zeroes every thread's counters, meant for between frames rather than while builtins run on other threads
+        inline void reset(){
+            detail::registry& r = detail::registry::get();
+            std::lock_guard<std::mutex> guard(r.lock);
+            for(auto& row : r.retired){ for(auto& v : row){ v = 0; } }
+            for(detail::thread_counters* t : r.live){ for(auto& row : t->values){ for(auto& v : row){ v.store(0, std::memory_order_relaxed); } } }
+        }
+
+        // one line per builtin that was called
+        inline void report(std::FILE* out = stdout){
+            const std::vector<counters> totals = snapshot();
+            std::fprintf(out, "%-14s %14s %16s %16s %12s %12s\n", "builtin", "calls", "denormal in", "denormal out", "nan", "inf");
+            for(int b = 0; b < detail::builtins; ++b){
+                const counters& c = totals[b];
+                if(!c.calls){ continue; }
+                std::fprintf(out, "%-14s %14llu %16llu %16llu %12llu %12llu\n", name(static_cast<builtin>(b)),
+                    static_cast<unsigned long long>(c.calls), static_cast<unsigned long long>(c.denormal_inputs),
+                    static_cast<unsigned long long>(c.denormal_outputs), static_cast<unsigned long long>(c.nans), static_cast<unsigned long long>(c.infs));
+            }
+        }
+    };
+};
+
+// wraps the body of a builtin: GLIC_COUNTED(sin, std::sin(angle), angle) is just std::sin(angle) unless GLIC_INSTRUMENT is defined
+// constant evaluation (c++20) does not count, in c++17 an instrumented build has no constexpr builtins (see constant.h)
+#if defined(GLIC_INSTRUMENT) && defined(GLIC_CONSTEXPR_MATH)
+    #define GLIC_COUNTED(name, expression, ...) (std::is_constant_evaluated() ? (expression) : glic::instrument::detail::counted(glic::instrument::builtin::name, [&](){ return expression; }, __VA_ARGS__))
+#elif defined(GLIC_INSTRUMENT)
+    #define GLIC_COUNTED(name, expression, ...) glic::instrument::detail::counted(glic::instrument::builtin::name, [&](){ return expression; }, __VA_ARGS__)
+#else
+    #define GLIC_COUNTED(name, expression, ...) (expression)
+#endif
+
+#endif
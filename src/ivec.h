@@ -0,0 +1,325 @@
+#ifndef GLIC_IVEC_HEADER
+#define GLIC_IVEC_HEADER
+
+#include <cstdint>
+#include <type_traits>
+#include "vec.h"
+
+// integer and bool vectors: ivecN holds 32 bit ints, uvecN 32 bit unsigned ints and bvecN bools, as in GLSL
+// they share one template per size, tvecN<T>; arithmetic and bit operators only make sense (and only compile) for the
+// integer ones, bvecN is built by the comparison builtins in glic.h and consumed by any, all, not_, select and mix
+// conversions between vector kinds are explicit like GLSL constructors: ivec2(v) truncates a vec2, vec2(i) widens an ivec2
+// everything here is constexpr
+// left shifts run on the unsigned bits, so a negative ivec shifts like GLSL's two's complement ints instead of being
+// undefined in c++17; >> on a negative ivec is arithmetic, % truncates towards zero like c++ (GLSL leaves both open)
+
+namespace glic {
+    namespace detail {
+        template <typename T> constexpr T shift_left(const T x, const int s){ return static_cast<T>(static_cast<typename std::make_unsigned<T>::type>(x) << s); }
+    };
+
+    template <typename T> struct tvec2 {
+        typedef T value_type;
+
+        T x, y;
+
+        constexpr tvec2() : x(), y() {}
+        constexpr tvec2(T x) : x(x), y(x) {}
+        constexpr tvec2(T x, T y) : x(x), y(y) {}
+
+        template <typename U> constexpr explicit tvec2(const tvec2<U>& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)) {}
+        constexpr explicit tvec2(const vec2& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)) {}
+
+        // helpers, the result takes the type function returns so comparisons give a bvec2
+        template <typename F> constexpr auto apply(const F& function) const -> tvec2<decltype(function(x))> { return tvec2<decltype(function(x))>(function(x), function(y)); }
+        template <typename F> static constexpr auto zip(const F& function, const tvec2& x, const tvec2& y) -> tvec2<decltype(function(x.x, y.x))> {
+            return tvec2<decltype(function(x.x, y.x))>(function(x.x, y.x), function(x.y, y.y));
+        }
+
+        // overloads
+        constexpr tvec2& operator +=(const T v){ x += v; y += v; return *this; }
+        constexpr tvec2& operator +=(const tvec2& v){ x += v.x; y += v.y; return *this; }
+
+        constexpr tvec2& operator -=(const T v){ x -= v; y -= v; return *this; }
+        constexpr tvec2& operator -=(const tvec2& v){ x -= v.x; y -= v.y; return *this; }
+
+        constexpr tvec2& operator *=(const T v){ x *= v; y *= v; return *this; }
+        constexpr tvec2& operator *=(const tvec2& v){ x *= v.x; y *= v.y; return *this; }
+
+        constexpr tvec2& operator /=(const T v){ x /= v; y /= v; return *this; }
+        constexpr tvec2& operator /=(const tvec2& v){ x /= v.x; y /= v.y; return *this; }
+
+        constexpr tvec2& operator %=(const T v){ x %= v; y %= v; return *this; }
+        constexpr tvec2& operator %=(const tvec2& v){ x %= v.x; y %= v.y; return *this; }
+
+        constexpr tvec2& operator &=(const T v){ x &= v; y &= v; return *this; }
+        constexpr tvec2& operator &=(const tvec2& v){ x &= v.x; y &= v.y; return *this; }
+
+        constexpr tvec2& operator |=(const T v){ x |= v; y |= v; return *this; }
+        constexpr tvec2& operator |=(const tvec2& v){ x |= v.x; y |= v.y; return *this; }
+
+        constexpr tvec2& operator ^=(const T v){ x ^= v; y ^= v; return *this; }
+        constexpr tvec2& operator ^=(const tvec2& v){ x ^= v.x; y ^= v.y; return *this; }
+
+        constexpr tvec2& operator <<=(const int v){ x = detail::shift_left(x, v); y = detail::shift_left(y, v); return *this; }
+        constexpr tvec2& operator <<=(const tvec2& v){ x = detail::shift_left(x, v.x); y = detail::shift_left(y, v.y); return *this; }
+
+        constexpr tvec2& operator >>=(const int v){ x >>= v; y >>= v; return *this; }
+        constexpr tvec2& operator >>=(const tvec2& v){ x >>= v.x; y >>= v.y; return *this; }
+
+        constexpr tvec2 operator +(const T v) const { tvec2 self(*this); self += v; return self; }
+        constexpr tvec2 operator +(const tvec2& v) const { tvec2 self(*this); self += v; return self; }
+
+        constexpr tvec2 operator -(const T v) const { tvec2 self(*this); self -= v; return self; }
+        constexpr tvec2 operator -(const tvec2& v) const { tvec2 self(*this); self -= v; return self; }
+
+        constexpr tvec2 operator *(const T v) const { tvec2 self(*this); self *= v; return self; }
+        constexpr tvec2 operator *(const tvec2& v) const { tvec2 self(*this); self *= v; return self; }
+
+        constexpr tvec2 operator /(const T v) const { tvec2 self(*this); self /= v; return self; }
+        constexpr tvec2 operator /(const tvec2& v) const { tvec2 self(*this); self /= v; return self; }
+
+        constexpr tvec2 operator %(const T v) const { tvec2 self(*this); self %= v; return self; }
+        constexpr tvec2 operator %(const tvec2& v) const { tvec2 self(*this); self %= v; return self; }
+
+        constexpr tvec2 operator &(const T v) const { tvec2 self(*this); self &= v; return self; }
+        constexpr tvec2 operator &(const tvec2& v) const { tvec2 self(*this); self &= v; return self; }
+
+        constexpr tvec2 operator |(const T v) const { tvec2 self(*this); self |= v; return self; }
+        constexpr tvec2 operator |(const tvec2& v) const { tvec2 self(*this); self |= v; return self; }
+
+        constexpr tvec2 operator ^(const T v) const { tvec2 self(*this); self ^= v; return self; }
+        constexpr tvec2 operator ^(const tvec2& v) const { tvec2 self(*this); self ^= v; return self; }
+
+        constexpr tvec2 operator <<(const int v) const { tvec2 self(*this); self <<= v; return self; }
+        constexpr tvec2 operator <<(const tvec2& v) const { tvec2 self(*this); self <<= v; return self; }
+
+        constexpr tvec2 operator >>(const int v) const { tvec2 self(*this); self >>= v; return self; }
+        constexpr tvec2 operator >>(const tvec2& v) const { tvec2 self(*this); self >>= v; return self; }
+
+        constexpr tvec2& operator++(){ return *this += T(1); }
+        constexpr tvec2 operator++(int){ tvec2 copy(*this); *this += T(1); return copy; }
+        constexpr tvec2& operator--(){ return *this -= T(1); }
+        constexpr tvec2 operator--(int){ tvec2 copy(*this); *this -= T(1); return copy; }
+
+        constexpr tvec2 operator -() const { return tvec2(-x, -y); }
+        constexpr tvec2 operator ~() const { return tvec2(~x, ~y); }
+    };
+
+    template <typename T> constexpr tvec2<T> operator +(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) += vec; }
+    template <typename T> constexpr tvec2<T> operator -(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) -= vec; }
+    template <typename T> constexpr tvec2<T> operator *(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) *= vec; }
+    template <typename T> constexpr tvec2<T> operator /(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) /= vec; }
+    template <typename T> constexpr tvec2<T> operator %(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) %= vec; }
+    template <typename T> constexpr tvec2<T> operator &(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) &= vec; }
+    template <typename T> constexpr tvec2<T> operator |(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) |= vec; }
+    template <typename T> constexpr tvec2<T> operator ^(const typename tvec2<T>::value_type v, const tvec2<T>& vec){ return tvec2<T>(v) ^= vec; }
+
+    template <typename T> struct tvec3 {
+        typedef T value_type;
+
+        T x, y, z;
+
+        constexpr tvec3() : x(), y(), z() {}
+        constexpr tvec3(T x) : x(x), y(x), z(x) {}
+        constexpr tvec3(T x, T y, T z) : x(x), y(y), z(z) {}
+
+        template <typename U> constexpr explicit tvec3(const tvec3<U>& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)) {}
+        constexpr explicit tvec3(const vec3& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)) {}
+
+        // helpers
+        template <typename F> constexpr auto apply(const F& function) const -> tvec3<decltype(function(x))> { return tvec3<decltype(function(x))>(function(x), function(y), function(z)); }
+        template <typename F> static constexpr auto zip(const F& function, const tvec3& x, const tvec3& y) -> tvec3<decltype(function(x.x, y.x))> {
+            return tvec3<decltype(function(x.x, y.x))>(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z));
+        }
+
+        // overloads
+        constexpr tvec3& operator +=(const T v){ x += v; y += v; z += v; return *this; }
+        constexpr tvec3& operator +=(const tvec3& v){ x += v.x; y += v.y; z += v.z; return *this; }
+
+        constexpr tvec3& operator -=(const T v){ x -= v; y -= v; z -= v; return *this; }
+        constexpr tvec3& operator -=(const tvec3& v){ x -= v.x; y -= v.y; z -= v.z; return *this; }
+
+        constexpr tvec3& operator *=(const T v){ x *= v; y *= v; z *= v; return *this; }
+        constexpr tvec3& operator *=(const tvec3& v){ x *= v.x; y *= v.y; z *= v.z; return *this; }
+
+        constexpr tvec3& operator /=(const T v){ x /= v; y /= v; z /= v; return *this; }
+        constexpr tvec3& operator /=(const tvec3& v){ x /= v.x; y /= v.y; z /= v.z; return *this; }
+
+        constexpr tvec3& operator %=(const T v){ x %= v; y %= v; z %= v; return *this; }
+        constexpr tvec3& operator %=(const tvec3& v){ x %= v.x; y %= v.y; z %= v.z; return *this; }
+
+        constexpr tvec3& operator &=(const T v){ x &= v; y &= v; z &= v; return *this; }
+        constexpr tvec3& operator &=(const tvec3& v){ x &= v.x; y &= v.y; z &= v.z; return *this; }
+
+        constexpr tvec3& operator |=(const T v){ x |= v; y |= v; z |= v; return *this; }
+        constexpr tvec3& operator |=(const tvec3& v){ x |= v.x; y |= v.y; z |= v.z; return *this; }
+
+        constexpr tvec3& operator ^=(const T v){ x ^= v; y ^= v; z ^= v; return *this; }
+        constexpr tvec3& operator ^=(const tvec3& v){ x ^= v.x; y ^= v.y; z ^= v.z; return *this; }
+
+        constexpr tvec3& operator <<=(const int v){ x = detail::shift_left(x, v); y = detail::shift_left(y, v); z = detail::shift_left(z, v); return *this; }
+        constexpr tvec3& operator <<=(const tvec3& v){ x = detail::shift_left(x, v.x); y = detail::shift_left(y, v.y); z = detail::shift_left(z, v.z); return *this; }
+
+        constexpr tvec3& operator >>=(const int v){ x >>= v; y >>= v; z >>= v; return *this; }
+        constexpr tvec3& operator >>=(const tvec3& v){ x >>= v.x; y >>= v.y; z >>= v.z; return *this; }
+
+        constexpr tvec3 operator +(const T v) const { tvec3 self(*this); self += v; return self; }
+        constexpr tvec3 operator +(const tvec3& v) const { tvec3 self(*this); self += v; return self; }
+
+        constexpr tvec3 operator -(const T v) const { tvec3 self(*this); self -= v; return self; }
+        constexpr tvec3 operator -(const tvec3& v) const { tvec3 self(*this); self -= v; return self; }
+
+        constexpr tvec3 operator *(const T v) const { tvec3 self(*this); self *= v; return self; }
+        constexpr tvec3 operator *(const tvec3& v) const { tvec3 self(*this); self *= v; return self; }
+
+        constexpr tvec3 operator /(const T v) const { tvec3 self(*this); self /= v; return self; }
+        constexpr tvec3 operator /(const tvec3& v) const { tvec3 self(*this); self /= v; return self; }
+
+        constexpr tvec3 operator %(const T v) const { tvec3 self(*this); self %= v; return self; }
+        constexpr tvec3 operator %(const tvec3& v) const { tvec3 self(*this); self %= v; return self; }
+
+        constexpr tvec3 operator &(const T v) const { tvec3 self(*this); self &= v; return self; }
+        constexpr tvec3 operator &(const tvec3& v) const { tvec3 self(*this); self &= v; return self; }
+
+        constexpr tvec3 operator |(const T v) const { tvec3 self(*this); self |= v; return self; }
+        constexpr tvec3 operator |(const tvec3& v) const { tvec3 self(*this); self |= v; return self; }
+
+        constexpr tvec3 operator ^(const T v) const { tvec3 self(*this); self ^= v; return self; }
+        constexpr tvec3 operator ^(const tvec3& v) const { tvec3 self(*this); self ^= v; return self; }
+
+        constexpr tvec3 operator <<(const int v) const { tvec3 self(*this); self <<= v; return self; }
+        constexpr tvec3 operator <<(const tvec3& v) const { tvec3 self(*this); self <<= v; return self; }
+
+        constexpr tvec3 operator >>(const int v) const { tvec3 self(*this); self >>= v; return self; }
+        constexpr tvec3 operator >>(const tvec3& v) const { tvec3 self(*this); self >>= v; return self; }
+
+        constexpr tvec3& operator++(){ return *this += T(1); }
+        constexpr tvec3 operator++(int){ tvec3 copy(*this); *this += T(1); return copy; }
+        constexpr tvec3& operator--(){ return *this -= T(1); }
+        constexpr tvec3 operator--(int){ tvec3 copy(*this); *this -= T(1); return copy; }
+
+        constexpr tvec3 operator -() const { return tvec3(-x, -y, -z); }
+        constexpr tvec3 operator ~() const { return tvec3(~x, ~y, ~z); }
+    };
+
+    template <typename T> constexpr tvec3<T> operator +(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) += vec; }
+    template <typename T> constexpr tvec3<T> operator -(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) -= vec; }
+    template <typename T> constexpr tvec3<T> operator *(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) *= vec; }
+    template <typename T> constexpr tvec3<T> operator /(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) /= vec; }
+    template <typename T> constexpr tvec3<T> operator %(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) %= vec; }
+    template <typename T> constexpr tvec3<T> operator &(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) &= vec; }
+    template <typename T> constexpr tvec3<T> operator |(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) |= vec; }
+    template <typename T> constexpr tvec3<T> operator ^(const typename tvec3<T>::value_type v, const tvec3<T>& vec){ return tvec3<T>(v) ^= vec; }
+
+    template <typename T> struct tvec4 {
+        typedef T value_type;
+
+        T x, y, z, w;
+
+        constexpr tvec4() : x(), y(), z(), w() {}
+        constexpr tvec4(T x) : x(x), y(x), z(x), w(x) {}
+        constexpr tvec4(T x, T y, T z, T w) : x(x), y(y), z(z), w(w) {}
+
+        template <typename U> constexpr explicit tvec4(const tvec4<U>& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)), w(static_cast<T>(v.w)) {}
+        constexpr explicit tvec4(const vec4& v) : x(static_cast<T>(v.x)), y(static_cast<T>(v.y)), z(static_cast<T>(v.z)), w(static_cast<T>(v.w)) {}
+
+        // helpers
+        template <typename F> constexpr auto apply(const F& function) const -> tvec4<decltype(function(x))> { return tvec4<decltype(function(x))>(function(x), function(y), function(z), function(w)); }
+        template <typename F> static constexpr auto zip(const F& function, const tvec4& x, const tvec4& y) -> tvec4<decltype(function(x.x, y.x))> {
+            return tvec4<decltype(function(x.x, y.x))>(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z), function(x.w, y.w));
+        }
+
+        // overloads
+        constexpr tvec4& operator +=(const T v){ x += v; y += v; z += v; w += v; return *this; }
+        constexpr tvec4& operator +=(const tvec4& v){ x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
+
+        constexpr tvec4& operator -=(const T v){ x -= v; y -= v; z -= v; w -= v; return *this; }
+        constexpr tvec4& operator -=(const tvec4& v){ x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
+
+        constexpr tvec4& operator *=(const T v){ x *= v; y *= v; z *= v; w *= v; return *this; }
+        constexpr tvec4& operator *=(const tvec4& v){ x *= v.x; y *= v.y; z *= v.z; w *= v.w; return *this; }
+
+        constexpr tvec4& operator /=(const T v){ x /= v; y /= v; z /= v; w /= v; return *this; }
+        constexpr tvec4& operator /=(const tvec4& v){ x /= v.x; y /= v.y; z /= v.z; w /= v.w; return *this; }
+
+        constexpr tvec4& operator %=(const T v){ x %= v; y %= v; z %= v; w %= v; return *this; }
+        constexpr tvec4& operator %=(const tvec4& v){ x %= v.x; y %= v.y; z %= v.z; w %= v.w; return *this; }
+
+        constexpr tvec4& operator &=(const T v){ x &= v; y &= v; z &= v; w &= v; return *this; }
+        constexpr tvec4& operator &=(const tvec4& v){ x &= v.x; y &= v.y; z &= v.z; w &= v.w; return *this; }
+
+        constexpr tvec4& operator |=(const T v){ x |= v; y |= v; z |= v; w |= v; return *this; }
+        constexpr tvec4& operator |=(const tvec4& v){ x |= v.x; y |= v.y; z |= v.z; w |= v.w; return *this; }
+
+        constexpr tvec4& operator ^=(const T v){ x ^= v; y ^= v; z ^= v; w ^= v; return *this; }
+        constexpr tvec4& operator ^=(const tvec4& v){ x ^= v.x; y ^= v.y; z ^= v.z; w ^= v.w; return *this; }
+
+        constexpr tvec4& operator <<=(const int v){ x = detail::shift_left(x, v); y = detail::shift_left(y, v); z = detail::shift_left(z, v); w = detail::shift_left(w, v); return *this; }
+        constexpr tvec4& operator <<=(const tvec4& v){ x = detail::shift_left(x, v.x); y = detail::shift_left(y, v.y); z = detail::shift_left(z, v.z); w = detail::shift_left(w, v.w); return *this; }
+
+        constexpr tvec4& operator >>=(const int v){ x >>= v; y >>= v; z >>= v; w >>= v; return *this; }
+        constexpr tvec4& operator >>=(const tvec4& v){ x >>= v.x; y >>= v.y; z >>= v.z; w >>= v.w; return *this; }
+
+        constexpr tvec4 operator +(const T v) const { tvec4 self(*this); self += v; return self; }
+        constexpr tvec4 operator +(const tvec4& v) const { tvec4 self(*this); self += v; return self; }
+
+        constexpr tvec4 operator -(const T v) const { tvec4 self(*this); self -= v; return self; }
+        constexpr tvec4 operator -(const tvec4& v) const { tvec4 self(*this); self -= v; return self; }
+
+        constexpr tvec4 operator *(const T v) const { tvec4 self(*this); self *= v; return self; }
+        constexpr tvec4 operator *(const tvec4& v) const { tvec4 self(*this); self *= v; return self; }
+
+        constexpr tvec4 operator /(const T v) const { tvec4 self(*this); self /= v; return self; }
+        constexpr tvec4 operator /(const tvec4& v) const { tvec4 self(*this); self /= v; return self; }
+
+        constexpr tvec4 operator %(const T v) const { tvec4 self(*this); self %= v; return self; }
+        constexpr tvec4 operator %(const tvec4& v) const { tvec4 self(*this); self %= v; return self; }
+
+        constexpr tvec4 operator &(const T v) const { tvec4 self(*this); self &= v; return self; }
+        constexpr tvec4 operator &(const tvec4& v) const { tvec4 self(*this); self &= v; return self; }
+
+        constexpr tvec4 operator |(const T v) const { tvec4 self(*this); self |= v; return self; }
+        constexpr tvec4 operator |(const tvec4& v) const { tvec4 self(*this); self |= v; return self; }
+
+        constexpr tvec4 operator ^(const T v) const { tvec4 self(*this); self ^= v; return self; }
+        constexpr tvec4 operator ^(const tvec4& v) const { tvec4 self(*this); self ^= v; return self; }
+
+        constexpr tvec4 operator <<(const int v) const { tvec4 self(*this); self <<= v; return self; }
+        constexpr tvec4 operator <<(const tvec4& v) const { tvec4 self(*this); self <<= v; return self; }
+
+        constexpr tvec4 operator >>(const int v) const { tvec4 self(*this); self >>= v; return self; }
+        constexpr tvec4 operator >>(const tvec4& v) const { tvec4 self(*this); self >>= v; return self; }
+
+        constexpr tvec4& operator++(){ return *this += T(1); }
+        constexpr tvec4 operator++(int){ tvec4 copy(*this); *this += T(1); return copy; }
+        constexpr tvec4& operator--(){ return *this -= T(1); }
+        constexpr tvec4 operator--(int){ tvec4 copy(*this); *this -= T(1); return copy; }
+
+        constexpr tvec4 operator -() const { return tvec4(-x, -y, -z, -w); }
+        constexpr tvec4 operator ~() const { return tvec4(~x, ~y, ~z, ~w); }
+    };
+
+    template <typename T> constexpr tvec4<T> operator +(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) += vec; }
+    template <typename T> constexpr tvec4<T> operator -(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) -= vec; }
+    template <typename T> constexpr tvec4<T> operator *(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) *= vec; }
+    template <typename T> constexpr tvec4<T> operator /(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) /= vec; }
+    template <typename T> constexpr tvec4<T> operator %(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) %= vec; }
+    template <typename T> constexpr tvec4<T> operator &(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) &= vec; }
+    template <typename T> constexpr tvec4<T> operator |(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) |= vec; }
+    template <typename T> constexpr tvec4<T> operator ^(const typename tvec4<T>::value_type v, const tvec4<T>& vec){ return tvec4<T>(v) ^= vec; }
+
+    typedef tvec2<std::int32_t> ivec2;
+    typedef tvec3<std::int32_t> ivec3;
+    typedef tvec4<std::int32_t> ivec4;
+
+    typedef tvec2<std::uint32_t> uvec2;
+    typedef tvec3<std::uint32_t> uvec3;
+    typedef tvec4<std::uint32_t> uvec4;
+
+    typedef tvec2<bool> bvec2;
+    typedef tvec3<bool> bvec3;
+    typedef tvec4<bool> bvec4;
+};
+
+#endif
@@ -0,0 +1,210 @@
+#ifndef GLIC_LAZY_HEADER
+#define GLIC_LAZY_HEADER
+
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "batch.h"
+
+// lazily evaluated array expressions
+// the builtins and operators below only record what to compute; nothing runs until the expression is assigned to an output,
+// which then evaluates the whole tree element by element in one loop, so a chain of n builtins reads every input once and
+// writes the output once instead of making n passes over memory with n intermediate arrays:
+//
+//     lazy::into(out) = mix(lazy::ref(a), lazy::ref(b), smoothstep(0.0f, 1.0f, lazy::ref(x))) * k;
+//
+// any argument that is not an expression (a float, a vecN, a precision tag) is shared by every element, as a uniform
+// the output may be one of the inputs, since element i only ever reads element i
+// arrays of different lengths in one expression, or an output of another length, throw std::length_error before anything
+// is read, in release builds too
+// half precision buffers (half.h) are read as float / vecN and rounded back on assignment, which halves the bytes a
+// bandwidth bound expression moves
+
+namespace glic {
+    namespace lazy {
+        namespace detail {
+            // the type an array element is computed in: half storage widens to the float type it holds when read and is
+            // rounded back when written, so f16 buffers take part in expressions like any other
+            template <typename T> struct compute { typedef T type; };
+            template <> struct compute<half> { typedef float type; };
+            template <> struct compute<f16vec2> { typedef vec2 type; };
+            template <> struct compute<f16vec3> { typedef vec3 type; };
+            template <> struct compute<f16vec4> { typedef vec4 type; };
+        };
+
+        // a read only glic array
+        template <typename T> struct array_ref {
+            typedef typename detail::compute<T>::type value_type;
+
+            batch::span<const T> data;
+
+            array_ref(const batch::span<const T> data) : data(data) {}
+
+            std::size_t size() const { return data.size; }
+            value_type operator [](const std::size_t i) const { return data[i]; }
+        };
+
+        template <typename T> array_ref<T> ref(const batch::span<const T> data){ return array_ref<T>(data); }
+        template <typename T> array_ref<T> ref(const batch::span<T> data){ return array_ref<T>(data); }
+        template <typename T> array_ref<T> ref(const std::vector<T>& data){ return array_ref<T>(data); }
+
+        // one value for every element
+        template <typename T> struct uniform {
+            typedef T value_type;
+
+            T value;
+
+            uniform(const T& value) : value(value) {}
+
+            // a uniform has no length of its own and takes the one of the expression it appears in
+            std::size_t size() const { return 0; }
+            const T& operator [](std::size_t) const { return value; }
+        };
+
+        namespace detail {
+            template <typename T> struct is_expression : std::false_type {};
+            template <typename T> struct is_expression<array_ref<T>> : std::true_type {};
+
+            // builds the overloads only when an argument is an expression, so plain glic calls never see them
+            template <typename... A> using enable_expression = typename std::enable_if<(is_expression<A>::value || ...)>::type;
+
+            template <typename T> const T& wrap(const T& value, std::true_type){ return value; }
+            template <typename T> uniform<T> wrap(const T& value, std::false_type){ return uniform<T>(value); }
+
+            template <typename T> auto wrap(const T& value){ return wrap(value, is_expression<T>()); }
+
+            inline std::size_t common_size(){ return 0; }
+            template <typename E, typename... Rest> std::size_t common_size(const E& first, const Rest&... rest){
+                const std::size_t size = first.size(), others = common_size(rest...);
+                if(size && others && size != others){ throw std::length_error("glic::lazy: arrays of different lengths in one expression"); }
+                return size ? size : others;
+            }
+        };
+
+        // an operation over child expressions, evaluated element by element on demand
+        template <typename F, typename... E> struct node {
+            typedef decltype(std::declval<const F&>()(std::declval<const E&>()[0]...)) value_type;
+
+            F function;
+            std::tuple<E...> arguments;
+
+            node(const F& function, const E&... arguments) : function(function), arguments(arguments...) {}
+
+            std::size_t size() const { return std::apply([](const E&... e){ return detail::common_size(e...); }, arguments); }
+            value_type operator [](const std::size_t i) const { return element(i, std::index_sequence_for<E...>()); }
+
+            private:
+                template <std::size_t... I> value_type element(const std::size_t i, std::index_sequence<I...>) const { return function(std::get<I>(arguments)[i]...); }
+        };
+
+        namespace detail {
+            template <typename F, typename... E> struct is_expression<node<F, E...>> : std::true_type {};
+
+            template <typename F, typename... A> auto make_node(const F& function, const A&... args){
+                return node<F, decltype(wrap(args))...>(function, wrap(args)...);
+            }
+        };
+
+        // the output of an expression, assigning an expression to it runs the single fused loop (at the dispatch level, see
+        // dispatch.h)
+        template <typename T> struct target {
+            batch::span<T> out;
+
+            template <typename E, typename = detail::enable_expression<E>> const target& operator =(const E& expression) const {
+                if(expression.size() != out.size){ throw std::length_error("glic::lazy: expression and output lengths differ"); }
+                dispatch::run([&](){
+                    for(std::size_t i = 0; i < out.size; ++i){
+                        const typename detail::compute<T>::type value = expression[i];
+                        out[i] = T(value);
+                    }
+                });
+                return *this;
+            }
+        };
+
+        template <typename T> target<T> into(const batch::span<T> out){ return target<T>{out}; }
+        template <typename T> target<T> into(std::vector<T>& out){ return target<T>{batch::span<T>(out)}; }
+
+        // evaluates into a new vector
+        template <typename E, typename = detail::enable_expression<E>> std::vector<typename E::value_type> evaluate(const E& expression){
+            std::vector<typename E::value_type> out(expression.size());
+            into(out) = expression;
+            return out;
+        }
+
+        // arithmetic
+
+        template <typename A, typename B, typename = detail::enable_expression<A, B>> auto operator +(const A& a, const B& b){ return detail::make_node([](const auto& a, const auto& b){ return a + b; }, a, b); }
+        template <typename A, typename B, typename = detail::enable_expression<A, B>> auto operator -(const A& a, const B& b){ return detail::make_node([](const auto& a, const auto& b){ return a - b; }, a, b); }
+        template <typename A, typename B, typename = detail::enable_expression<A, B>> auto operator *(const A& a, const B& b){ return detail::make_node([](const auto& a, const auto& b){ return a * b; }, a, b); }
+        template <typename A, typename B, typename = detail::enable_expression<A, B>> auto operator /(const A& a, const B& b){ return detail::make_node([](const auto& a, const auto& b){ return a / b; }, a, b); }
+        template <typename A, typename = detail::enable_expression<A>> auto operator -(const A& a){ return detail::make_node([](const auto& a){ return -a; }, a); }
+
+        // builtins, the trailing precision tag of the transcendentals passes through as a uniform
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto radians(const A&... args){ return detail::make_node([](const auto&... a){ return glic::radians(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto degrees(const A&... args){ return detail::make_node([](const auto&... a){ return glic::degrees(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto sin(const A&... args){ return detail::make_node([](const auto&... a){ return glic::sin(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto cos(const A&... args){ return detail::make_node([](const auto&... a){ return glic::cos(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto tan(const A&... args){ return detail::make_node([](const auto&... a){ return glic::tan(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto asin(const A&... args){ return detail::make_node([](const auto&... a){ return glic::asin(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto acos(const A&... args){ return detail::make_node([](const auto&... a){ return glic::acos(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto atan(const A&... args){ return detail::make_node([](const auto&... a){ return glic::atan(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto pow(const A&... args){ return detail::make_node([](const auto&... a){ return glic::pow(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto exp(const A&... args){ return detail::make_node([](const auto&... a){ return glic::exp(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto log(const A&... args){ return detail::make_node([](const auto&... a){ return glic::log(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto exp2(const A&... args){ return detail::make_node([](const auto&... a){ return glic::exp2(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto log2(const A&... args){ return detail::make_node([](const auto&... a){ return glic::log2(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto sqrt(const A&... args){ return detail::make_node([](const auto&... a){ return glic::sqrt(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto inversesqrt(const A&... args){ return detail::make_node([](const auto&... a){ return glic::inversesqrt(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto abs(const A&... args){ return detail::make_node([](const auto&... a){ return glic::abs(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto sign(const A&... args){ return detail::make_node([](const auto&... a){ return glic::sign(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto floor(const A&... args){ return detail::make_node([](const auto&... a){ return glic::floor(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto ceil(const A&... args){ return detail::make_node([](const auto&... a){ return glic::ceil(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto fract(const A&... args){ return detail::make_node([](const auto&... a){ return glic::fract(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto mod(const A&... args){ return detail::make_node([](const auto&... a){ return glic::mod(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto min(const A&... args){ return detail::make_node([](const auto&... a){ return glic::min(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto max(const A&... args){ return detail::make_node([](const auto&... a){ return glic::max(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto clamp(const A&... args){ return detail::make_node([](const auto&... a){ return glic::clamp(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto mix(const A&... args){ return detail::make_node([](const auto&... a){ return glic::mix(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto step(const A&... args){ return detail::make_node([](const auto&... a){ return glic::step(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto smoothstep(const A&... args){ return detail::make_node([](const auto&... a){ return glic::smoothstep(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto length(const A&... args){ return detail::make_node([](const auto&... a){ return glic::length(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto distance(const A&... args){ return detail::make_node([](const auto&... a){ return glic::distance(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto dot(const A&... args){ return detail::make_node([](const auto&... a){ return glic::dot(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto cross(const A&... args){ return detail::make_node([](const auto&... a){ return glic::cross(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto normalize(const A&... args){ return detail::make_node([](const auto&... a){ return glic::normalize(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto faceforward(const A&... args){ return detail::make_node([](const auto&... a){ return glic::faceforward(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto reflect(const A&... args){ return detail::make_node([](const auto&... a){ return glic::reflect(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto refract(const A&... args){ return detail::make_node([](const auto&... a){ return glic::refract(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto lessThan(const A&... args){ return detail::make_node([](const auto&... a){ return glic::lessThan(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto lessThanEqual(const A&... args){ return detail::make_node([](const auto&... a){ return glic::lessThanEqual(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto greaterThan(const A&... args){ return detail::make_node([](const auto&... a){ return glic::greaterThan(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto greaterThanEqual(const A&... args){ return detail::make_node([](const auto&... a){ return glic::greaterThanEqual(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto equal(const A&... args){ return detail::make_node([](const auto&... a){ return glic::equal(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto notEqual(const A&... args){ return detail::make_node([](const auto&... a){ return glic::notEqual(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto any(const A&... args){ return detail::make_node([](const auto&... a){ return glic::any(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto all(const A&... args){ return detail::make_node([](const auto&... a){ return glic::all(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto not_(const A&... args){ return detail::make_node([](const auto&... a){ return glic::not_(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto select(const A&... args){ return detail::make_node([](const auto&... a){ return glic::select(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto isnan(const A&... args){ return detail::make_node([](const auto&... a){ return glic::isnan(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto isinf(const A&... args){ return detail::make_node([](const auto&... a){ return glic::isinf(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto floatBitsToInt(const A&... args){ return detail::make_node([](const auto&... a){ return glic::floatBitsToInt(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto floatBitsToUint(const A&... args){ return detail::make_node([](const auto&... a){ return glic::floatBitsToUint(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto intBitsToFloat(const A&... args){ return detail::make_node([](const auto&... a){ return glic::intBitsToFloat(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto uintBitsToFloat(const A&... args){ return detail::make_node([](const auto&... a){ return glic::uintBitsToFloat(a...); }, args...); }
+
+        template <typename... A, typename = detail::enable_expression<A...>> auto packHalf2x16(const A&... args){ return detail::make_node([](const auto&... a){ return glic::packHalf2x16(a...); }, args...); }
+        template <typename... A, typename = detail::enable_expression<A...>> auto unpackHalf2x16(const A&... args){ return detail::make_node([](const auto&... a){ return glic::unpackHalf2x16(a...); }, args...); }
+    };
+};
+
+#endif
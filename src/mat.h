@@ -0,0 +1,192 @@
+#ifndef GLIC_MAT_HEADER
+#define GLIC_MAT_HEADER
+
+#include "vec.h"
+
+// square matrix types, column major like GLSL: m[i] is column i and m[i].y is row 1 of it
+// +, - and / are componentwise, * is the linear algebra product (matrixCompMult in glic.h is the componentwise one)
+// matrix * vector combines the columns with vector operators, so under GLIC_SIMD mat4 * vec4 and mat4 * mat4 are four
+// broadcast multiplies and three adds per column on whole registers
+
+namespace glic {
+    struct mat3;
+    struct mat4;
+
+    struct mat2 {
+        vec2 columns[2];
+
+        mat2() {}
+        // s on the diagonal, zero elsewhere
+        explicit mat2(float s) : columns{vec2(s, 0.0f), vec2(0.0f, s)} {}
+        mat2(const vec2& c0, const vec2& c1) : columns{c0, c1} {}
+        mat2(float m00, float m01, float m10, float m11) : columns{vec2(m00, m01), vec2(m10, m11)} {}
+        // upper left corner
+        explicit mat2(const mat3& m);
+        explicit mat2(const mat4& m);
+
+        vec2& operator [](const int i){ return columns[i]; }
+        const vec2& operator [](const int i) const { return columns[i]; }
+
+        // overloads
+        mat2& operator +=(const float v){ columns[0] += v; columns[1] += v; return *this; }
+        mat2& operator +=(const mat2& m){ columns[0] += m[0]; columns[1] += m[1]; return *this; }
+
+        mat2& operator -=(const float v){ columns[0] -= v; columns[1] -= v; return *this; }
+        mat2& operator -=(const mat2& m){ columns[0] -= m[0]; columns[1] -= m[1]; return *this; }
+
+        mat2& operator *=(const float v){ columns[0] *= v; columns[1] *= v; return *this; }
+        mat2& operator *=(const mat2& m){ return *this = *this * m; }
+
+        mat2& operator /=(const float v){ columns[0] /= v; columns[1] /= v; return *this; }
+        mat2& operator /=(const mat2& m){ columns[0] /= m[0]; columns[1] /= m[1]; return *this; }
+
+        mat2 operator +(const float v) const { mat2 self(*this); self += v; return self; }
+        mat2 operator +(const mat2& m) const { mat2 self(*this); self += m; return self; }
+
+        mat2 operator -(const float v) const { mat2 self(*this); self -= v; return self; }
+        mat2 operator -(const mat2& m) const { mat2 self(*this); self -= m; return self; }
+
+        mat2 operator *(const float v) const { mat2 self(*this); self *= v; return self; }
+        vec2 operator *(const vec2& v) const { return columns[0] * v.x + columns[1] * v.y; }
+        mat2 operator *(const mat2& m) const { return mat2(*this * m[0], *this * m[1]); }
+
+        mat2 operator /(const float v) const { mat2 self(*this); self /= v; return self; }
+        mat2 operator /(const mat2& m) const { mat2 self(*this); self /= m; return self; }
+
+        mat2 operator -() const { return mat2(-columns[0], -columns[1]); }
+    };
+
+    inline mat2 operator +(const float v, const mat2& m){ return m + v; }
+    inline mat2 operator -(const float v, const mat2& m){ return mat2(v - m[0], v - m[1]); }
+    inline mat2 operator *(const float v, const mat2& m){ return m * v; }
+    inline mat2 operator /(const float v, const mat2& m){ return mat2(v / m[0], v / m[1]); }
+
+    // row vector times matrix, the same as transpose(m) * v
+    inline vec2 operator *(const vec2& v, const mat2& m){
+        return vec2(v.x * m[0].x + v.y * m[0].y, v.x * m[1].x + v.y * m[1].y);
+    }
+
+    struct mat3 {
+        vec3 columns[3];
+
+        mat3() {}
+        explicit mat3(float s) : columns{vec3(s, 0.0f, 0.0f), vec3(0.0f, s, 0.0f), vec3(0.0f, 0.0f, s)} {}
+        mat3(const vec3& c0, const vec3& c1, const vec3& c2) : columns{c0, c1, c2} {}
+        mat3(float m00, float m01, float m02, float m10, float m11, float m12, float m20, float m21, float m22) : columns{vec3(m00, m01, m02), vec3(m10, m11, m12), vec3(m20, m21, m22)} {}
+        // upper left corner, as the normal matrix of a model matrix is usually taken
+        explicit mat3(const mat4& m);
+        // m in the upper left corner, 1 on the rest of the diagonal
+        explicit mat3(const mat2& m) : columns{vec3(m[0].x, m[0].y, 0.0f), vec3(m[1].x, m[1].y, 0.0f), vec3(0.0f, 0.0f, 1.0f)} {}
+
+        vec3& operator [](const int i){ return columns[i]; }
+        const vec3& operator [](const int i) const { return columns[i]; }
+
+        // overloads
+        mat3& operator +=(const float v){ columns[0] += v; columns[1] += v; columns[2] += v; return *this; }
+        mat3& operator +=(const mat3& m){ columns[0] += m[0]; columns[1] += m[1]; columns[2] += m[2]; return *this; }
+
+        mat3& operator -=(const float v){ columns[0] -= v; columns[1] -= v; columns[2] -= v; return *this; }
+        mat3& operator -=(const mat3& m){ columns[0] -= m[0]; columns[1] -= m[1]; columns[2] -= m[2]; return *this; }
+
+        mat3& operator *=(const float v){ columns[0] *= v; columns[1] *= v; columns[2] *= v; return *this; }
+        mat3& operator *=(const mat3& m){ return *this = *this * m; }
+
+        mat3& operator /=(const float v){ columns[0] /= v; columns[1] /= v; columns[2] /= v; return *this; }
+        mat3& operator /=(const mat3& m){ columns[0] /= m[0]; columns[1] /= m[1]; columns[2] /= m[2]; return *this; }
+
+        mat3 operator +(const float v) const { mat3 self(*this); self += v; return self; }
+        mat3 operator +(const mat3& m) const { mat3 self(*this); self += m; return self; }
+
+        mat3 operator -(const float v) const { mat3 self(*this); self -= v; return self; }
+        mat3 operator -(const mat3& m) const { mat3 self(*this); self -= m; return self; }
+
+        mat3 operator *(const float v) const { mat3 self(*this); self *= v; return self; }
+        vec3 operator *(const vec3& v) const { return columns[0] * v.x + columns[1] * v.y + columns[2] * v.z; }
+        mat3 operator *(const mat3& m) const { return mat3(*this * m[0], *this * m[1], *this * m[2]); }
+
+        mat3 operator /(const float v) const { mat3 self(*this); self /= v; return self; }
+        mat3 operator /(const mat3& m) const { mat3 self(*this); self /= m; return self; }
+
+        mat3 operator -() const { return mat3(-columns[0], -columns[1], -columns[2]); }
+    };
+
+    inline mat3 operator +(const float v, const mat3& m){ return m + v; }
+    inline mat3 operator -(const float v, const mat3& m){ return mat3(v - m[0], v - m[1], v - m[2]); }
+    inline mat3 operator *(const float v, const mat3& m){ return m * v; }
+    inline mat3 operator /(const float v, const mat3& m){ return mat3(v / m[0], v / m[1], v / m[2]); }
+
+    inline vec3 operator *(const vec3& v, const mat3& m){
+        return vec3(
+            v.x * m[0].x + v.y * m[0].y + v.z * m[0].z,
+            v.x * m[1].x + v.y * m[1].y + v.z * m[1].z,
+            v.x * m[2].x + v.y * m[2].y + v.z * m[2].z
+        );
+    }
+
+    struct mat4 {
+        vec4 columns[4];
+
+        mat4() {}
+        explicit mat4(float s) : columns{vec4(s, 0.0f, 0.0f, 0.0f), vec4(0.0f, s, 0.0f, 0.0f), vec4(0.0f, 0.0f, s, 0.0f), vec4(0.0f, 0.0f, 0.0f, s)} {}
+        mat4(const vec4& c0, const vec4& c1, const vec4& c2, const vec4& c3) : columns{c0, c1, c2, c3} {}
+        mat4(
+            float m00, float m01, float m02, float m03,
+            float m10, float m11, float m12, float m13,
+            float m20, float m21, float m22, float m23,
+            float m30, float m31, float m32, float m33
+        ) : columns{vec4(m00, m01, m02, m03), vec4(m10, m11, m12, m13), vec4(m20, m21, m22, m23), vec4(m30, m31, m32, m33)} {}
+        explicit mat4(const mat3& m) : columns{vec4(m[0].x, m[0].y, m[0].z, 0.0f), vec4(m[1].x, m[1].y, m[1].z, 0.0f), vec4(m[2].x, m[2].y, m[2].z, 0.0f), vec4(0.0f, 0.0f, 0.0f, 1.0f)} {}
+        explicit mat4(const mat2& m) : mat4(mat3(m)) {}
+
+        vec4& operator [](const int i){ return columns[i]; }
+        const vec4& operator [](const int i) const { return columns[i]; }
+
+        // overloads
+        mat4& operator +=(const float v){ columns[0] += v; columns[1] += v; columns[2] += v; columns[3] += v; return *this; }
+        mat4& operator +=(const mat4& m){ columns[0] += m[0]; columns[1] += m[1]; columns[2] += m[2]; columns[3] += m[3]; return *this; }
+
+        mat4& operator -=(const float v){ columns[0] -= v; columns[1] -= v; columns[2] -= v; columns[3] -= v; return *this; }
+        mat4& operator -=(const mat4& m){ columns[0] -= m[0]; columns[1] -= m[1]; columns[2] -= m[2]; columns[3] -= m[3]; return *this; }
+
+        mat4& operator *=(const float v){ columns[0] *= v; columns[1] *= v; columns[2] *= v; columns[3] *= v; return *this; }
+        mat4& operator *=(const mat4& m){ return *this = *this * m; }
+
+        mat4& operator /=(const float v){ columns[0] /= v; columns[1] /= v; columns[2] /= v; columns[3] /= v; return *this; }
+        mat4& operator /=(const mat4& m){ columns[0] /= m[0]; columns[1] /= m[1]; columns[2] /= m[2]; columns[3] /= m[3]; return *this; }
+
+        mat4 operator +(const float v) const { mat4 self(*this); self += v; return self; }
+        mat4 operator +(const mat4& m) const { mat4 self(*this); self += m; return self; }
+
+        mat4 operator -(const float v) const { mat4 self(*this); self -= v; return self; }
+        mat4 operator -(const mat4& m) const { mat4 self(*this); self -= m; return self; }
+
+        mat4 operator *(const float v) const { mat4 self(*this); self *= v; return self; }
+        vec4 operator *(const vec4& v) const { return columns[0] * v.x + columns[1] * v.y + columns[2] * v.z + columns[3] * v.w; }
+        mat4 operator *(const mat4& m) const { return mat4(*this * m[0], *this * m[1], *this * m[2], *this * m[3]); }
+
+        mat4 operator /(const float v) const { mat4 self(*this); self /= v; return self; }
+        mat4 operator /(const mat4& m) const { mat4 self(*this); self /= m; return self; }
+
+        mat4 operator -() const { return mat4(-columns[0], -columns[1], -columns[2], -columns[3]); }
+    };
+
+    inline mat4 operator +(const float v, const mat4& m){ return m + v; }
+    inline mat4 operator -(const float v, const mat4& m){ return mat4(v - m[0], v - m[1], v - m[2], v - m[3]); }
+    inline mat4 operator *(const float v, const mat4& m){ return m * v; }
+    inline mat4 operator /(const float v, const mat4& m){ return mat4(v / m[0], v / m[1], v / m[2], v / m[3]); }
+
+    inline vec4 operator *(const vec4& v, const mat4& m){
+        return vec4(
+            v.x * m[0].x + v.y * m[0].y + v.z * m[0].z + v.w * m[0].w,
+            v.x * m[1].x + v.y * m[1].y + v.z * m[1].z + v.w * m[1].w,
+            v.x * m[2].x + v.y * m[2].y + v.z * m[2].z + v.w * m[2].w,
+            v.x * m[3].x + v.y * m[3].y + v.z * m[3].z + v.w * m[3].w
+        );
+    }
+
+    inline mat2::mat2(const mat3& m) : columns{vec2(m[0].x, m[0].y), vec2(m[1].x, m[1].y)} {}
+    inline mat2::mat2(const mat4& m) : columns{vec2(m[0].x, m[0].y), vec2(m[1].x, m[1].y)} {}
+    inline mat3::mat3(const mat4& m) : columns{vec3(m[0].x, m[0].y, m[0].z), vec3(m[1].x, m[1].y, m[1].z), vec3(m[2].x, m[2].y, m[2].z)} {}
+};
+
+#endif
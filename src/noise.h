@@ -0,0 +1,352 @@
+#ifndef GLIC_NOISE_HEADER
+#define GLIC_NOISE_HEADER
+
+#include <cassert>
+#include <cstdint>
+#include "batch.h"
+#include "dispatch.h"
+#include "glic.h"
+
+// procedural noise: value, gradient (perlin) and simplex noise in 2, 3 and 4 dimensions, worley (cellular) noise in 2 and 3,
+// and fbm sums of octaves of any of them
+// lattice points are hashed with integer hashes (no permutation tables, no sin), and every function is straight line code
+// with no branches, so the batch overloads at the end vectorize across samples
+// value, gradient and simplex return roughly [-1, 1] (scaled so sampled extremes land there, never clamped), gradient noise
+// is 0 on its lattice points, and worley returns the distances to the nearest and second nearest feature points
+// coordinates are floored to 32 bit ints, so |p| has to stay below 2^31 (and precision runs out long before that)
+
+namespace glic {
+    namespace noise {
+        // lowbias32 (from Chris Wellons' hash prospector), a bijection on 32 bit integers with every input bit reaching every
+        // output bit
+        inline std::uint32_t hash(std::uint32_t x){
+            x ^= x >> 16;
+            x *= 0x7feb352du;
+            x ^= x >> 15;
+            x *= 0x846ca68bu;
+            x ^= x >> 16;
+            return x;
+        }
+
+        // pcg2d, pcg3d and pcg4d (Jarzynski and Olano, "Hash functions for GPU rendering", 2020): every output lane depends
+        // on every input lane, so one call gives all the components of a random gradient or feature point
+        inline uvec2 hash(uvec2 v){
+            v = v * 1664525u + 1013904223u;
+            v.x += v.y * 1664525u;
+            v.y += v.x * 1664525u;
+            v ^= v >> 16;
+            v.x += v.y * 1664525u;
+            v.y += v.x * 1664525u;
+            v ^= v >> 16;
+            return v;
+        }
+
+        inline uvec3 hash(uvec3 v){
+            v = v * 1664525u + 1013904223u;
+            v.x += v.y * v.z;
+            v.y += v.z * v.x;
+            v.z += v.x * v.y;
+            v ^= v >> 16;
+            v.x += v.y * v.z;
+            v.y += v.z * v.x;
+            v.z += v.x * v.y;
+            return v;
+        }
+
+        inline uvec4 hash(uvec4 v){
+            v = v * 1664525u + 1013904223u;
+            v.x += v.y * v.w;
+            v.y += v.z * v.x;
+            v.z += v.x * v.y;
+            v.w += v.y * v.z;
+            v ^= v >> 16;
+            v.x += v.y * v.w;
+            v.y += v.z * v.x;
+            v.z += v.x * v.y;
+            v.w += v.y * v.z;
+            return v;
+        }
+
+        namespace detail {
+            // the top 24 bits of a hash as a float in [0, 1), and all 32 as one in [-1, 1)
+            inline float unit(const std::uint32_t h){ return static_cast<float>(h >> 8) * (1.0f / 16777216.0f); }
+            inline float signed_unit(const std::uint32_t h){ return static_cast<float>(static_cast<std::int32_t>(h)) * (1.0f / 2147483648.0f); }
+
+            inline vec2 unit(const uvec2 h){ return vec2(unit(h.x), unit(h.y)); }
+            inline vec3 unit(const uvec3 h){ return vec3(unit(h.x), unit(h.y), unit(h.z)); }
+
+            inline vec2 signed_unit(const uvec2 h){ return vec2(signed_unit(h.x), signed_unit(h.y)); }
+            inline vec3 signed_unit(const uvec3 h){ return vec3(signed_unit(h.x), signed_unit(h.y), signed_unit(h.z)); }
+            inline vec4 signed_unit(const uvec4 h){ return vec4(signed_unit(h.x), signed_unit(h.y), signed_unit(h.z), signed_unit(h.w)); }
+
+            // floor through glic::detail::truncated_floor, which vectorizes where std::floor does not
+            inline vec2 floor(const vec2 x){ return vec2(glic::detail::truncated_floor(x.x), glic::detail::truncated_floor(x.y)); }
+            inline vec3 floor(const vec3 x){ return vec3(glic::detail::truncated_floor(x.x), glic::detail::truncated_floor(x.y), glic::detail::truncated_floor(x.z)); }
+            inline vec4 floor(const vec4 x){ return vec4(glic::detail::truncated_floor(x.x), glic::detail::truncated_floor(x.y), glic::detail::truncated_floor(x.z), glic::detail::truncated_floor(x.w)); }
+
+            // 1 where x >= edge and 0 elsewhere, through an integer mask: with glic::step gcc threads jumps through the known
+            // 0 / 1 values and the corner selection of simplex turns back into branches
+            inline float step(const float edge, const float x){ return approx::detail::select(x >= edge, 1.0f, 0.0f); }
+
+            // lattice cell of a floored coordinate, negative cells wrap to large unsigned ones
+            inline uvec2 cell(const vec2 i){ return uvec2(ivec2(i)); }
+            inline uvec3 cell(const vec3 i){ return uvec3(ivec3(i)); }
+            inline uvec4 cell(const vec4 i){ return uvec4(ivec4(i)); }
+
+            // quintic interpolant 6t^5 - 15t^4 + 10t^3, whose first and second derivatives vanish at the cell edges
+            template <typename T> T fade(const T t){ return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+
+            // value noise: a random value per lattice point
+            inline float lattice_value(const uvec2 c){ return signed_unit(hash(c).x); }
+            inline float lattice_value(const uvec3 c){ return signed_unit(hash(c).x); }
+            inline float lattice_value(const uvec4 c){ return signed_unit(hash(c).x); }
+
+            // gradient noise: a random gradient per lattice point (uniform in the cube), dotted with the offset to it
+            inline float ramp(const uvec2 c, const vec2 offset){ return dot(signed_unit(hash(c)), offset); }
+            inline float ramp(const uvec3 c, const vec3 offset){ return dot(signed_unit(hash(c)), offset); }
+            inline float ramp(const uvec4 c, const vec4 offset){ return dot(signed_unit(hash(c)), offset); }
+
+            // a simplex corner's contribution, (r^2 - |d|^2)^4 * ramp, with r^2 = 0.5 in 2d and 0.6 above
+            template <typename U, typename V> float falloff(const U c, const V d, const float r2){
+                // clamped through an integer mask, a plain max lets gcc sink the products into a branch (see approx.h)
+                const float s = r2 - dot(d, d);
+                const float t = approx::detail::select(s > 0.0f, s, 0.0f);
+                const float t2 = t * t;
+                return t2 * t2 * ramp(c, d);
+            }
+
+            // loop kernel for the batch overloads
+            template <typename T, typename R, typename F> void map(const batch::span<const T> p, const batch::span<R> out, const F& function){
+                assert(p.size == out.size);
+                const std::size_t size = out.size;
+                dispatch::run([&](){ for(std::size_t i = 0; i < size; ++i){ out[i] = function(p[i]); } });
+            }
+
+            // the square roots batch worley leaves for after its loop
+            inline void sqrt(const batch::span<vec2> x){
+                for(vec2& v : x){ v = vec2(std::sqrt(v.x), std::sqrt(v.y)); }
+            }
+        };
+
+        // value noise, the random lattice values blended with the quintic fade
+        inline float value(const vec2 p){
+            const vec2 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec2 c = detail::cell(i);
+            return mix(
+                mix(detail::lattice_value(c), detail::lattice_value(c + uvec2(1, 0)), u.x),
+                mix(detail::lattice_value(c + uvec2(0, 1)), detail::lattice_value(c + uvec2(1, 1)), u.x), u.y);
+        }
+
+        inline float value(const vec3 p){
+            const vec3 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec3 c = detail::cell(i);
+            return mix(
+                mix(mix(detail::lattice_value(c), detail::lattice_value(c + uvec3(1, 0, 0)), u.x),
+                    mix(detail::lattice_value(c + uvec3(0, 1, 0)), detail::lattice_value(c + uvec3(1, 1, 0)), u.x), u.y),
+                mix(mix(detail::lattice_value(c + uvec3(0, 0, 1)), detail::lattice_value(c + uvec3(1, 0, 1)), u.x),
+                    mix(detail::lattice_value(c + uvec3(0, 1, 1)), detail::lattice_value(c + uvec3(1, 1, 1)), u.x), u.y), u.z);
+        }
+
+        inline float value(const vec4 p){
+            const vec4 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec4 c = detail::cell(i);
+            const auto slice = [&](const std::uint32_t w){
+                return mix(
+                    mix(mix(detail::lattice_value(c + uvec4(0, 0, 0, w)), detail::lattice_value(c + uvec4(1, 0, 0, w)), u.x),
+                        mix(detail::lattice_value(c + uvec4(0, 1, 0, w)), detail::lattice_value(c + uvec4(1, 1, 0, w)), u.x), u.y),
+                    mix(mix(detail::lattice_value(c + uvec4(0, 0, 1, w)), detail::lattice_value(c + uvec4(1, 0, 1, w)), u.x),
+                        mix(detail::lattice_value(c + uvec4(0, 1, 1, w)), detail::lattice_value(c + uvec4(1, 1, 1, w)), u.x), u.y), u.z);
+            };
+            return mix(slice(0), slice(1), u.w);
+        }
+
+        // gradient (perlin) noise with the quintic fade, scaled so the extremes land near -1 and 1
+        inline float gradient(const vec2 p){
+            const vec2 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec2 c = detail::cell(i);
+            return 1.27f * mix(
+                mix(detail::ramp(c, f), detail::ramp(c + uvec2(1, 0), f - vec2(1, 0)), u.x),
+                mix(detail::ramp(c + uvec2(0, 1), f - vec2(0, 1)), detail::ramp(c + uvec2(1, 1), f - vec2(1, 1)), u.x), u.y);
+        }
+
+        inline float gradient(const vec3 p){
+            const vec3 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec3 c = detail::cell(i);
+            return 1.1f * mix(
+                mix(mix(detail::ramp(c, f), detail::ramp(c + uvec3(1, 0, 0), f - vec3(1, 0, 0)), u.x),
+                    mix(detail::ramp(c + uvec3(0, 1, 0), f - vec3(0, 1, 0)), detail::ramp(c + uvec3(1, 1, 0), f - vec3(1, 1, 0)), u.x), u.y),
+                mix(mix(detail::ramp(c + uvec3(0, 0, 1), f - vec3(0, 0, 1)), detail::ramp(c + uvec3(1, 0, 1), f - vec3(1, 0, 1)), u.x),
+                    mix(detail::ramp(c + uvec3(0, 1, 1), f - vec3(0, 1, 1)), detail::ramp(c + uvec3(1, 1, 1), f - vec3(1, 1, 1)), u.x), u.y), u.z);
+        }
+
+        inline float gradient(const vec4 p){
+            const vec4 i = detail::floor(p), f = p - i, u = detail::fade(f);
+            const uvec4 c = detail::cell(i);
+            const auto slice = [&](const std::uint32_t w){
+                const float fw = static_cast<float>(w);
+                return mix(
+                    mix(mix(detail::ramp(c + uvec4(0, 0, 0, w), f - vec4(0, 0, 0, fw)), detail::ramp(c + uvec4(1, 0, 0, w), f - vec4(1, 0, 0, fw)), u.x),
+                        mix(detail::ramp(c + uvec4(0, 1, 0, w), f - vec4(0, 1, 0, fw)), detail::ramp(c + uvec4(1, 1, 0, w), f - vec4(1, 1, 0, fw)), u.x), u.y),
+                    mix(mix(detail::ramp(c + uvec4(0, 0, 1, w), f - vec4(0, 0, 1, fw)), detail::ramp(c + uvec4(1, 0, 1, w), f - vec4(1, 0, 1, fw)), u.x),
+                        mix(detail::ramp(c + uvec4(0, 1, 1, w), f - vec4(0, 1, 1, fw)), detail::ramp(c + uvec4(1, 1, 1, w), f - vec4(1, 1, 1, fw)), u.x), u.y), u.z);
+            };
+            return 1.12f * mix(slice(0), slice(1), u.w);
+        }
+
+        // simplex noise (perlin 2001, in the form of Gustavson's notes): sums n + 1 corner contributions instead of blending
+        // 2^n, so it stays cheap in 4d; the corner order comes from comparisons turned into 0 / 1 steps rather than branches
+        inline float simplex(const vec2 p){
+            const float skew = 0.366025403784f, unskew = 0.211324865405f; // (sqrt(3) - 1) / 2, (3 - sqrt(3)) / 6
+
+            const vec2 i = detail::floor(p + (p.x + p.y) * skew);
+            const vec2 x0 = p - i + (i.x + i.y) * unskew;
+            const float xy = detail::step(x0.y, x0.x);
+            const vec2 i1(xy, 1.0f - xy);
+            const vec2 x1 = x0 - i1 + unskew, x2 = x0 - 1.0f + 2.0f * unskew;
+
+            const uvec2 c = detail::cell(i);
+            return 72.0f * (detail::falloff(c, x0, 0.5f) + detail::falloff(c + detail::cell(i1), x1, 0.5f) + detail::falloff(c + uvec2(1, 1), x2, 0.5f));
+        }
+
+        inline float simplex(const vec3 p){
+            const float skew = 1.0f / 3.0f, unskew = 1.0f / 6.0f;
+
+            const vec3 i = detail::floor(p + (p.x + p.y + p.z) * skew);
+            const vec3 x0 = p - i + (i.x + i.y + i.z) * unskew;
+
+            // g[k] is 1 where x0[k] is at least the next component (x0.x >= x0.y, x0.y >= x0.z, x0.z >= x0.x)
+            const vec3 g(detail::step(x0.y, x0.x), detail::step(x0.z, x0.y), detail::step(x0.x, x0.z));
+            const vec3 l = 1.0f - g, lzxy(l.z, l.x, l.y);
+            const vec3 i1 = g * lzxy, i2 = g + lzxy - i1; // min and max, for values that are 0 or 1
+            const vec3 x1 = x0 - i1 + unskew, x2 = x0 - i2 + 2.0f * unskew, x3 = x0 - 1.0f + 3.0f * unskew;
+
+            const uvec3 c = detail::cell(i);
+            return 27.0f * (detail::falloff(c, x0, 0.6f) + detail::falloff(c + detail::cell(i1), x1, 0.6f) + detail::falloff(c + detail::cell(i2), x2, 0.6f) + detail::falloff(c + uvec3(1, 1, 1), x3, 0.6f));
+        }
+
+        inline float simplex(const vec4 p){
+            const float skew = 0.309016994375f, unskew = 0.138196601125f; // (sqrt(5) - 1) / 4, (5 - sqrt(5)) / 20
+
+            const vec4 i = detail::floor(p + (p.x + p.y + p.z + p.w) * skew);
+            const vec4 x0 = p - i + (i.x + i.y + i.z + i.w) * unskew;
+
+            // rank of each component (how many of the others it is at least), the corners step the highest ranks first
+            const float xy = detail::step(x0.y, x0.x), xz = detail::step(x0.z, x0.x), xw = detail::step(x0.w, x0.x);
+            const float yz = detail::step(x0.z, x0.y), yw = detail::step(x0.w, x0.y), zw = detail::step(x0.w, x0.z);
+            const vec4 rank(xy + xz + xw, (1.0f - xy) + yz + yw, (1.0f - xz) + (1.0f - yz) + zw, (1.0f - xw) + (1.0f - yw) + (1.0f - zw));
+            const vec4 i1 = clamp(rank - 2.0f, 0.0f, 1.0f), i2 = clamp(rank - 1.0f, 0.0f, 1.0f), i3 = clamp(rank, 0.0f, 1.0f);
+            const vec4 x1 = x0 - i1 + unskew, x2 = x0 - i2 + 2.0f * unskew, x3 = x0 - i3 + 3.0f * unskew, x4 = x0 - 1.0f + 4.0f * unskew;
+
+            const uvec4 c = detail::cell(i);
+            return 27.0f * (detail::falloff(c, x0, 0.6f) + detail::falloff(c + detail::cell(i1), x1, 0.6f) + detail::falloff(c + detail::cell(i2), x2, 0.6f)
+                + detail::falloff(c + detail::cell(i3), x3, 0.6f) + detail::falloff(c + uvec4(1, 1, 1, 1), x4, 0.6f));
+        }
+
+        namespace detail {
+            // squared distances to the nearest and second nearest feature point, the square roots are left to the caller so
+            // the batch loop stays free of sqrt's errno branch
+            inline vec2 worley_squared(const vec2 p){
+                const vec2 i = detail::floor(p), f = p - i;
+                const uvec2 c = detail::cell(i);
+
+                // written out cell by cell, the vectorizer does not take loops nested inside the loop over samples
+                float f1 = 8.0f, f2 = 8.0f; // squared distances, larger than any within the search
+                const auto visit = [&](const int x, const int y){
+                    const vec2 d = vec2(static_cast<float>(x), static_cast<float>(y)) + detail::unit(hash(c + uvec2(ivec2(x, y)))) - f;
+                    const float d2 = dot(d, d);
+                    f2 = min(f2, max(f1, d2));
+                    f1 = min(f1, d2);
+                };
+                visit(-1, -1); visit(0, -1); visit(1, -1);
+                visit(-1, 0); visit(0, 0); visit(1, 0);
+                visit(-1, 1); visit(0, 1); visit(1, 1);
+                return vec2(f1, f2);
+            }
+
+            inline vec2 worley_squared(const vec3 p){
+                const vec3 i = detail::floor(p), f = p - i;
+                const uvec3 c = detail::cell(i);
+
+                float f1 = 12.0f, f2 = 12.0f;
+                const auto visit = [&](const int x, const int y, const int z){
+                    const vec3 d = vec3(static_cast<float>(x), static_cast<float>(y), static_cast<float>(z)) + detail::unit(hash(c + uvec3(ivec3(x, y, z)))) - f;
+                    const float d2 = dot(d, d);
+                    f2 = min(f2, max(f1, d2));
+                    f1 = min(f1, d2);
+                };
+                const auto row = [&](const int y, const int z){ visit(-1, y, z); visit(0, y, z); visit(1, y, z); };
+                row(-1, -1); row(0, -1); row(1, -1);
+                row(-1, 0); row(0, 0); row(1, 0);
+                row(-1, 1); row(0, 1); row(1, 1);
+                return vec2(f1, f2);
+            }
+        };
+
+        // worley (cellular) noise: one feature point at a random place in every cell, returns the euclidean distance to the
+        // nearest (x) and second nearest (y) feature point
+        // like most implementations it searches the 3 x 3 (3 x 3 x 3) cells around p, so the rare second nearest point that
+        // lies further out is missed
+        inline vec2 worley(const vec2 p){ const vec2 d2 = detail::worley_squared(p); return vec2(std::sqrt(d2.x), std::sqrt(d2.y)); }
+        inline vec2 worley(const vec3 p){ const vec2 d2 = detail::worley_squared(p); return vec2(std::sqrt(d2.x), std::sqrt(d2.y)); }
+
+        // fractional brownian motion: octaves of a noise function, each at lacunarity times the frequency and gain times the
+        // amplitude of the one before, divided by the total amplitude so the range stays that of one octave
+        // noise is anything callable on p returning float: fbm([](const vec3 q){ return noise::simplex(q); }, p, 5)
+        // every octave is also shifted by half a cell, so the lattice points of the octaves do not line up at the origin
+        template <typename Noise, typename P> float fbm(const Noise& noise, P p, const int octaves, const float lacunarity = 2.0f, const float gain = 0.5f){
+            float sum = 0.0f, amplitude = 1.0f, total = 0.0f;
+            for(int octave = 0; octave < octaves; ++octave){
+                sum += amplitude * noise(p);
+                total += amplitude;
+                amplitude *= gain;
+                p = p * lacunarity + 0.5f;
+            }
+            return total > 0.0f ? sum / total : 0.0f;
+        }
+
+        // array versions, one sample per element, run through dispatch::run like batch.h
+        inline void value(const batch::span<const vec2> p, const batch::span<float> out){ detail::map(p, out, [](const vec2 v){ return value(v); }); }
+        inline void value(const batch::span<const vec3> p, const batch::span<float> out){ detail::map(p, out, [](const vec3 v){ return value(v); }); }
+        inline void value(const batch::span<const vec4> p, const batch::span<float> out){ detail::map(p, out, [](const vec4 v){ return value(v); }); }
+
+        inline void gradient(const batch::span<const vec2> p, const batch::span<float> out){ detail::map(p, out, [](const vec2 v){ return gradient(v); }); }
+        inline void gradient(const batch::span<const vec3> p, const batch::span<float> out){ detail::map(p, out, [](const vec3 v){ return gradient(v); }); }
+        inline void gradient(const batch::span<const vec4> p, const batch::span<float> out){ detail::map(p, out, [](const vec4 v){ return gradient(v); }); }
+
+        inline void simplex(const batch::span<const vec2> p, const batch::span<float> out){ detail::map(p, out, [](const vec2 v){ return simplex(v); }); }
+        inline void simplex(const batch::span<const vec3> p, const batch::span<float> out){ detail::map(p, out, [](const vec3 v){ return simplex(v); }); }
+        inline void simplex(const batch::span<const vec4> p, const batch::span<float> out){ detail::map(p, out, [](const vec4 v){ return simplex(v); }); }
+
+        inline void worley(const batch::span<const vec2> p, const batch::span<vec2> out){ detail::map(p, out, [](const vec2 v){ return detail::worley_squared(v); }); detail::sqrt(out); }
+        inline void worley(const batch::span<const vec3> p, const batch::span<vec2> out){ detail::map(p, out, [](const vec3 v){ return detail::worley_squared(v); }); detail::sqrt(out); }
+
+        // runs the octaves outside the loop over samples (in chunks that stay in L1) so that loop vectorizes, the arithmetic
+        // per sample is the same as the single sample fbm
+        template <typename Noise, typename P> void fbm(const Noise& noise, const batch::span<const P> p, const batch::span<float> out, const int octaves, const float lacunarity = 2.0f, const float gain = 0.5f){
+            assert(p.size == out.size);
+            const std::size_t size = out.size;
+            dispatch::run([&](){
+                constexpr std::size_t chunk = 256;
+                P q[chunk];
+                float sum[chunk];
+                for(std::size_t begin = 0; begin < size; begin += chunk){
+                    const std::size_t count = size - begin < chunk ? size - begin : chunk;
+                    for(std::size_t i = 0; i < count; ++i){ q[i] = p[begin + i]; sum[i] = 0.0f; }
+
+                    float amplitude = 1.0f, total = 0.0f;
+                    for(int octave = 0; octave < octaves; ++octave){
+                        for(std::size_t i = 0; i < count; ++i){
+                            sum[i] += amplitude * noise(q[i]);
+                            q[i] = q[i] * lacunarity + 0.5f;
+                        }
+                        total += amplitude;
+                        amplitude *= gain;
+                    }
+                    for(std::size_t i = 0; i < count; ++i){ out[begin + i] = total > 0.0f ? sum[i] / total : 0.0f; }
+                }
+            });
+        }
+    };
+};
+
+#endif
@@ -0,0 +1,240 @@
+#ifndef GLIC_QUAD_HEADER
+#define GLIC_QUAD_HEADER
+
+#include <algorithm>
+#include <type_traits>
+#include "glic.h"
+#include "render.h"
+
+// 2x2 fragment quads: four invocations of the same shader run in lockstep, one lane per pixel, so derivatives are plain
+// differences between neighbouring lanes instead of extra shader calls
+// lane i covers pixel (x0 + (i & 1), y0 + (i >> 1)), with y growing upwards as in GL:
+//   2 3
+//   0 1
+// every builtin of glic.h accepts quads in any argument, uniform (non quad) arguments are shared by all four lanes
+// comparing quads gives a quad<bool> lane mask; divergent if / else runs through branch(), which blends the two sides per
+// lane and skips a side that no lane takes
+// the lanes are stored pixel by pixel (T lane[4]) rather than one register per component across the pixels, so lane[i] stays
+// an ordinary T and per_lane can run any scalar or vector shader code; simple lane wise arithmetic on quad<float> and the
+// quad vectors still compiles to whole register operations (the compiler merges the four identical lanes), while calls such
+// as sin or normalize run once per lane
+
+namespace glic {
+    template <typename T> struct quad {
+        alignas(4 * sizeof(float)) T lane[4];
+
+        quad() : lane{} {}
+        quad(const T& value) : lane{value, value, value, value} {}
+        quad(const T& lane0, const T& lane1, const T& lane2, const T& lane3) : lane{lane0, lane1, lane2, lane3} {}
+
+        T& operator [](const int i){ return lane[i]; }
+        const T& operator [](const int i) const { return lane[i]; }
+
+        template <typename F> auto apply(const F& function) const -> quad<decltype(function(lane[0]))> {
+            return quad<decltype(function(lane[0]))>(function(lane[0]), function(lane[1]), function(lane[2]), function(lane[3]));
+        }
+
+        template <typename U> quad& operator +=(const U& v){ return *this = *this + v; }
+        template <typename U> quad& operator -=(const U& v){ return *this = *this - v; }
+        template <typename U> quad& operator *=(const U& v){ return *this = *this * v; }
+        template <typename U> quad& operator /=(const U& v){ return *this = *this / v; }
+
+        quad operator -() const { return quad(-lane[0], -lane[1], -lane[2], -lane[3]); }
+        quad operator ~() const { return quad(~lane[0], ~lane[1], ~lane[2], ~lane[3]); }
+        quad<bool> operator !() const { return quad<bool>(!lane[0], !lane[1], !lane[2], !lane[3]); }
+    };
+
+    typedef quad<float> quad_float;
+    typedef quad<vec2> quad_vec2;
+    typedef quad<vec3> quad_vec3;
+    typedef quad<vec4> quad_vec4;
+    typedef quad<bool> quad_bool;
+
+    namespace detail {
+        template <typename T> struct is_quad : std::false_type {};
+        template <typename T> struct is_quad<quad<T>> : std::true_type {};
+
+        // enables the quad overloads only when at least one argument is a quad, so scalar and vector calls never see them
+        template <typename... A> using enable_quad = typename std::enable_if<(is_quad<A>::value || ...)>::type;
+
+        template <typename T> const T& lane(const T& value, int){ return value; }
+        template <typename T> const T& lane(const quad<T>& value, const int i){ return value.lane[i]; }
+    };
+
+    // calls function once per lane with that lane of every quad argument, the way a shader body runs per invocation:
+    // per_lane([](vec2 uv){ return vec3(uv.x, uv.y, 1.0f); }, fragCoord)
+    template <typename F, typename... A> auto per_lane(const F& function, const A&... args) -> quad<decltype(function(detail::lane(args, 0)...))> {
+        return quad<decltype(function(detail::lane(args, 0)...))>(function(detail::lane(args, 0)...), function(detail::lane(args, 1)...), function(detail::lane(args, 2)...), function(detail::lane(args, 3)...));
+    }
+
+    // arithmetic, mixing quads with each other and with uniform values
+
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator +(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a + b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator -(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a - b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator *(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a * b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator /(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a / b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator %(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a % b; }, a, b); }
+
+    // bit operators, which are also the lane wise and / or / xor of quad<bool> masks
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator &(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a & b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator |(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a | b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator ^(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a ^ b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator <<(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a << b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator >>(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a >> b; }, a, b); }
+
+    // scalar comparisons give lane masks (vectors compare through lessThan and friends, as in GLSL)
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator <(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a < b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator <=(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a <= b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator >(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a > b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator >=(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a >= b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator ==(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a == b; }, a, b); }
+    template <typename A, typename B, typename = detail::enable_quad<A, B>> auto operator !=(const A& a, const B& b){ return per_lane([](const auto& a, const auto& b){ return a != b; }, a, b); }
+
+    // builtins, forwarded lane by lane including any trailing precision tag
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto radians(const A&... args){ return per_lane([](const auto&... a){ return glic::radians(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto degrees(const A&... args){ return per_lane([](const auto&... a){ return glic::degrees(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto sin(const A&... args){ return per_lane([](const auto&... a){ return glic::sin(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto cos(const A&... args){ return per_lane([](const auto&... a){ return glic::cos(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto tan(const A&... args){ return per_lane([](const auto&... a){ return glic::tan(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto asin(const A&... args){ return per_lane([](const auto&... a){ return glic::asin(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto acos(const A&... args){ return per_lane([](const auto&... a){ return glic::acos(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto atan(const A&... args){ return per_lane([](const auto&... a){ return glic::atan(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto pow(const A&... args){ return per_lane([](const auto&... a){ return glic::pow(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto exp(const A&... args){ return per_lane([](const auto&... a){ return glic::exp(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto log(const A&... args){ return per_lane([](const auto&... a){ return glic::log(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto exp2(const A&... args){ return per_lane([](const auto&... a){ return glic::exp2(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto log2(const A&... args){ return per_lane([](const auto&... a){ return glic::log2(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto sqrt(const A&... args){ return per_lane([](const auto&... a){ return glic::sqrt(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto inversesqrt(const A&... args){ return per_lane([](const auto&... a){ return glic::inversesqrt(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto abs(const A&... args){ return per_lane([](const auto&... a){ return glic::abs(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto sign(const A&... args){ return per_lane([](const auto&... a){ return glic::sign(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto floor(const A&... args){ return per_lane([](const auto&... a){ return glic::floor(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto ceil(const A&... args){ return per_lane([](const auto&... a){ return glic::ceil(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto fract(const A&... args){ return per_lane([](const auto&... a){ return glic::fract(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto mod(const A&... args){ return per_lane([](const auto&... a){ return glic::mod(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto min(const A&... args){ return per_lane([](const auto&... a){ return glic::min(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto max(const A&... args){ return per_lane([](const auto&... a){ return glic::max(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto clamp(const A&... args){ return per_lane([](const auto&... a){ return glic::clamp(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto mix(const A&... args){ return per_lane([](const auto&... a){ return glic::mix(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto step(const A&... args){ return per_lane([](const auto&... a){ return glic::step(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto smoothstep(const A&... args){ return per_lane([](const auto&... a){ return glic::smoothstep(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto length(const A&... args){ return per_lane([](const auto&... a){ return glic::length(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto distance(const A&... args){ return per_lane([](const auto&... a){ return glic::distance(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto dot(const A&... args){ return per_lane([](const auto&... a){ return glic::dot(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto cross(const A&... args){ return per_lane([](const auto&... a){ return glic::cross(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto normalize(const A&... args){ return per_lane([](const auto&... a){ return glic::normalize(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto faceforward(const A&... args){ return per_lane([](const auto&... a){ return glic::faceforward(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto reflect(const A&... args){ return per_lane([](const auto&... a){ return glic::reflect(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto refract(const A&... args){ return per_lane([](const auto&... a){ return glic::refract(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto lessThan(const A&... args){ return per_lane([](const auto&... a){ return glic::lessThan(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto lessThanEqual(const A&... args){ return per_lane([](const auto&... a){ return glic::lessThanEqual(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto greaterThan(const A&... args){ return per_lane([](const auto&... a){ return glic::greaterThan(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto greaterThanEqual(const A&... args){ return per_lane([](const auto&... a){ return glic::greaterThanEqual(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto equal(const A&... args){ return per_lane([](const auto&... a){ return glic::equal(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto notEqual(const A&... args){ return per_lane([](const auto&... a){ return glic::notEqual(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto any(const A&... args){ return per_lane([](const auto&... a){ return glic::any(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto all(const A&... args){ return per_lane([](const auto&... a){ return glic::all(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto not_(const A&... args){ return per_lane([](const auto&... a){ return glic::not_(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto select(const A&... args){ return per_lane([](const auto&... a){ return glic::select(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto isnan(const A&... args){ return per_lane([](const auto&... a){ return glic::isnan(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto isinf(const A&... args){ return per_lane([](const auto&... a){ return glic::isinf(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto floatBitsToInt(const A&... args){ return per_lane([](const auto&... a){ return glic::floatBitsToInt(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto floatBitsToUint(const A&... args){ return per_lane([](const auto&... a){ return glic::floatBitsToUint(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto intBitsToFloat(const A&... args){ return per_lane([](const auto&... a){ return glic::intBitsToFloat(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto uintBitsToFloat(const A&... args){ return per_lane([](const auto&... a){ return glic::uintBitsToFloat(a...); }, args...); }
+
+    template <typename... A, typename = detail::enable_quad<A...>> auto packHalf2x16(const A&... args){ return per_lane([](const auto&... a){ return glic::packHalf2x16(a...); }, args...); }
+    template <typename... A, typename = detail::enable_quad<A...>> auto unpackHalf2x16(const A&... args){ return per_lane([](const auto&... a){ return glic::unpackHalf2x16(a...); }, args...); }
+
+    // lane masks
+    // any and all above reduce each lane's bvec like GLSL; quadAny and quadAll reduce a mask across the four lanes
+
+    inline bool quadAny(const quad<bool>& mask){ return mask.lane[0] | mask.lane[1] | mask.lane[2] | mask.lane[3]; }
+    inline bool quadAll(const quad<bool>& mask){ return mask.lane[0] & mask.lane[1] & mask.lane[2] & mask.lane[3]; }
+
+    // if(condition) x = then(); else x = otherwise(); for a whole quad, as x = branch(condition, then, otherwise)
+    // a side only runs when some lane takes it, and a divergent quad runs both and keeps each lane's own result, the way a
+    // gpu masks off lanes; either side may return a quad or a uniform value
+    template <typename Then, typename Else> auto branch(const quad<bool>& condition, const Then& then, const Else& otherwise){
+        typedef decltype(select(condition, then(), otherwise())) result;
+        if(quadAll(condition)){ return result(then()); }
+        if(!quadAny(condition)){ return result(otherwise()); }
+        return result(select(condition, then(), otherwise()));
+    }
+
+    // derivatives
+    // fine: each row (dFdx) or column (dFdy) of the quad gets its own difference
+    // coarse: the whole quad shares the differences of lane 0's row and column, which is what most GPUs do for plain dFdx/dFdy
+    // the plain forms are fine here, since both cost the same on the cpu and fine is the more accurate of the two
+
+    template <typename T> quad<T> dFdxFine(const quad<T>& p){
+        const T bottom = p.lane[1] - p.lane[0], top = p.lane[3] - p.lane[2];
+        return quad<T>(bottom, bottom, top, top);
+    }
+
+    template <typename T> quad<T> dFdyFine(const quad<T>& p){
+        const T left = p.lane[2] - p.lane[0], right = p.lane[3] - p.lane[1];
+        return quad<T>(left, right, left, right);
+    }
+
+    template <typename T> quad<T> dFdxCoarse(const quad<T>& p){ return quad<T>(p.lane[1] - p.lane[0]); }
+    template <typename T> quad<T> dFdyCoarse(const quad<T>& p){ return quad<T>(p.lane[2] - p.lane[0]); }
+
+    template <typename T> quad<T> dFdx(const quad<T>& p){ return dFdxFine(p); }
+    template <typename T> quad<T> dFdy(const quad<T>& p){ return dFdyFine(p); }
+
+    template <typename T> quad<T> fwidthFine(const quad<T>& p){ return abs(dFdxFine(p)) + abs(dFdyFine(p)); }
+    template <typename T> quad<T> fwidthCoarse(const quad<T>& p){ return abs(dFdxCoarse(p)) + abs(dFdyCoarse(p)); }
+    template <typename T> quad<T> fwidth(const quad<T>& p){ return abs(dFdx(p)) + abs(dFdy(p)); }
+
+    // quad rendering: the shader is shaped like quad<vec4> mainImage(quad<vec2> fragCoord), optionally taking the uniforms
+    // quads on the right or top edge of an odd sized framebuffer run their outside lanes as helper invocations, which feed
+    // derivatives but are never stored
+
+    namespace detail {
+        template <typename Shader> quad<vec4> shade_quad(const Shader& shader, const quad<vec2>& fragCoord, const uniforms& inputs){
+            if constexpr(std::is_invocable<const Shader&, quad<vec2>, const uniforms&>::value){
+                return shader(fragCoord, inputs);
+            } else {
+                return shader(fragCoord);
+            }
+        }
+
+        template <typename Shader, typename Pixel> frame_stats render_quads(const Shader& shader, const uniforms& inputs, Pixel* pixels, render_options options){
+            // even tiles keep every quad inside one tile, and at least 2, run_tiles would make 1 pixel tiles of 0 or less
+            options.tile_size = std::max(2, options.tile_size);
+            options.tile_size += options.tile_size & 1;
+
+            return run_tiles(inputs, pixels, options, [&](Pixel* pixels, const int width, const int x0, const int y0, const int x1, const int y1){
+                for(int y = y0; y < y1; y += 2){
+                    for(int x = x0; x < x1; x += 2){
+                        const quad<vec2> fragCoord(vec2(x + 0.5f, y + 0.5f), vec2(x + 1.5f, y + 0.5f), vec2(x + 0.5f, y + 1.5f), vec2(x + 1.5f, y + 1.5f));
+                        const quad<vec4> color = shade_quad(shader, fragCoord, inputs);
+
+                        for(int i = 0; i < 4; ++i){
+                            const int px = x + (i & 1), py = y + (i >> 1);
+                            if(px < x1 && py < y1){ store(pixel_at(pixels, py * width + px), color.lane[i]); }
+                        }
+                    }
+                }
+            });
+        }
+    };
+
+    // same framebuffer layouts as render()
+    template <typename Shader> frame_stats render_quads(const Shader& shader, const uniforms& inputs, vec4* pixels, const render_options& options = render_options()){
+        return detail::render_quads(shader, inputs, pixels, options);
+    }
+
+    template <typename Shader> frame_stats render_quads(const Shader& shader, const uniforms& inputs, std::uint8_t* pixels, const render_options& options = render_options()){
+        return detail::render_quads(shader, inputs, pixels, options);
+    }
+};
+
+#endif
@@ -0,0 +1,111 @@
+#ifndef GLIC_RENDER_HEADER
+#define GLIC_RENDER_HEADER
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "denormal.h"
+#include "glic.h"
+#include "thread_pool.h"
+
+// runs a fragment shader over every pixel of a caller owned framebuffer
+// the shader is any callable shaped like vec4 mainImage(vec2 fragCoord), optionally taking the uniforms as a second argument
+// rows follow the GL convention: row 0 of the buffer is the bottom of the image and fragCoord is the pixel center
+
+namespace glic {
+    struct uniforms {
+        vec2 resolution;
+        float time;
+
+        uniforms(const vec2 resolution, const float time = 0.0f) : resolution(resolution), time(time) {}
+    };
+
+    struct frame_stats {
+        std::size_t pixels;
+        double seconds;
+
+        double megapixels_per_second() const { return seconds > 0.0 ? pixels / seconds * 1e-6 : 0.0; }
+    };
+
+    struct render_options {
+        // tiles are square, 32 x 32 keeps a tile of vec4 output (16 KiB) inside L1
+        int tile_size = 32;
+        thread_pool* pool = nullptr;
+        // shade with denormals flushed to zero (see denormal.h), set on whichever thread runs each tile
+        bool flush_denormals = false;
+    };
+
+    namespace detail {
+        template <typename Shader> vec4 shade(const Shader& shader, const vec2 fragCoord, const uniforms& inputs){
+            if constexpr(std::is_invocable<const Shader&, vec2, const uniforms&>::value){
+                return shader(fragCoord, inputs);
+            } else {
+                return shader(fragCoord);
+            }
+        }
+
+        inline void store(vec4* pixel, const vec4 color){ *pixel = color; }
+
+        // max with the constant first turns nan into 0 (clamp would pass it through), as converting nan to an int is undefined
+        inline void store(std::uint8_t* pixel, const vec4 color){
+            const vec4 scaled = min(max(vec4(0.0f), color), vec4(1.0f)) * 255.0f + 0.5f;
+            pixel[0] = static_cast<std::uint8_t>(scaled.x);
+            pixel[1] = static_cast<std::uint8_t>(scaled.y);
+            pixel[2] = static_cast<std::uint8_t>(scaled.z);
+            pixel[3] = static_cast<std::uint8_t>(scaled.w);
+        }
+
+        // pixel p is the p-th pixel of the row, both element types are addressed per pixel
+        inline vec4* pixel_at(vec4* row, const int p){ return row + p; }
+        inline std::uint8_t* pixel_at(std::uint8_t* row, const int p){ return row + 4 * p; }
+
+        // splits the framebuffer into tiles and shades them on the pool, timing the whole frame
+        template <typename Pixel, typename Tile> frame_stats run_tiles(const uniforms& inputs, Pixel* pixels, const render_options& options, const Tile& tile){
+            const int width = static_cast<int>(inputs.resolution.x), height = static_cast<int>(inputs.resolution.y);
+            const int size = std::max(1, options.tile_size);
+            const int columns = (width + size - 1) / size, rows = (height + size - 1) / size;
+
+            thread_pool& pool = options.pool ? *options.pool : thread_pool::shared();
+
+            const auto start = std::chrono::steady_clock::now();
+            pool.parallel_for(static_cast<std::size_t>(columns) * rows, [&](const std::size_t index){
+                const int x0 = static_cast<int>(index % columns) * size, y0 = static_cast<int>(index / columns) * size;
+                const auto run = [&](){ tile(pixels, width, x0, y0, std::min(x0 + size, width), std::min(y0 + size, height)); };
+                if(options.flush_denormals){
+                    const glic::flush_denormals mode;
+                    run();
+                } else {
+                    run();
+                }
+            });
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+            return frame_stats{static_cast<std::size_t>(width) * height, elapsed.count()};
+        }
+
+        template <typename Shader, typename Pixel> frame_stats render(const Shader& shader, const uniforms& inputs, Pixel* pixels, const render_options& options){
+            return run_tiles(inputs, pixels, options, [&](Pixel* pixels, const int width, const int x0, const int y0, const int x1, const int y1){
+                for(int y = y0; y < y1; ++y){
+                    Pixel* row = pixel_at(pixels, y * width);
+                    for(int x = x0; x < x1; ++x){
+                        store(pixel_at(row, x), shade(shader, vec2(x + 0.5f, y + 0.5f), inputs));
+                    }
+                }
+            });
+        }
+    };
+
+    // width * height rgba float pixels, where width and height are inputs.resolution
+    template <typename Shader> frame_stats render(const Shader& shader, const uniforms& inputs, vec4* pixels, const render_options& options = render_options()){
+        return detail::render(shader, inputs, pixels, options);
+    }
+
+    // width * height * 4 bytes, colors are clamped to [0, 1] and rounded, nan components are stored as 0
+    template <typename Shader> frame_stats render(const Shader& shader, const uniforms& inputs, std::uint8_t* pixels, const render_options& options = render_options()){
+        return detail::render(shader, inputs, pixels, options);
+    }
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,111 @@
+#ifndef GLIC_SIMD_HEADER
+#define GLIC_SIMD_HEADER
+
+// optional 4 lane float backend for the vector types
+// define GLIC_SIMD before including any glic header to enable it, otherwise the plain scalar code is used
+// every operation here is a single correctly rounded IEEE operation per lane, so results match the scalar path bit for bit
+
+#if defined(GLIC_SIMD)
+    #if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+        // AVX builds use the same intrinsics, the compiler emits the VEX encoded forms
+        #define GLIC_SIMD_SSE2
+        #include <cstring>
+        #include <emmintrin.h>
+    #elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+        #define GLIC_SIMD_NEON
+        #include <arm_neon.h>
+    #else
+        #define GLIC_SIMD_SCALAR
+    #endif
+
+    #define GLIC_VEC_ALIGN alignas(16)
+#else
+    #define GLIC_VEC_ALIGN
+#endif
+
+#if defined(GLIC_SIMD)
+namespace glic {
+    namespace simd {
+        #if defined(GLIC_SIMD_SSE2)
+            typedef __m128 f32x4;
+
+            inline f32x4 load(const float* p){ return _mm_load_ps(p); }
+            inline void store(float* p, const f32x4 v){ _mm_store_ps(p, v); }
+
+            // two lane loads duplicate (x, y) into the upper half so the unused lanes never see 0 / 0
+            // (the pair goes through memcpy, reading floats through a double pointer breaks strict aliasing)
+            inline f32x4 load2(const float* p){ double pair; std::memcpy(&pair, p, sizeof(pair)); return _mm_castpd_ps(_mm_set1_pd(pair)); }
+            inline void store2(float* p, const f32x4 v){ _mm_storel_pi(reinterpret_cast<__m64*>(p), v); }
+
+            inline f32x4 set1(const float v){ return _mm_set1_ps(v); }
+
+            inline f32x4 add(const f32x4 a, const f32x4 b){ return _mm_add_ps(a, b); }
+            inline f32x4 sub(const f32x4 a, const f32x4 b){ return _mm_sub_ps(a, b); }
+            inline f32x4 mul(const f32x4 a, const f32x4 b){ return _mm_mul_ps(a, b); }
+            inline f32x4 div(const f32x4 a, const f32x4 b){ return _mm_div_ps(a, b); }
+
+            // flip the sign bit, same as scalar negation (including for zero and nan)
+            inline f32x4 neg(const f32x4 a){ return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+
+            // min(a, b) is b < a ? b : a like std::min, which is minps with its operands swapped (the same for max)
+            inline f32x4 min(const f32x4 a, const f32x4 b){ return _mm_min_ps(b, a); }
+            inline f32x4 max(const f32x4 a, const f32x4 b){ return _mm_max_ps(b, a); }
+        #elif defined(GLIC_SIMD_NEON)
+            typedef float32x4_t f32x4;
+
+            inline f32x4 load(const float* p){ return vld1q_f32(p); }
+            inline void store(float* p, const f32x4 v){ vst1q_f32(p, v); }
+
+            inline f32x4 load2(const float* p){ const float32x2_t low = vld1_f32(p); return vcombine_f32(low, low); }
+            inline void store2(float* p, const f32x4 v){ vst1_f32(p, vget_low_f32(v)); }
+
+            inline f32x4 set1(const float v){ return vdupq_n_f32(v); }
+
+            inline f32x4 add(const f32x4 a, const f32x4 b){ return vaddq_f32(a, b); }
+            inline f32x4 sub(const f32x4 a, const f32x4 b){ return vsubq_f32(a, b); }
+            inline f32x4 mul(const f32x4 a, const f32x4 b){ return vmulq_f32(a, b); }
+
+            inline f32x4 div(const f32x4 a, const f32x4 b){
+                #if defined(__aarch64__) || defined(_M_ARM64)
+                    return vdivq_f32(a, b);
+                #else
+                    // armv7 neon only has a reciprocal estimate, which would not match the scalar path
+                    float x[4], y[4];
+                    vst1q_f32(x, a);
+                    vst1q_f32(y, b);
+                    for(int i = 0; i < 4; ++i){ x[i] /= y[i]; }
+                    return vld1q_f32(x);
+                #endif
+            }
+
+            inline f32x4 neg(const f32x4 a){ return vnegq_f32(a); }
+
+            // vminq and vmaxq treat nan and signed zeros their own way, a compare and select keeps std::min / std::max semantics
+            inline f32x4 min(const f32x4 a, const f32x4 b){ return vbslq_f32(vcltq_f32(b, a), b, a); }
+            inline f32x4 max(const f32x4 a, const f32x4 b){ return vbslq_f32(vcltq_f32(a, b), b, a); }
+        #else
+            struct f32x4 { float v[4]; };
+
+            inline f32x4 load(const float* p){ return f32x4{{p[0], p[1], p[2], p[3]}}; }
+            inline void store(float* p, const f32x4 v){ p[0] = v.v[0]; p[1] = v.v[1]; p[2] = v.v[2]; p[3] = v.v[3]; }
+
+            inline f32x4 load2(const float* p){ return f32x4{{p[0], p[1], p[0], p[1]}}; }
+            inline void store2(float* p, const f32x4 v){ p[0] = v.v[0]; p[1] = v.v[1]; }
+
+            inline f32x4 set1(const float v){ return f32x4{{v, v, v, v}}; }
+
+            inline f32x4 add(const f32x4 a, const f32x4 b){ return f32x4{{a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]}}; }
+            inline f32x4 sub(const f32x4 a, const f32x4 b){ return f32x4{{a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]}}; }
+            inline f32x4 mul(const f32x4 a, const f32x4 b){ return f32x4{{a.v[0] * b.v[0], a.v[1] * b.v[1], a.v[2] * b.v[2], a.v[3] * b.v[3]}}; }
+            inline f32x4 div(const f32x4 a, const f32x4 b){ return f32x4{{a.v[0] / b.v[0], a.v[1] / b.v[1], a.v[2] / b.v[2], a.v[3] / b.v[3]}}; }
+
+            inline f32x4 neg(const f32x4 a){ return f32x4{{-a.v[0], -a.v[1], -a.v[2], -a.v[3]}}; }
+
+            inline f32x4 min(const f32x4 a, const f32x4 b){ return f32x4{{b.v[0] < a.v[0] ? b.v[0] : a.v[0], b.v[1] < a.v[1] ? b.v[1] : a.v[1], b.v[2] < a.v[2] ? b.v[2] : a.v[2], b.v[3] < a.v[3] ? b.v[3] : a.v[3]}}; }
+            inline f32x4 max(const f32x4 a, const f32x4 b){ return f32x4{{a.v[0] < b.v[0] ? b.v[0] : a.v[0], a.v[1] < b.v[1] ? b.v[1] : a.v[1], a.v[2] < b.v[2] ? b.v[2] : a.v[2], a.v[3] < b.v[3] ? b.v[3] : a.v[3]}}; }
+        #endif
+    };
+};
+#endif
+
+#endif
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef GLIC_TABLE_HEADER
+#define GLIC_TABLE_HEADER
+
+#include <cstddef>
+#include <type_traits>
+#include "glic.h"
+
+// lookup tables baked at compile time
+// bake<N>(lo, hi, f) samples f (float to float or vecN) at N evenly spaced points of [lo, hi], and the table it returns
+// interpolates linearly between them; declared constexpr it is computed by the compiler and lives in read only data, so a
+// gradient ramp, palette or easing curve costs nothing at startup:
+//     constexpr auto ramp = glic::bake<64>(0.0f, 1.0f, [](const float t){ return mix(vec3(0.1f, 0.1f, 0.4f), vec3(1.0f, 0.8f, 0.5f), smoothstep(0.0f, 1.0f, t)); });
+//     const vec3 color = ramp(t);
+// f has to be usable in a constant expression: the GLIC_CONSTEXPR builtins always, the GLIC_CONSTEXPR_ROUND ones (abs, floor,
+// ceil, fract, mod) with any recent compiler, the rest from c++20 on (constant.h)
+// a lookup costs a multiply, two clamps and one interpolation; x outside [lo, hi] gets the end samples, nan gets the lo one
+// the interpolation error is at most (hi - lo)^2 / (8 (N - 1)^2) times the largest |f''| on [lo, hi]
+
+namespace glic {
+    template <typename T, std::size_t N> struct table {
+        static_assert(N >= 2, "a table interpolates between at least two samples");
+
+        T samples[N];
+        float lo, hi;
+
+        constexpr std::size_t size() const { return N; }
+        constexpr const T& operator[](const std::size_t i) const { return samples[i]; }
+
+        // f(x) from the two samples around x, as a + (b - a) * t rather than mix, which is std::lerp in c++20 and branches
+        constexpr T operator()(const float x) const {
+            const float last = static_cast<float>(N - 1);
+            const float position = (x - lo) * (last / (hi - lo));
+            const float t = position > 0.0f ? (position < last ? position : last) : 0.0f;
+            const std::size_t i = t < last - 1.0f ? static_cast<std::size_t>(t) : N - 2;
+            return samples[i] + (samples[i + 1] - samples[i]) * (t - static_cast<float>(i));
+        }
+    };
+
+    template <std::size_t N, typename F> constexpr auto bake(const float lo, const float hi, const F& function) -> table<typename std::decay<decltype(function(lo))>::type, N> {
+        table<typename std::decay<decltype(function(lo))>::type, N> result{};
+        result.lo = lo;
+        result.hi = hi;
+        for(std::size_t i = 0; i < N; ++i){
+            // hi itself for the last sample rather than lo plus the rounded steps
+            result.samples[i] = function(i == N - 1 ? hi : lo + (hi - lo) * (static_cast<float>(i) / static_cast<float>(N - 1)));
+        }
+        return result;
+    }
+};
+
+#endif
@@ -0,0 +1,218 @@
+#ifndef GLIC_TEXTURE_HEADER
+#define GLIC_TEXTURE_HEADER
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "glic.h"
+#include "quad.h"
+#include "thread_pool.h"
+
+// textures and the texture lookup builtins
+// a sampler2D owns a copy of its texels (rgba float) and, optionally, a mip chain, together with the filter and wrap state
+// that GL keeps in the sampler object
+// texture() on a single vec2 has no derivatives and samples the base level, as in a vertex shader; on a quad<vec2> the level
+// of detail comes from the quad's derivatives like in a fragment shader
+
+namespace glic {
+    // texel order in memory
+    // tiled stores 8 x 8 blocks of texels in morton (z) order so the 2 x 2 footprint of a bilinear fetch shares cache lines
+    // in either direction, linear is plain row major and only worth it for textures read along rows
+    enum class texture_layout { linear, tiled };
+
+    enum class texture_filter { nearest, linear };
+    enum class mipmap_filter { none, nearest, linear };
+    enum class texture_wrap { repeat, clamp_to_edge, mirrored_repeat };
+
+    // defaults follow GL's LINEAR_MIPMAP_LINEAR minification and REPEAT wrapping
+    struct sampler_state {
+        texture_filter mag = texture_filter::linear;
+        texture_filter min = texture_filter::linear;
+        mipmap_filter mip = mipmap_filter::linear;
+        texture_wrap wrap_s = texture_wrap::repeat;
+        texture_wrap wrap_t = texture_wrap::repeat;
+    };
+
+    class sampler2D {
+        public:
+            sampler_state state;
+
+            // width * height texels, row 0 is the bottom row (t = 0)
+            sampler2D(const int width, const int height, const vec4* texels, const sampler_state& state = sampler_state(), const texture_layout layout = texture_layout::tiled) : state(state), order(layout) {
+                allocate(width, height, 1);
+                for(int y = 0; y < height; ++y){
+                    for(int x = 0; x < width; ++x){ at(0, x, y) = texels[static_cast<std::size_t>(y) * width + x]; }
+                }
+            }
+
+            // width * height * 4 bytes of rgba, normalized to [0, 1]
+            sampler2D(const int width, const int height, const std::uint8_t* rgba, const sampler_state& state = sampler_state(), const texture_layout layout = texture_layout::tiled) : state(state), order(layout) {
+                allocate(width, height, 1);
+                for(int y = 0; y < height; ++y){
+                    for(int x = 0; x < width; ++x){
+                        const std::uint8_t* texel = rgba + 4 * (static_cast<std::size_t>(y) * width + x);
+                        at(0, x, y) = vec4(texel[0], texel[1], texel[2], texel[3]) / 255.0f;
+                    }
+                }
+            }
+
+            // replaces any existing chain with box filtered levels down to 1 x 1, each level's rows are split over the pool
+            void generate_mipmaps(thread_pool* pool = nullptr){
+                const std::vector<vec4> base(texels.begin(), texels.begin() + size(chain[0]));
+                const int width = chain[0].width, height = chain[0].height;
+                const int count = 1 + static_cast<int>(std::log2(static_cast<float>(std::max(width, height))));
+
+                allocate(width, height, count);
+                std::copy(base.begin(), base.end(), texels.begin());
+
+                thread_pool& workers = pool ? *pool : thread_pool::shared();
+                for(int l = 1; l < count; ++l){
+                    const level& source = chain[l - 1];
+                    workers.parallel_for(static_cast<std::size_t>(chain[l].height), [&, l](const std::size_t row){
+                        const int y = static_cast<int>(row);
+                        const int y0 = std::min(2 * y, source.height - 1), y1 = std::min(2 * y + 1, source.height - 1);
+                        for(int x = 0; x < chain[l].width; ++x){
+                            const int x0 = std::min(2 * x, source.width - 1), x1 = std::min(2 * x + 1, source.width - 1);
+                            at(l, x, y) = (at(l - 1, x0, y0) + at(l - 1, x1, y0) + at(l - 1, x0, y1) + at(l - 1, x1, y1)) * 0.25f;
+                        }
+                    });
+                }
+            }
+
+            int levels() const { return static_cast<int>(chain.size()); }
+            int width(const int lod = 0) const { return chain[lod].width; }
+            int height(const int lod = 0) const { return chain[lod].height; }
+            texture_layout layout() const { return order; }
+
+            // texel (x, y) of level lod, both inside the level
+            const vec4& fetch(const int x, const int y, const int lod) const { return texels[index(chain[lod], x, y)]; }
+
+            // filtered lookup at an explicit level of detail, as textureLod
+            vec4 sample(const vec2 uv, const float lod) const {
+                if(!(lod > 0.0f) || state.mip == mipmap_filter::none || chain.size() == 1){
+                    return filter(uv, 0, lod > 0.0f ? state.min : state.mag);
+                }
+
+                const float clamped = std::min(lod, static_cast<float>(chain.size() - 1));
+                if(state.mip == mipmap_filter::nearest){
+                    return filter(uv, static_cast<int>(clamped + 0.5f), state.min);
+                }
+
+                const int fine = static_cast<int>(clamped), coarse = std::min(fine + 1, levels() - 1);
+                return blend(filter(uv, fine, state.min), filter(uv, coarse, state.min), clamped - fine);
+            }
+
+        private:
+            struct level {
+                int width, height;
+                // tiled levels are padded to whole 8 x 8 tiles, tiles is the tile count of one row
+                int tiles;
+                std::size_t offset;
+            };
+
+            texture_layout order;
+            std::vector<level> chain;
+            std::vector<vec4> texels;
+
+            std::size_t size(const level& l) const {
+                if(order == texture_layout::linear){ return static_cast<std::size_t>(l.width) * l.height; }
+                return static_cast<std::size_t>(l.tiles) * ((l.height + 7) / 8) * 64;
+            }
+
+            void allocate(const int width, const int height, const int count){
+                chain.clear();
+                std::size_t offset = 0;
+                for(int l = 0; l < count; ++l){
+                    const level next{std::max(1, width >> l), std::max(1, height >> l), (std::max(1, width >> l) + 7) / 8, offset};
+                    chain.push_back(next);
+                    offset += size(next);
+                }
+                texels.assign(offset, vec4());
+            }
+
+            // spreads the low three bits of v to every other bit
+            static int spread(const int v){ return (v & 1) | ((v & 2) << 1) | ((v & 4) << 2); }
+
+            std::size_t index(const level& l, const int x, const int y) const {
+                if(order == texture_layout::linear){ return l.offset + static_cast<std::size_t>(y) * l.width + x; }
+                const std::size_t tile = static_cast<std::size_t>(y >> 3) * l.tiles + (x >> 3);
+                return l.offset + tile * 64 + (spread(x & 7) | (spread(y & 7) << 1));
+            }
+
+            vec4& at(const int lod, const int x, const int y){ return texels[index(chain[lod], x, y)]; }
+            const vec4& at(const int lod, const int x, const int y) const { return texels[index(chain[lod], x, y)]; }
+
+            // a floored texel coordinate as an int; past 2^24 neighbouring floats are more than a texel apart, so clamping there
+            // loses nothing a filter could use, and it keeps nan (which becomes 0) and huge uv out of the undefined conversion
+            static int texel(const float f){
+                const float limit = 16777216.0f;
+                return f > -limit ? (f < limit ? static_cast<int>(f) : static_cast<int>(limit)) : (f == f ? -static_cast<int>(limit) : 0);
+            }
+
+            // a + (b - a) * t on the vec4 operators, which are whole register operations under GLIC_SIMD (mix goes through the
+            // scalar mix per component, which is std::lerp from c++20 on)
+            static vec4 blend(const vec4& a, const vec4& b, const float t){ return a + (b - a) * t; }
+
+            static int wrap(const int i, const int n, const texture_wrap mode){
+                switch(mode){
+                    case texture_wrap::repeat: {
+                        const int r = i % n;
+                        return r < 0 ? r + n : r;
+                    }
+                    case texture_wrap::mirrored_repeat: {
+                        int r = i % (2 * n);
+                        r = r < 0 ? r + 2 * n : r;
+                        return r < n ? r : 2 * n - 1 - r;
+                    }
+                    default:
+                        return std::min(std::max(i, 0), n - 1);
+                }
+            }
+
+            vec4 filter(const vec2 uv, const int lod, const texture_filter mode) const {
+                const level& l = chain[lod];
+                const float u = uv.x * l.width, v = uv.y * l.height;
+
+                if(mode == texture_filter::nearest){
+                    const int x = wrap(texel(std::floor(u)), l.width, state.wrap_s), y = wrap(texel(std::floor(v)), l.height, state.wrap_t);
+                    return texels[index(l, x, y)];
+                }
+
+                // texel centers sit at half integers
+                const float fu = std::floor(u - 0.5f), fv = std::floor(v - 0.5f);
+                const float au = u - 0.5f - fu, av = v - 0.5f - fv;
+                const int x0 = wrap(texel(fu), l.width, state.wrap_s), x1 = wrap(texel(fu) + 1, l.width, state.wrap_s);
+                const int y0 = wrap(texel(fv), l.height, state.wrap_t), y1 = wrap(texel(fv) + 1, l.height, state.wrap_t);
+
+                // three vec4 blends, whole register operations under GLIC_SIMD
+                const vec4 bottom = blend(texels[index(l, x0, y0)], texels[index(l, x1, y0)], au);
+                const vec4 top = blend(texels[index(l, x0, y1)], texels[index(l, x1, y1)], au);
+                return blend(bottom, top, av);
+            }
+    };
+
+    inline vec4 texture(const sampler2D& sampler, const vec2 uv){ return sampler.sample(uv, 0.0f); }
+    inline vec4 texture(const sampler2D& sampler, const vec2 uv, const float bias){ return sampler.sample(uv, bias); }
+    inline vec4 textureLod(const sampler2D& sampler, const vec2 uv, const float lod){ return sampler.sample(uv, lod); }
+
+    // texel (x, y) of level lod without filtering or wrapping, both must be inside the level
+    inline vec4 texelFetch(const sampler2D& sampler, const int x, const int y, const int lod){ return sampler.fetch(x, y, lod); }
+    inline vec4 texelFetch(const sampler2D& sampler, const ivec2 texel, const int lod){ return sampler.fetch(texel.x, texel.y, lod); }
+
+    // the level of detail of every lane is log2 of the larger screen space footprint of its texel coordinates
+    inline quad<vec4> texture(const sampler2D& sampler, const quad<vec2>& uv, const float bias = 0.0f){
+        const quad<vec2> texel = uv * vec2(static_cast<float>(sampler.width()), static_cast<float>(sampler.height()));
+        const quad<float> footprint = max(dot(dFdx(texel), dFdx(texel)), dot(dFdy(texel), dFdy(texel)));
+        // log2(sqrt(f)) as 0.5 * log2(f)
+        const quad<float> lod = log2(footprint) * 0.5f + bias;
+        return per_lane([&sampler](const vec2 uv, const float lod){ return sampler.sample(uv, lod); }, uv, lod);
+    }
+
+    template <typename L> quad<vec4> textureLod(const sampler2D& sampler, const quad<vec2>& uv, const L& lod){
+        return per_lane([&sampler](const vec2 uv, const float lod){ return sampler.sample(uv, lod); }, uv, lod);
+    }
+};
+
+#endif
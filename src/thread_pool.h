@@ -0,0 +1,173 @@
+#ifndef GLIC_THREAD_POOL_HEADER
+#define GLIC_THREAD_POOL_HEADER
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace glic {
+    // persistent worker threads for data parallel loops
+    // each parallel_for splits its index range into one contiguous slot per thread, a thread works through its own slot
+    // from the front and, once that is empty, steals the back half of whichever other slot still has work
+    class thread_pool {
+        public:
+            explicit thread_pool(const std::size_t threads = std::max<std::size_t>(1, std::thread::hardware_concurrency())) : slots(threads) {
+                // the calling thread takes slot 0, so one fewer worker is needed
+                for(std::size_t i = 1; i < threads; ++i){ workers.emplace_back([this, i](){ work(i); }); }
+            }
+
+            ~thread_pool(){
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    stopping = true;
+                }
+                wake.notify_all();
+                for(std::thread& worker : workers){ worker.join(); }
+            }
+
+            thread_pool(const thread_pool&) = delete;
+            thread_pool& operator =(const thread_pool&) = delete;
+
+            // number of threads that run a parallel_for, including the caller
+            std::size_t size() const { return slots.size(); }
+
+            // calls function(i) for every i in [0, count) and returns once all calls finished, function must not throw
+            // calls from inside a running parallel_for (or from two threads at once) run the later loop serially on the caller
+            template <typename F> void parallel_for(const std::size_t count, const F& function){
+                std::unique_lock<std::mutex> running(job, std::defer_lock);
+                if(inside_job() || slots.size() == 1 || !running.try_lock()){
+                    for(std::size_t i = 0; i < count; ++i){ function(i); }
+                    return;
+                }
+
+                {
+                    std::lock_guard<std::mutex> guard(lock);
+                    invoke = [](const void* context, const std::size_t i){ (*static_cast<const F*>(context))(i); };
+                    context = &function;
+                    remaining.store(count);
+
+                    const std::size_t share = count / slots.size(), extra = count % slots.size();
+                    std::size_t begin = 0;
+                    for(std::size_t i = 0; i < slots.size(); ++i){
+                        std::lock_guard<std::mutex> slot_guard(slots[i].lock);
+                        slots[i].begin = begin;
+                        begin += share + (i < extra ? 1 : 0);
+                        slots[i].end = begin;
+                    }
+
+                    ++generation;
+                }
+                wake.notify_all();
+
+                work_slots(0);
+
+                std::unique_lock<std::mutex> guard(lock);
+                done.wait(guard, [this](){ return remaining.load() == 0 && active == 0; });
+            }
+
+            // process wide pool sized to the hardware
+            static thread_pool& shared(){
+                static thread_pool pool;
+                return pool;
+            }
+
+        private:
+            struct slot {
+                std::mutex lock;
+                std::size_t begin = 0, end = 0;
+            };
+
+            std::vector<slot> slots;
+            std::vector<std::thread> workers;
+
+            std::mutex job;
+            std::mutex lock;
+            std::condition_variable wake, done;
+
+            void (*invoke)(const void*, std::size_t) = nullptr;
+            const void* context = nullptr;
+            std::atomic<std::size_t> remaining{0};
+            std::size_t generation = 0, active = 0;
+            bool stopping = false;
+
+            static bool& inside_job(){
+                static thread_local bool inside = false;
+                return inside;
+            }
+
+            void work(const std::size_t index){
+                std::size_t seen = 0;
+                while(true){
+                    {
+                        std::unique_lock<std::mutex> guard(lock);
+                        wake.wait(guard, [&](){ return stopping || generation != seen; });
+                        if(stopping){ return; }
+                        seen = generation;
+                        ++active;
+                    }
+
+                    work_slots(index);
+
+                    {
+                        std::lock_guard<std::mutex> guard(lock);
+                        --active;
+                    }
+                    done.notify_all();
+                }
+            }
+
+            void work_slots(const std::size_t index){
+                inside_job() = true;
+
+                std::size_t i;
+                while(take(index, i) || steal(index, i)){
+                    invoke(context, i);
+                    if(remaining.fetch_sub(1) == 1){
+                        std::lock_guard<std::mutex> guard(lock);
+                        done.notify_all();
+                    }
+                }
+
+                inside_job() = false;
+            }
+
+            // next index from the front of this thread's own slot
+            bool take(const std::size_t index, std::size_t& i){
+                slot& own = slots[index];
+                std::lock_guard<std::mutex> guard(own.lock);
+                if(own.begin == own.end){ return false; }
+                i = own.begin++;
+                return true;
+            }
+
+            // moves the back half of another slot into this thread's slot, then takes from it
+            bool steal(const std::size_t index, std::size_t& i){
+                for(std::size_t offset = 1; offset < slots.size(); ++offset){
+                    slot& victim = slots[(index + offset) % slots.size()];
+                    std::size_t begin, end;
+                    {
+                        std::lock_guard<std::mutex> guard(victim.lock);
+                        if(victim.begin == victim.end){ continue; }
+                        const std::size_t half = (victim.end - victim.begin + 1) / 2;
+                        end = victim.end;
+                        begin = end - half;
+                        victim.end = begin;
+                    }
+
+                    slot& own = slots[index];
+                    std::lock_guard<std::mutex> guard(own.lock);
+                    own.begin = begin + 1;
+                    own.end = end;
+                    i = begin;
+                    return true;
+                }
+                return false;
+            }
+    };
+};
+
+#endif
\ No newline at end of file
@@ -1,8 +1,24 @@
 #ifndef GLIC_VEC_HEADER
 #define GLIC_VEC_HEADER
 
+#include "constant.h"
+#include "simd.h"
+
+// under GLIC_SIMD the operators below are whole register operations, with the scalar code after them as their twin for
+// constant evaluation (c++20, see constant.h); without GLIC_SIMD only the scalar code is there
+#if defined(GLIC_SIMD)
+    #define GLIC_SIMD_LANES(target, expression) if(!glic::detail::constant_evaluated()){ return target.lanes(expression); }
+#else
+    #define GLIC_SIMD_LANES(target, expression)
+#endif
+
 namespace glic {
-    // function pointer aliases
+    // integer and bool vectors (ivec.h), which the float vectors convert from
+    template <typename T> struct tvec2;
+    template <typename T> struct tvec3;
+    template <typename T> struct tvec4;
+
+    // scalar function signatures, taken as template arguments so every lane is a direct (inlinable) call
     typedef float gl1float(float);
     typedef float gl2float(float, float);
 
@@ -10,146 +26,217 @@ namespace glic {
     struct vec2 {
         float x, y;
 
-        vec2(float x) : x(x), y(x) {}
-        vec2(float x, float y) : x(x), y(y) {}
+        constexpr vec2() : x(0), y(0) {}
+        constexpr vec2(float x) : x(x), y(x) {}
+        constexpr vec2(float x, float y) : x(x), y(y) {}
+
+        // componentwise conversion of an ivec2, uvec2 or bvec2
+        template <typename T> constexpr explicit vec2(const tvec2<T>& v) : vec2(static_cast<float>(v.x), static_cast<float>(v.y)) {}
 
         // helpers
-        vec2 apply(gl1float* function) const { return vec2(function(x), function(y)); }
-        static vec2 zip(const gl2float *function, const vec2& x, const vec2& y){ return vec2(function(x.x, y.x), function(x.y, y.y)); }
+        template <gl1float* function> constexpr vec2 apply() const { return vec2(function(x), function(y)); }
+        template <gl2float* function> static constexpr vec2 zip(const vec2& x, const vec2& y){ return vec2(function(x.x, y.x), function(x.y, y.y)); }
+
+        template <typename F> constexpr vec2 apply(const F& function) const { return vec2(function(x), function(y)); }
+        template <typename F> static constexpr vec2 zip(const F& function, const vec2& x, const vec2& y){ return vec2(function(x.x, y.x), function(x.y, y.y)); }
+
+        // lanes of a where condition (a bvec2, or one bool for every lane) is set and of b elsewhere
+        // both sides are already evaluated, so the per lane choices compile to conditional moves or blends rather than branches
+        template <typename B> static constexpr vec2 select(const B& condition, const vec2& a, const vec2& b){ return vec2(condition.x ? a.x : b.x, condition.y ? a.y : b.y); }
+        static constexpr vec2 select(const bool condition, const vec2& a, const vec2& b){ return vec2(condition ? a.x : b.x, condition ? a.y : b.y); }
+
+        // min and max with std::min and std::max semantics, as conditional moves (two lanes do not pay for a register round
+        // trip, unlike vec3 and vec4 under GLIC_SIMD)
+        static constexpr vec2 min(const vec2& a, const vec2& b){ return vec2(b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y); }
+        static constexpr vec2 max(const vec2& a, const vec2& b){ return vec2(a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y); }
 
         // overloads
-        vec2& operator +=(const float v){ x += v; y += v; return *this; }
-        vec2& operator +=(const vec2& v){ x += v.x; y += v.y; return *this; }
-        
-        vec2& operator -=(const float v){ x -= v; y -= v; return *this; }
-        vec2& operator -=(const vec2& v){ x -= v.x; y -= v.y; return *this; }
+        #if defined(GLIC_SIMD)
+            simd::f32x4 lanes() const { return simd::load2(&x); }
+            vec2& lanes(const simd::f32x4 v){ simd::store2(&x, v); return *this; }
+        #endif
+
+        GLIC_CONSTEXPR vec2& operator +=(const float v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), simd::set1(v))) x += v; y += v; return *this; }
+        GLIC_CONSTEXPR vec2& operator +=(const vec2& v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), v.lanes())) x += v.x; y += v.y; return *this; }
+
+        GLIC_CONSTEXPR vec2& operator -=(const float v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), simd::set1(v))) x -= v; y -= v; return *this; }
+        GLIC_CONSTEXPR vec2& operator -=(const vec2& v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), v.lanes())) x -= v.x; y -= v.y; return *this; }
 
-        vec2& operator *=(const float v){ x *= v; y *= v; return *this; }
-        vec2& operator *=(const vec2& v){ x *= v.x; y *= v.y; return *this; }
+        GLIC_CONSTEXPR vec2& operator *=(const float v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), simd::set1(v))) x *= v; y *= v; return *this; }
+        GLIC_CONSTEXPR vec2& operator *=(const vec2& v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), v.lanes())) x *= v.x; y *= v.y; return *this; }
 
-        vec2& operator /=(const float v){ x /= v; y /= v; return *this; }
-        vec2& operator /=(const vec2& v){ x /= v.x; y /= v.y; return *this; }
+        GLIC_CONSTEXPR vec2& operator /=(const float v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), simd::set1(v))) x /= v; y /= v; return *this; }
+        GLIC_CONSTEXPR vec2& operator /=(const vec2& v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), v.lanes())) x /= v.x; y /= v.y; return *this; }
 
-        vec2 operator +(const float v) const { vec2 self(*this); self += v; return self; }
-        vec2 operator +(const vec2& v) const { vec2 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec2 operator +(const float v) const { vec2 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec2 operator +(const vec2& v) const { vec2 self(*this); self += v; return self; }
 
-        vec2 operator -(const float v) const { vec2 self(*this); self -= v; return self; }
-        vec2 operator -(const vec2& v) const { vec2 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec2 operator -(const float v) const { vec2 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec2 operator -(const vec2& v) const { vec2 self(*this); self -= v; return self; }
 
-        vec2 operator *(const float v) const { vec2 self(*this); self *= v; return self; }
-        vec2 operator *(const vec2& v) const { vec2 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec2 operator *(const float v) const { vec2 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec2 operator *(const vec2& v) const { vec2 self(*this); self *= v; return self; }
 
-        vec2 operator /(const float v) const { vec2 self(*this); self /= v; return self; }
-        vec2 operator /(const vec2& v) const { vec2 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec2 operator /(const float v) const { vec2 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec2 operator /(const vec2& v) const { vec2 self(*this); self /= v; return self; }
 
-        vec2& operator++(){ ++x; ++y; return *this; }
-        vec2 operator++(int){ vec2 copy(*this); ++x; ++y; return copy; }
-        vec2& operator--(){ --x; --y; return *this; }
-        vec2 operator--(int){ vec2 copy(*this); --x; --y; return copy; }
+        GLIC_CONSTEXPR vec2& operator++(){ return *this += 1.0f; }
+        GLIC_CONSTEXPR vec2 operator++(int){ vec2 copy(*this); *this += 1.0f; return copy; }
+        GLIC_CONSTEXPR vec2& operator--(){ return *this -= 1.0f; }
+        GLIC_CONSTEXPR vec2 operator--(int){ vec2 copy(*this); *this -= 1.0f; return copy; }
 
-        vec2 operator -() const { return vec2(-x, -y); }
+        GLIC_CONSTEXPR vec2 operator -() const { GLIC_SIMD_LANES(vec2(*this), simd::neg(lanes())) return vec2(-x, -y); }
     };
 
-    vec2 operator +(const float v, const vec2& vec){ return vec2(vec.x + v, vec.y + v); }
-    vec2 operator -(const float v, const vec2& vec){ return vec2(vec.x - v, vec.y - v); }
-    vec2 operator *(const float v, const vec2& vec){ return vec2(vec.x * v, vec.y * v); }
-    vec2 operator /(const float v, const vec2& vec){ return vec2(vec.x / v, vec.y / v); }
+    GLIC_CONSTEXPR vec2 operator +(const float v, const vec2& vec){ return vec2(v) += vec; }
+    GLIC_CONSTEXPR vec2 operator -(const float v, const vec2& vec){ return vec2(v) -= vec; }
+    GLIC_CONSTEXPR vec2 operator *(const float v, const vec2& vec){ return vec2(v) *= vec; }
+    GLIC_CONSTEXPR vec2 operator /(const float v, const vec2& vec){ return vec2(v) /= vec; }
 
-    struct vec3 {
+    struct GLIC_VEC_ALIGN vec3 {
         float x, y, z;
-        
-        vec3(float x) : x(x), y(x), z(x) {}
-        vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+
+        #if defined(GLIC_SIMD)
+            // pads vec3 to 16 bytes, starts out as a copy of z so the spare lane only computes what z already does
+            float padding;
+
+            constexpr vec3() : x(0), y(0), z(0), padding(0) {}
+            constexpr vec3(float x) : x(x), y(x), z(x), padding(x) {}
+            constexpr vec3(float x, float y, float z) : x(x), y(y), z(z), padding(z) {}
+        #else
+            constexpr vec3() : x(0), y(0), z(0) {}
+            constexpr vec3(float x) : x(x), y(x), z(x) {}
+            constexpr vec3(float x, float y, float z) : x(x), y(y), z(z) {}
+        #endif
+
+        // componentwise conversion of an ivec3, uvec3 or bvec3
+        template <typename T> constexpr explicit vec3(const tvec3<T>& v) : vec3(static_cast<float>(v.x), static_cast<float>(v.y), static_cast<float>(v.z)) {}
 
         // helpers
-        vec3 apply(const gl1float* function) const { return vec3(function(x), function(y), function(z)); }
-        static vec3 zip(const gl2float *function, const vec3& x, const vec3& y){ return vec3(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z)); }
+        template <gl1float* function> constexpr vec3 apply() const { return vec3(function(x), function(y), function(z)); }
+        template <gl2float* function> static constexpr vec3 zip(const vec3& x, const vec3& y){ return vec3(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z)); }
+
+        template <typename F> constexpr vec3 apply(const F& function) const { return vec3(function(x), function(y), function(z)); }
+        template <typename F> static constexpr vec3 zip(const F& function, const vec3& x, const vec3& y){ return vec3(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z)); }
+
+        // branch free lane selection as for vec2, min and max are whole register operations under GLIC_SIMD
+        template <typename B> static constexpr vec3 select(const B& condition, const vec3& a, const vec3& b){ return vec3(condition.x ? a.x : b.x, condition.y ? a.y : b.y, condition.z ? a.z : b.z); }
+        static constexpr vec3 select(const bool condition, const vec3& a, const vec3& b){ return vec3(condition ? a.x : b.x, condition ? a.y : b.y, condition ? a.z : b.z); }
+
+        static GLIC_CONSTEXPR vec3 min(const vec3& a, const vec3& b){ GLIC_SIMD_LANES(vec3(), simd::min(a.lanes(), b.lanes())) return vec3(b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y, b.z < a.z ? b.z : a.z); }
+        static GLIC_CONSTEXPR vec3 max(const vec3& a, const vec3& b){ GLIC_SIMD_LANES(vec3(), simd::max(a.lanes(), b.lanes())) return vec3(a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y, a.z < b.z ? b.z : a.z); }
 
         // overloads
-        vec3& operator +=(const float v){ x += v; y += v; z += v; return *this; }
-        vec3& operator +=(const vec3& v){ x += v.x; y += v.y; z += v.z; return *this; }
-        
-        vec3& operator -=(const float v){ x -= v; y -= v; z -= v; return *this; }
-        vec3& operator -=(const vec3& v){ x -= v.x; y -= v.y; z -= v.z; return *this; }
+        #if defined(GLIC_SIMD)
+            simd::f32x4 lanes() const { return simd::load(&x); }
+            vec3& lanes(const simd::f32x4 v){ simd::store(&x, v); return *this; }
+        #endif
 
-        vec3& operator *=(const float v){ x *= v; y *= v; z *= v; return *this; }
-        vec3& operator *=(const vec3& v){ x *= v.x; y *= v.y; z *= v.z; return *this; }
+        GLIC_CONSTEXPR vec3& operator +=(const float v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), simd::set1(v))) x += v; y += v; z += v; return *this; }
+        GLIC_CONSTEXPR vec3& operator +=(const vec3& v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), v.lanes())) x += v.x; y += v.y; z += v.z; return *this; }
 
-        vec3& operator /=(const float v){ x /= v; y /= v; z /= v; return *this; }
-        vec3& operator /=(const vec3& v){ x /= v.x; y /= v.y; z /= v.z; return *this; }
+        GLIC_CONSTEXPR vec3& operator -=(const float v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), simd::set1(v))) x -= v; y -= v; z -= v; return *this; }
+        GLIC_CONSTEXPR vec3& operator -=(const vec3& v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), v.lanes())) x -= v.x; y -= v.y; z -= v.z; return *this; }
 
-        vec3 operator +(const float v) const { vec3 self(*this); self += v; return self; }
-        vec3 operator +(const vec3& v) const { vec3 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec3& operator *=(const float v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), simd::set1(v))) x *= v; y *= v; z *= v; return *this; }
+        GLIC_CONSTEXPR vec3& operator *=(const vec3& v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), v.lanes())) x *= v.x; y *= v.y; z *= v.z; return *this; }
 
-        vec3 operator -(const float v) const { vec3 self(*this); self -= v; return self; }
-        vec3 operator -(const vec3& v) const { vec3 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec3& operator /=(const float v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), simd::set1(v))) x /= v; y /= v; z /= v; return *this; }
+        GLIC_CONSTEXPR vec3& operator /=(const vec3& v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), v.lanes())) x /= v.x; y /= v.y; z /= v.z; return *this; }
 
-        vec3 operator *(const float v) const { vec3 self(*this); self *= v; return self; }
-        vec3 operator *(const vec3& v) const { vec3 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec3 operator +(const float v) const { vec3 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec3 operator +(const vec3& v) const { vec3 self(*this); self += v; return self; }
 
-        vec3 operator /(const float v) const { vec3 self(*this); self /= v; return self; }
-        vec3 operator /(const vec3& v) const { vec3 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec3 operator -(const float v) const { vec3 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec3 operator -(const vec3& v) const { vec3 self(*this); self -= v; return self; }
 
-        vec3& operator++(){ ++x; ++y; ++z; return *this; }
-        vec3 operator++(int){ vec3 copy(*this); ++x; ++y; ++z;return copy; }
-        vec3& operator--(){ --x; --y; --z; return *this; }
-        vec3 operator--(int){ vec3 copy(*this); --x; --y; --z; return copy; }
+        GLIC_CONSTEXPR vec3 operator *(const float v) const { vec3 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec3 operator *(const vec3& v) const { vec3 self(*this); self *= v; return self; }
 
-        vec3 operator -() const { return vec3(-x, -y, -z); }
+        GLIC_CONSTEXPR vec3 operator /(const float v) const { vec3 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec3 operator /(const vec3& v) const { vec3 self(*this); self /= v; return self; }
+
+        GLIC_CONSTEXPR vec3& operator++(){ return *this += 1.0f; }
+        GLIC_CONSTEXPR vec3 operator++(int){ vec3 copy(*this); *this += 1.0f; return copy; }
+        GLIC_CONSTEXPR vec3& operator--(){ return *this -= 1.0f; }
+        GLIC_CONSTEXPR vec3 operator--(int){ vec3 copy(*this); *this -= 1.0f; return copy; }
+
+        GLIC_CONSTEXPR vec3 operator -() const { GLIC_SIMD_LANES(vec3(*this), simd::neg(lanes())) return vec3(-x, -y, -z); }
     };
 
-    vec3 operator +(const float v, const vec3& vec){ return vec3(vec.x + v, vec.y + v, vec.z + v); }
-    vec3 operator -(const float v, const vec3& vec){ return vec3(vec.x - v, vec.y - v, vec.z - v); }
-    vec3 operator *(const float v, const vec3& vec){ return vec3(vec.x * v, vec.y * v, vec.z * v); }
-    vec3 operator /(const float v, const vec3& vec){ return vec3(vec.x / v, vec.y / v, vec.z / v); }
+    GLIC_CONSTEXPR vec3 operator +(const float v, const vec3& vec){ return vec3(v) += vec; }
+    GLIC_CONSTEXPR vec3 operator -(const float v, const vec3& vec){ return vec3(v) -= vec; }
+    GLIC_CONSTEXPR vec3 operator *(const float v, const vec3& vec){ return vec3(v) *= vec; }
+    GLIC_CONSTEXPR vec3 operator /(const float v, const vec3& vec){ return vec3(v) /= vec; }
 
-    struct vec4 {
+    struct GLIC_VEC_ALIGN vec4 {
         float x, y, z, w;
 
-        vec4(float x) : x(x), y(x), z(x), w(x) {}
-        vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+        constexpr vec4() : x(0), y(0), z(0), w(0) {}
+        constexpr vec4(float x) : x(x), y(x), z(x), w(x) {}
+        constexpr vec4(float x, float y, float z, float w) : x(x), y(y), z(z), w(w) {}
+
+        // componentwise conversion of an ivec4, uvec4 or bvec4
+        template <typename T> constexpr explicit vec4(const tvec4<T>& v) : vec4(static_cast<float>(v.x), static_cast<float>(v.y), static_cast<float>(v.z), static_cast<float>(v.w)) {}
 
         // helpers
-        vec4 apply(gl1float *function) const { return vec4(function(x), function(y), function(z), function(w)); }
-        static vec4 zip(const gl2float *function, const vec4& x, const vec4& y){ return vec4(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z), function(x.w, y.w)); }
+        template <gl1float* function> constexpr vec4 apply() const { return vec4(function(x), function(y), function(z), function(w)); }
+        template <gl2float* function> static constexpr vec4 zip(const vec4& x, const vec4& y){ return vec4(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z), function(x.w, y.w)); }
+
+        template <typename F> constexpr vec4 apply(const F& function) const { return vec4(function(x), function(y), function(z), function(w)); }
+        template <typename F> static constexpr vec4 zip(const F& function, const vec4& x, const vec4& y){ return vec4(function(x.x, y.x), function(x.y, y.y), function(x.z, y.z), function(x.w, y.w)); }
+
+        // branch free lane selection as for vec2, min and max are whole register operations under GLIC_SIMD
+        template <typename B> static constexpr vec4 select(const B& condition, const vec4& a, const vec4& b){ return vec4(condition.x ? a.x : b.x, condition.y ? a.y : b.y, condition.z ? a.z : b.z, condition.w ? a.w : b.w); }
+        static constexpr vec4 select(const bool condition, const vec4& a, const vec4& b){ return vec4(condition ? a.x : b.x, condition ? a.y : b.y, condition ? a.z : b.z, condition ? a.w : b.w); }
+
+        static GLIC_CONSTEXPR vec4 min(const vec4& a, const vec4& b){ GLIC_SIMD_LANES(vec4(), simd::min(a.lanes(), b.lanes())) return vec4(b.x < a.x ? b.x : a.x, b.y < a.y ? b.y : a.y, b.z < a.z ? b.z : a.z, b.w < a.w ? b.w : a.w); }
+        static GLIC_CONSTEXPR vec4 max(const vec4& a, const vec4& b){ GLIC_SIMD_LANES(vec4(), simd::max(a.lanes(), b.lanes())) return vec4(a.x < b.x ? b.x : a.x, a.y < b.y ? b.y : a.y, a.z < b.z ? b.z : a.z, a.w < b.w ? b.w : a.w); }
 
         // overloads
-        vec4& operator +=(const float v){ x += v; y += v; z += v; w += v; return *this; }
-        vec4& operator +=(const vec4& v){ x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
-        
-        vec4& operator -=(const float v){ x -= v; y -= v; z -= v; w -= v; return *this; }
-        vec4& operator -=(const vec4& v){ x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
+        #if defined(GLIC_SIMD)
+            simd::f32x4 lanes() const { return simd::load(&x); }
+            vec4& lanes(const simd::f32x4 v){ simd::store(&x, v); return *this; }
+        #endif
 
-        vec4& operator *=(const float v){ x *= v; y *= v; z *= v; w *= v; return *this; }
-        vec4& operator *=(const vec4& v){ x *= v.x; y *= v.y; z *= v.z; w *= v.w; return *this; }
+        GLIC_CONSTEXPR vec4& operator +=(const float v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), simd::set1(v))) x += v; y += v; z += v; w += v; return *this; }
+        GLIC_CONSTEXPR vec4& operator +=(const vec4& v){ GLIC_SIMD_LANES((*this), simd::add(lanes(), v.lanes())) x += v.x; y += v.y; z += v.z; w += v.w; return *this; }
 
-        vec4& operator /=(const float v){ x /= v; y /= v; z /= v; w /= v; return *this; }
-        vec4& operator /=(const vec4& v){ x /= v.x; y /= v.y; z /= v.z; w /= v.w; return *this; }
+        GLIC_CONSTEXPR vec4& operator -=(const float v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), simd::set1(v))) x -= v; y -= v; z -= v; w -= v; return *this; }
+        GLIC_CONSTEXPR vec4& operator -=(const vec4& v){ GLIC_SIMD_LANES((*this), simd::sub(lanes(), v.lanes())) x -= v.x; y -= v.y; z -= v.z; w -= v.w; return *this; }
 
-        vec4 operator +(const float v) const { vec4 self(*this); self += v; return self; }
-        vec4 operator +(const vec4& v) const { vec4 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec4& operator *=(const float v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), simd::set1(v))) x *= v; y *= v; z *= v; w *= v; return *this; }
+        GLIC_CONSTEXPR vec4& operator *=(const vec4& v){ GLIC_SIMD_LANES((*this), simd::mul(lanes(), v.lanes())) x *= v.x; y *= v.y; z *= v.z; w *= v.w; return *this; }
 
-        vec4 operator -(const float v) const { vec4 self(*this); self -= v; return self; }
-        vec4 operator -(const vec4& v) const { vec4 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec4& operator /=(const float v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), simd::set1(v))) x /= v; y /= v; z /= v; w /= v; return *this; }
+        GLIC_CONSTEXPR vec4& operator /=(const vec4& v){ GLIC_SIMD_LANES((*this), simd::div(lanes(), v.lanes())) x /= v.x; y /= v.y; z /= v.z; w /= v.w; return *this; }
 
-        vec4 operator *(const float v) const { vec4 self(*this); self *= v; return self; }
-        vec4 operator *(const vec4& v) const { vec4 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec4 operator +(const float v) const { vec4 self(*this); self += v; return self; }
+        GLIC_CONSTEXPR vec4 operator +(const vec4& v) const { vec4 self(*this); self += v; return self; }
 
-        vec4 operator /(const float v) const { vec4 self(*this); self /= v; return self; }
-        vec4 operator /(const vec4& v) const { vec4 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec4 operator -(const float v) const { vec4 self(*this); self -= v; return self; }
+        GLIC_CONSTEXPR vec4 operator -(const vec4& v) const { vec4 self(*this); self -= v; return self; }
 
-        vec4& operator++(){ ++x; ++y; ++z; ++w; return *this; }
-        vec4 operator++(int){ vec4 copy(*this); ++x; ++y; ++z; ++w; return copy; }
-        vec4& operator--(){ --x; --y; --z; --w; return *this; }
-        vec4 operator--(int){ vec4 copy(*this); --x; --y; --z; --w; return copy; }
+        GLIC_CONSTEXPR vec4 operator *(const float v) const { vec4 self(*this); self *= v; return self; }
+        GLIC_CONSTEXPR vec4 operator *(const vec4& v) const { vec4 self(*this); self *= v; return self; }
 
-        vec4 operator -() const { return vec4(-x, -y, -z, -w); }
+        GLIC_CONSTEXPR vec4 operator /(const float v) const { vec4 self(*this); self /= v; return self; }
+        GLIC_CONSTEXPR vec4 operator /(const vec4& v) const { vec4 self(*this); self /= v; return self; }
+
+        GLIC_CONSTEXPR vec4& operator++(){ return *this += 1.0f; }
+        GLIC_CONSTEXPR vec4 operator++(int){ vec4 copy(*this); *this += 1.0f; return copy; }
+        GLIC_CONSTEXPR vec4& operator--(){ return *this -= 1.0f; }
+        GLIC_CONSTEXPR vec4 operator--(int){ vec4 copy(*this); *this -= 1.0f; return copy; }
+
+        GLIC_CONSTEXPR vec4 operator -() const { GLIC_SIMD_LANES(vec4(*this), simd::neg(lanes())) return vec4(-x, -y, -z, -w); }
     };
     
-    vec4 operator +(const float v, const vec4& vec){ return vec4(vec.x + v, vec.y + v, vec.z + v, vec.w + v); }
-    vec4 operator -(const float v, const vec4& vec){ return vec4(vec.x - v, vec.y - v, vec.z - v, vec.w - v); }
-    vec4 operator *(const float v, const vec4& vec){ return vec4(vec.x * v, vec.y * v, vec.z * v, vec.w * v); }
-    vec4 operator /(const float v, const vec4& vec){ return vec4(vec.x / v, vec.y / v, vec.z / v, vec.w / v); }
+    GLIC_CONSTEXPR vec4 operator +(const float v, const vec4& vec){ return vec4(v) += vec; }
+    GLIC_CONSTEXPR vec4 operator -(const float v, const vec4& vec){ return vec4(v) -= vec; }
+    GLIC_CONSTEXPR vec4 operator *(const float v, const vec4& vec){ return vec4(v) *= vec; }
+    GLIC_CONSTEXPR vec4 operator /(const float v, const vec4& vec){ return vec4(v) /= vec; }
 };
 
+#undef GLIC_SIMD_LANES
+
 #endif
\ No newline at end of file
@@ -0,0 +1,93 @@
+// the fast tier polynomials against the double precision libm results, within the bounds tabulated at the top of approx.h,
+// and the edge behaviour listed there (underflow to zero, overflow to inf, pow of zero)
+// the domains are sampled evenly over their float values rather than walked exhaustively, glic_accuracy --exhaustive does that
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "approx.h"
+#include "check.h"
+
+using namespace glic;
+
+namespace {
+    const int samples = 1 << 16;
+
+    // float spacing at the magnitude of reference, down to the denormal spacing
+    double ulp(const double reference){
+        int exponent;
+        std::frexp(reference, &exponent);
+        return std::ldexp(1.0, (exponent - 1 < -126 ? -126 : exponent - 1) - 23);
+    }
+
+    // floats in order as integers, so even steps between two of them visit the float values evenly
+    std::int64_t ordered(const float x){
+        const std::uint32_t u = test::bits(x);
+        return (u & 0x80000000u) ? -static_cast<std::int64_t>(u & 0x7fffffffu) : static_cast<std::int64_t>(u);
+    }
+
+    float from_ordered(const std::int64_t o){
+        const std::uint32_t u = o < 0 ? (0x80000000u | static_cast<std::uint32_t>(-o)) : static_cast<std::uint32_t>(o);
+        float x;
+        std::memcpy(&x, &u, sizeof(x));
+        return x;
+    }
+
+    // largest error over the domain, in ulp of the reference or absolute, with both ends included
+    template <typename F, typename R> double worst_error(const char* name, const float lo, const float hi, const bool absolute, const F& function, const R& reference){
+        const std::int64_t first = ordered(lo), span = ordered(hi) - first;
+        double worst = 0.0, worst_x = 0.0;
+        for(int i = 0; i < samples; ++i){
+            const float x = from_ordered(first + static_cast<std::int64_t>(static_cast<double>(span) * i / (samples - 1)));
+            const double expected = reference(static_cast<double>(x)), difference = std::fabs(static_cast<double>(function(x)) - expected);
+            const double error = absolute ? difference : difference / ulp(expected);
+            if(!(error <= worst)){ worst = error; worst_x = x; }
+        }
+        std::printf("%-12s [%g, %g] %s %.3g at %a\n", name, lo, hi, absolute ? "absolute" : "ulp", worst, worst_x);
+        return worst;
+    }
+
+    double ulps(const char* name, const float lo, const float hi, float (*function)(float), double (*reference)(double)){ return worst_error(name, lo, hi, false, function, reference); }
+    double absolute(const char* name, const float lo, const float hi, float (*function)(float), double (*reference)(double)){ return worst_error(name, lo, hi, true, function, reference); }
+
+    double inverse_sqrt(const double x){ return 1.0 / std::sqrt(x); }
+};
+
+int main(){
+    const float pi = 3.14159265f, smallest = std::numeric_limits<float>::min(), largest = std::numeric_limits<float>::max();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    GLIC_CHECK(ulps("sin", -pi, pi, approx::sin, std::sin) <= 1.5);
+    GLIC_CHECK(ulps("cos", -pi, pi, approx::cos, std::cos) <= 1.5);
+    GLIC_CHECK(absolute("sin", -8192.0f, 8192.0f, approx::sin, std::sin) <= 7.9e-8);
+    GLIC_CHECK(absolute("cos", -8192.0f, 8192.0f, approx::cos, std::cos) <= 7.9e-8);
+
+    GLIC_CHECK(ulps("exp", -105.0f, 88.7f, approx::exp, std::exp) <= 1.0);
+    GLIC_CHECK(ulps("exp2", -151.0f, 127.99f, approx::exp2, std::exp2) <= 1.3);
+    GLIC_CHECK(ulps("log", smallest, largest, approx::log, std::log) <= 0.9);
+    GLIC_CHECK(ulps("log2", smallest, largest, approx::log2, std::log2) <= 1.5);
+    GLIC_CHECK(ulps("inversesqrt", smallest, largest, approx::inversesqrt, inverse_sqrt) <= 3.2);
+
+    // beyond the bounded domains exp and exp2 round to zero or overflow by themselves
+    GLIC_CHECK(approx::exp(-106.0f) == 0.0f && approx::exp(-1e30f) == 0.0f);
+    GLIC_CHECK(approx::exp(89.0f) == inf && approx::exp(1e30f) == inf);
+    GLIC_CHECK(approx::exp2(-152.0f) == 0.0f && approx::exp2(-1e30f) == 0.0f);
+    GLIC_CHECK(approx::exp2(128.0f) == inf && approx::exp2(1e30f) == inf);
+
+    // integer powers of two are exact, as the polynomial is 1 at 0
+    for(int n = -149; n < 128; ++n){ GLIC_CHECK(approx::exp2(static_cast<float>(n)) == std::ldexp(1.0f, n)); }
+
+    // nan and huge arguments are unspecified, but the conversions to int stay defined (run under -fsanitize=float-cast-overflow)
+    // and a nan comes through the reductions as nan
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    GLIC_CHECK(std::isnan(approx::sin(nan)) && std::isnan(approx::cos(nan)) && std::isnan(approx::exp(nan)) && std::isnan(approx::exp2(nan)));
+    volatile float sink = approx::sin(1e30f) + approx::cos(-3e9f) + approx::tan(largest) + approx::sin(-inf);
+    static_cast<void>(sink);
+
+    GLIC_CHECK(approx::pow(0.0f, 2.0f) == 0.0f);
+    GLIC_CHECK(std::fabs(approx::pow(2.0f, 10.0f) - 1024.0f) <= 1024.0f * 4e-7f);
+
+    return test::result();
+}
@@ -0,0 +1,152 @@
+// the batch kernels, over arrays of structs and structures of arrays, against the per element builtins of glic.h, bit for
+// bit and at every dispatch level the cpu has, and the to_soa / to_aos round trips; the refract inputs are mostly past the
+// critical angle for the larger ratios, where the result has to be +0 like glic::refract's and not the -0 or nan a multiply
+// by the lane mask gives
+
+#include <cstdio>
+#include <cstdint>
+#include <vector>
+#include "batch.h"
+#include "check.h"
+
+using namespace glic;
+
+namespace {
+    bool same(const vec2& a, const vec2& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y); }
+    bool same(const vec3& a, const vec3& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z); }
+    bool same(const vec4& a, const vec4& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z) && test::same_bits(a.w, b.w); }
+
+    vec2 make(test::random& r, vec2*){ return vec2(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+    vec3 make(test::random& r, vec3*){ return vec3(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+    vec4 make(test::random& r, vec4*){ return vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+
+    template <typename T> struct soa;
+    template <> struct soa<vec2> { typedef batch::vec2_soa type; };
+    template <> struct soa<vec3> { typedef batch::vec3_soa type; };
+    template <> struct soa<vec4> { typedef batch::vec4_soa type; };
+
+    template <typename T> void compare(const char* what, const typename soa<T>::type& result, const std::vector<T>& expected){
+        int mismatches = 0;
+        for(std::size_t i = 0; i < expected.size(); ++i){ mismatches += !same(result[i], expected[i]); }
+        GLIC_CHECK_NONE_DIFFER(what, mismatches, expected.size(), dispatch::name(dispatch::selected()));
+    }
+
+    template <typename T> void compare(const char* what, const std::vector<T>& result, const std::vector<T>& expected){
+        int mismatches = 0;
+        for(std::size_t i = 0; i < expected.size(); ++i){ mismatches += !same(result[i], expected[i]); }
+        GLIC_CHECK_NONE_DIFFER(what, mismatches, expected.size(), dispatch::name(dispatch::selected()));
+    }
+
+    void compare(const char* what, const std::vector<float>& result, const std::vector<float>& expected){
+        int mismatches = 0;
+        for(std::size_t i = 0; i < expected.size(); ++i){ mismatches += !test::same_bits(result[i], expected[i]); }
+        GLIC_CHECK_NONE_DIFFER(what, mismatches, expected.size(), dispatch::name(dispatch::selected()));
+    }
+
+    template <typename T> void kernels(){
+        const std::size_t n = 4096;
+        test::random r;
+        std::vector<T> incident(n), normal(n);
+        for(std::size_t k = 0; k < n; ++k){
+            incident[k] = normalize(make(r, static_cast<T*>(nullptr)));
+            normal[k] = normalize(make(r, static_cast<T*>(nullptr)));
+        }
+        const typename soa<T>::type i(incident), m(normal);
+        typename soa<T>::type out(n);
+
+        std::vector<T> scaled(n), expected(n);
+        for(std::size_t k = 0; k < n; ++k){
+            scaled[k] = incident[k] * 3.0f;
+            expected[k] = normalize(scaled[k]);
+        }
+        batch::normalize(typename soa<T>::type(scaled), out);
+        compare<T>("batch::normalize", out, expected);
+
+        for(const float eta : {0.5f, 1.0f / 1.33f, 1.33f, 2.5f}){
+            for(std::size_t k = 0; k < n; ++k){ expected[k] = refract(incident[k], normal[k], eta); }
+            batch::refract(i, m, eta, out);
+            compare<T>("batch::refract", out, expected);
+        }
+
+        // the rest once over the array of structs and once over the structure of arrays
+        std::vector<T> angle(n), base(n), exponent(n), weight(n), result(n);
+        std::vector<float> reduced(n), expected_reduced(n);
+        for(std::size_t k = 0; k < n; ++k){
+            angle[k] = make(r, static_cast<T*>(nullptr)) * 20.0f;
+            base[k] = abs(make(r, static_cast<T*>(nullptr))) * 8.0f + 1e-3f;
+            exponent[k] = make(r, static_cast<T*>(nullptr)) * 6.0f;
+            weight[k] = make(r, static_cast<T*>(nullptr)) * 0.75f + 0.5f;
+        }
+        const typename soa<T>::type a(angle), b(base), e(exponent), w(weight);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = sin(angle[k]); }
+        batch::sin(angle, result); compare<T>("batch::sin", result, expected);
+        batch::sin(a, out); compare<T>("batch::sin of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = cos(angle[k]); }
+        batch::cos(angle, result); compare<T>("batch::cos", result, expected);
+        batch::cos(a, out); compare<T>("batch::cos of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = pow(base[k], exponent[k]); }
+        batch::pow(base, exponent, result); compare<T>("batch::pow", result, expected);
+        batch::pow(b, e, out); compare<T>("batch::pow of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = exp2(exponent[k]); }
+        batch::exp2(exponent, result); compare<T>("batch::exp2", result, expected);
+        batch::exp2(e, out); compare<T>("batch::exp2 of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = log2(base[k]); }
+        batch::log2(base, result); compare<T>("batch::log2", result, expected);
+        batch::log2(b, out); compare<T>("batch::log2 of a structure of arrays", out, expected);
+
+        // the weights reach past [0, 1] on purpose, mix extrapolates there
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = mix(angle[k], base[k], weight[k]); }
+        batch::mix(angle, base, weight, result); compare<T>("batch::mix", result, expected);
+        batch::mix(a, b, w, out); compare<T>("batch::mix of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = mix(angle[k], base[k], 0.3f); }
+        batch::mix(angle, base, 0.3f, result); compare<T>("batch::mix with one weight", result, expected);
+        batch::mix(a, b, 0.3f, out); compare<T>("batch::mix with one weight of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = smoothstep(-0.25f, 0.75f, weight[k]); }
+        batch::smoothstep(-0.25f, 0.75f, weight, result); compare<T>("batch::smoothstep", result, expected);
+        batch::smoothstep(-0.25f, 0.75f, w, out); compare<T>("batch::smoothstep of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = clamp(angle[k], -4.0f, 6.0f); }
+        batch::clamp(angle, -4.0f, 6.0f, result); compare<T>("batch::clamp", result, expected);
+        batch::clamp(a, -4.0f, 6.0f, out); compare<T>("batch::clamp of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected[k] = reflect(incident[k], normal[k]); }
+        batch::reflect(incident, normal, result); compare<T>("batch::reflect", result, expected);
+        batch::reflect(i, m, out); compare<T>("batch::reflect of a structure of arrays", out, expected);
+
+        for(std::size_t k = 0; k < n; ++k){ expected_reduced[k] = dot(angle[k], base[k]); }
+        batch::dot(angle, base, reduced); compare("batch::dot", reduced, expected_reduced);
+        batch::dot(a, b, reduced); compare("batch::dot of a structure of arrays", reduced, expected_reduced);
+
+        for(std::size_t k = 0; k < n; ++k){ expected_reduced[k] = length(angle[k]); }
+        batch::length(angle, reduced); compare("batch::length", reduced, expected_reduced);
+        batch::length(a, reduced); compare("batch::length of a structure of arrays", reduced, expected_reduced);
+
+        // to_soa then to_aos gives back the same bits, into buffers that held something else
+        typename soa<T>::type streams(n);
+        batch::to_soa(angle, streams);
+        compare<T>("batch::to_soa", streams, angle);
+        std::vector<T> back(n, T(-1.0f));
+        batch::to_aos(streams, back);
+        compare<T>("batch::to_aos", back, angle);
+    }
+};
+
+int main(){
+    const isa previous = dispatch::selected();
+    for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+        if(level > dispatch::detect()){ break; }
+        dispatch::use(level);
+        kernels<vec2>();
+        kernels<vec3>();
+        kernels<vec4>();
+    }
+    dispatch::use(previous);
+    return test::result();
+}
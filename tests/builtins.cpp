@@ -0,0 +1,37 @@
+// the glic.h builtins that were wrong once: distance returned nothing, radians and degrees were swapped, mod followed
+// std::fmod's sign of x instead of GLSL's sign of y, normalize of a float gave x / x instead of the sign
+
+#include <cmath>
+#include "check.h"
+#include "glic.h"
+
+using namespace glic;
+
+namespace {
+    bool near(const float a, const float b){ return std::fabs(a - b) <= 1e-6f * std::fabs(b); }
+};
+
+int main(){
+    GLIC_CHECK(glic::distance(1.0f, -2.5f) == 3.5f);
+    GLIC_CHECK(glic::distance(vec2(0.0f, 0.0f), vec2(3.0f, 4.0f)) == 5.0f);
+    GLIC_CHECK(glic::distance(vec3(1.0f, 2.0f, 3.0f), vec3(1.0f, 2.0f, -1.0f)) == 4.0f);
+    GLIC_CHECK(glic::distance(vec4(1.0f), vec4(2.0f)) == 2.0f);
+
+    GLIC_CHECK(near(glic::radians(180.0f), 3.14159265f) && near(glic::radians(-90.0f), -1.57079633f));
+    GLIC_CHECK(near(glic::degrees(3.14159265f), 180.0f) && near(glic::degrees(1.0f), 57.2957795f));
+    const vec3 turn = glic::radians(vec3(360.0f, 45.0f, 0.0f));
+    GLIC_CHECK(near(turn.x, 6.28318531f) && near(turn.y, 0.785398163f) && turn.z == 0.0f);
+
+    // GLSL's mod takes the sign of y, std::fmod the sign of x
+    GLIC_CHECK(glic::mod(-1.0f, 3.0f) == 2.0f && glic::mod(1.0f, -3.0f) == -2.0f);
+    GLIC_CHECK(glic::mod(-7.5f, -2.0f) == -1.5f && glic::mod(7.5f, 2.0f) == 1.5f);
+    const vec4 m = glic::mod(vec4(-1.0f, 1.0f, -4.5f, 6.0f), 4.0f);
+    GLIC_CHECK(m.x == 3.0f && m.y == 1.0f && m.z == 3.5f && m.w == 2.0f);
+    const vec2 signs = glic::mod(vec2(5.0f, -5.0f), vec2(-3.0f, 3.0f));
+    GLIC_CHECK(signs.x == -1.0f && signs.y == 1.0f);
+
+    GLIC_CHECK(glic::normalize(-3.0f) == -1.0f && glic::normalize(0.25f) == 1.0f);
+    GLIC_CHECK(glic::normalize(-1e-30f) == -1.0f && glic::normalize(1e30f) == 1.0f);
+
+    return test::result();
+}
@@ -0,0 +1,63 @@
+#ifndef GLIC_TEST_CHECK_HEADER
+#define GLIC_TEST_CHECK_HEADER
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+// the few checks the test programs need: a failed GLIC_CHECK prints where it is and what it tested and the program carries on,
+// main returns test::result() so ctest sees every failure of a run, not only the first
+
+namespace test {
+    inline int& failures(){
+        static int count = 0;
+        return count;
+    }
+
+    inline bool check(const bool passed, const char* file, const int line, const char* text){
+        if(!passed){
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, text);
+            ++failures();
+        }
+        return passed;
+    }
+
+    inline int result(){
+        if(failures()){ std::fprintf(stderr, "%d checks failed\n", failures()); }
+        return failures() ? 1 : 0;
+    }
+
+    inline std::uint32_t bits(const float x){
+        std::uint32_t u;
+        std::memcpy(&u, &x, sizeof(u));
+        return u;
+    }
+
+    // the same float down to the sign of zero
+    inline bool same_bits(const float a, const float b){ return bits(a) == bits(b); }
+
+    // the same floats on every run and platform, from a plain lcg
+    struct random {
+        std::uint32_t state;
+
+        explicit random(const std::uint32_t seed = 0x9e3779b9u) : state(seed) {}
+
+        // uniform in [lo, hi)
+        float next(const float lo, const float hi){
+            state = state * 1664525u + 1013904223u;
+            return lo + (hi - lo) * static_cast<float>(state >> 8) * (1.0f / 16777216.0f);
+        }
+    };
+
+    // a count of elements that differ from their reference, reported with where they were computed (a dispatch level, ...)
+    inline bool none_differ(const int mismatches, const std::size_t count, const char* where, const char* file, const int line, const char* text){
+        if(!check(mismatches == 0, file, line, text)){ std::fprintf(stderr, "    %d of %zu elements differ at %s\n", mismatches, count, where); }
+        return mismatches == 0;
+    }
+};
+
+#define GLIC_CHECK(condition) test::check((condition), __FILE__, __LINE__, #condition)
+#define GLIC_CHECK_NONE_DIFFER(what, mismatches, count, where) test::none_differ((mismatches), (count), (where), __FILE__, __LINE__, (what))
+
+#endif
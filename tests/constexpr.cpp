@@ -0,0 +1,102 @@
+// the GLIC_CONSTEXPR builtins and table.h in constant expressions, built twice, as glic_test_constexpr17 and
+// glic_test_constexpr20, both without GLIC_SIMD and GLIC_INSTRUMENT so GLIC_CONSTEXPR is constexpr in c++17 as well
+// most of it is static_asserts and passes by compiling; what remains at run time compares abs, floor and ceil of constant
+// evaluation with the std versions down to the bit, since the sign of a zero is not visible to a constant expression
+// the GLIC_CONSTEXPR_ROUND part needs a compiler that tells constant evaluation apart in c++17, as every one this builds with
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include "check.h"
+#include "glic.h"
+#include "table.h"
+
+using namespace glic;
+
+namespace {
+    constexpr auto ramp = bake<5>(0.0f, 1.0f, [](const float t){ return mix(vec3(1.0f, 0.0f, 0.0f), vec3(0.0f, 0.0f, 1.0f), smoothstep(0.0f, 1.0f, t)); });
+    static_assert(ramp[0].x == 1.0f && ramp[2].x == 0.5f && ramp[2].z == 0.5f && ramp[4].z == 1.0f && ramp(0.125f).y == 0.0f, "a baked GLIC_CONSTEXPR ramp");
+
+    #if defined(GLIC_CONSTEXPR_ROUNDING)
+    // a triangle wave, made of abs, fract, floor and mod, baked over two periods
+    constexpr float triangle(const float t){ return glic::abs(glic::fract(t) - 0.5f) + glic::floor(t) * 0.0f + glic::mod(t, 1.0f) * 0.0f; }
+    constexpr auto wave = bake<9>(0.0f, 2.0f, triangle);
+
+    static_assert(wave.size() == 9 && wave[0] == 0.5f && wave[1] == 0.25f && wave[2] == 0.0f && wave[4] == 0.5f && wave[8] == 0.5f, "baked samples");
+    static_assert(wave(0.125f) == 0.375f && wave(-1.0f) == 0.5f && wave(3.0f) == 0.5f, "baked interpolation and its ends");
+
+    constexpr auto steps = bake<5>(-2.0f, 2.0f, [](const float t){ return vec3(glic::floor(t - 0.5f), glic::ceil(t - 0.5f), glic::mod(t, 1.5f)); });
+    static_assert(steps[0].x == -3.0f && steps[0].y == -2.0f && steps[0].z == 1.0f, "floor, ceil and mod of negatives");
+    static_assert(steps[4].x == 1.0f && steps[4].y == 2.0f && steps[4].z == 0.5f, "floor, ceil and mod of positives");
+
+    constexpr auto v = glic::abs(glic::vec2(-1.0f));
+    static_assert(v.x == 1.0f && v.y == 1.0f, "vec2 abs");
+    constexpr vec3 f = glic::fract(vec3(-0.25f, 1.75f, 8388609.0f));
+    static_assert(f.x == 0.75f && f.y == 0.75f && f.z == 0.0f, "vec3 fract");
+    constexpr vec4 m = glic::mod(vec4(-1.0f, 5.5f, -7.0f, 0.0f), vec4(3.0f, 2.0f, -4.0f, 1.0f));
+    static_assert(m.x == 2.0f && m.y == 1.5f && m.z == -3.0f && m.w == 0.0f, "vec4 mod takes the sign of y");
+    static_assert(glic::floor(-8388607.5f) == -8388608.0f && glic::ceil(8388607.5f) == 8388608.0f && glic::floor(1e30f) == 1e30f, "floor and ceil near and past 2^23");
+    static_assert(glic::floor(std::numeric_limits<float>::infinity()) == std::numeric_limits<float>::infinity(), "floor of inf");
+    static_assert(glic::floor(-std::numeric_limits<float>::denorm_min()) == -1.0f && glic::ceil(std::numeric_limits<float>::denorm_min()) == 1.0f, "floor and ceil of denormals");
+    static_assert(glic::length(-2.0f) == 2.0f && glic::distance(1.0f, -3.0f) == 4.0f, "one dimensional length and distance");
+
+    constexpr float values[] = {
+        0.0f, -0.0f, 0.25f, -0.25f, 0.5f, -0.5f, 0.999999f, -0.999999f, 1.0f, -1.0f, 1.5f, -1.5f, 2.5f, -2.5f, 1e-30f, -1e-30f,
+        std::numeric_limits<float>::denorm_min(), -std::numeric_limits<float>::denorm_min(), 8388607.5f, -8388607.5f,
+        8388608.0f, -8388609.0f, 2147483648.0f, -2147483904.0f, 1e30f, -1e30f,
+        std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity()
+    };
+    constexpr std::size_t count = sizeof(values) / sizeof(values[0]);
+
+    // function of each of the values, in a constant expression where the result is declared constexpr
+    constexpr table<float, count> each(float (*function)(float)){
+        table<float, count> result{};
+        for(std::size_t i = 0; i < count; ++i){ result.samples[i] = function(values[i]); }
+        return result;
+    }
+
+    constexpr float abs_of(const float x){ return glic::abs(x); }
+    constexpr float floor_of(const float x){ return glic::floor(x); }
+    constexpr float ceil_of(const float x){ return glic::ceil(x); }
+
+    constexpr auto abs_table = each(abs_of), floor_table = each(floor_of), ceil_table = each(ceil_of);
+
+    void against_std(const char* name, const table<float, count>& compiled, const table<float, count>& run, float (*reference)(float)){
+        for(std::size_t i = 0; i < count; ++i){
+            const float expected = reference(values[i]);
+            if(!test::check(test::same_bits(compiled[i], expected) && test::same_bits(run[i], expected), __FILE__, __LINE__, name)){
+                std::fprintf(stderr, "    %a gave %a at compile time and %a at run time, expected %a\n", values[i], compiled[i], run[i], expected);
+            }
+        }
+    }
+
+    float std_abs(const float x){ return std::abs(x); }
+    float std_floor(const float x){ return std::floor(x); }
+    float std_ceil(const float x){ return std::ceil(x); }
+    #endif
+};
+
+int main(){
+    #if defined(GLIC_CONSTEXPR_ROUNDING)
+        GLIC_CHECK(wave(0.125f) == 0.375f && v.x == 1.0f);
+        against_std("abs", abs_table, each(abs_of), std_abs);
+        against_std("floor", floor_table, each(floor_of), std_floor);
+        against_std("ceil", ceil_table, each(ceil_of), std_ceil);
+    #endif
+
+    // the detail versions themselves at run time, on every 4099th float with both signs
+    int mismatches = 0;
+    for(std::uint32_t u = 0; u < 0x7f800000u; u += 4099u){
+        for(const std::uint32_t sign : {0u, 0x80000000u}){
+            const std::uint32_t bits = u | sign;
+            float x;
+            std::memcpy(&x, &bits, sizeof(x));
+            mismatches += !test::same_bits(detail::floor(x), std::floor(x)) || !test::same_bits(detail::ceil(x), std::ceil(x)) || !test::same_bits(detail::abs(x), std::abs(x));
+        }
+    }
+    GLIC_CHECK(mismatches == 0);
+
+    return test::result();
+}
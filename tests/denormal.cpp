@@ -0,0 +1,80 @@
+// flush_denormals really flushes denormal inputs and results on this thread, leaves the other control bits alone and puts
+// the previous mode back, also when nested; render_options::flush_denormals does the same on the pool threads
+
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include "check.h"
+#include "denormal.h"
+#include "render.h"
+
+using namespace glic;
+
+namespace {
+    // volatile so the compiler cannot fold the products at compile time, where it would keep the denormals
+    volatile float denormal = 1e-39f, smallest_normal = std::numeric_limits<float>::min(), one = 1.0f, one_half = 0.5f;
+
+    float product(const volatile float& a, const volatile float& b){ return a * b; }
+};
+
+int main(){
+    if(!flush_denormals::supported){
+        std::printf("flush_denormals is not supported on this target\n");
+        return 0;
+    }
+
+    GLIC_CHECK(product(denormal, one) != 0.0f);
+    GLIC_CHECK(product(smallest_normal, one_half) != 0.0f);
+
+    #if defined(GLIC_DENORMAL_MXCSR)
+        // round toward zero, so the test sees whether unrelated bits survive; the low six bits are the sticky exception
+        // flags, which the arithmetic sets as it goes
+        const unsigned control = 0xffc0u, original = _mm_getcsr(), before = (original & control & ~0x8040u) | 0x6000u;
+        _mm_setcsr(before);
+    #endif
+
+    {
+        const flush_denormals outer;
+        GLIC_CHECK(product(denormal, one) == 0.0f);          // daz, the input reads as zero
+        GLIC_CHECK(product(smallest_normal, one_half) == 0.0f);  // ftz, the result is flushed
+        #if defined(GLIC_DENORMAL_MXCSR)
+            GLIC_CHECK((_mm_getcsr() & control) == (before | 0x8040u));
+        #endif
+
+        {
+            const flush_denormals inner;
+            GLIC_CHECK(product(denormal, one) == 0.0f);
+        }
+        // the inner scope restores the flushed mode it found, not the original one
+        GLIC_CHECK(product(denormal, one) == 0.0f);
+        #if defined(GLIC_DENORMAL_MXCSR)
+            GLIC_CHECK((_mm_getcsr() & control) == (before | 0x8040u));
+        #endif
+    }
+
+    #if defined(GLIC_DENORMAL_MXCSR)
+        GLIC_CHECK((_mm_getcsr() & control) == before);
+        _mm_setcsr(original);
+    #endif
+    GLIC_CHECK(product(denormal, one) != 0.0f);
+    GLIC_CHECK(product(smallest_normal, one_half) != 0.0f);
+
+    // frames shade on the pool thread with the mode set for the frame only
+    thread_pool single(1);
+    const uniforms inputs(vec2(2.0f, 2.0f));
+    const auto shader = [](const vec2){ const float d = product(denormal, one); return vec4(d, product(smallest_normal, one_half), 0.0f, 1.0f); };
+    std::vector<vec4> pixels(4);
+
+    render_options flushed;
+    flushed.pool = &single;
+    flushed.flush_denormals = true;
+    render(shader, inputs, pixels.data(), flushed);
+    for(const vec4& p : pixels){ GLIC_CHECK(p.x == 0.0f && p.y == 0.0f); }
+
+    render_options plain;
+    plain.pool = &single;
+    render(shader, inputs, pixels.data(), plain);
+    for(const vec4& p : pixels){ GLIC_CHECK(p.x != 0.0f && p.y != 0.0f); }
+
+    return test::result();
+}
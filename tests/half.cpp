@@ -0,0 +1,151 @@
+// the half conversions of half.h against the F16C instructions, bit for bit: every one of the 65536 halves widened, and a
+// strided sweep of all floats plus the rounding ties and their neighbours next to every half narrowed, through both the
+// scalar and the four lane versions; the hardware side is compiled for F16C on its own and only run when the cpu has it
+// then packHalf2x16 / unpackHalf2x16 round trips and batch::to_half / to_float on a length with a tail past the eight lane loop
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "batch.h"
+#include "check.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define GLIC_TEST_F16C
+    #include <immintrin.h>
+#endif
+
+using namespace glic;
+
+namespace {
+    std::uint32_t bits(const half h){ return h.bits; }
+    bool is_nan(const std::uint16_t h){ return (h & 0x7c00u) == 0x7c00u && (h & 0x3ffu) != 0u; }
+
+    #if defined(GLIC_TEST_F16C)
+        __attribute__((target("f16c"))) std::uint16_t hardware_half(const float x){ return static_cast<std::uint16_t>(_cvtss_sh(x, 0)); }
+        __attribute__((target("f16c"))) float hardware_float(const std::uint16_t h){ return _cvtsh_ss(h); }
+
+        bool has_f16c(){ return __builtin_cpu_supports("f16c"); }
+    #else
+        std::uint16_t hardware_half(const float){ return 0; }
+        float hardware_float(const std::uint16_t){ return 0.0f; }
+
+        bool has_f16c(){ return false; }
+    #endif
+
+    // the floats to narrow: every 65521st bit pattern, and for every finite half the float it widens to, the ties halfway to
+    // its neighbours and one bit either side of them (13 dropped mantissa bits for normals, more for denormals, where these
+    // are just nearby values)
+    std::vector<float> sweep(){
+        std::vector<float> values;
+        for(std::uint64_t u = 0; u <= 0xffffffffu; u += 65521u){ values.push_back(approx::detail::from_bits(static_cast<std::uint32_t>(u))); }
+        for(std::uint32_t h = 0; h < 0x10000u; ++h){
+            if((h & 0x7c00u) == 0x7c00u){ continue; }
+            const std::uint32_t u = approx::detail::bits(detail::float_from_half(static_cast<std::uint16_t>(h)));
+            for(const std::uint32_t offset : {0u, 1u, 0xfffu, 0x1000u, 0x1001u}){
+                values.push_back(approx::detail::from_bits(u + offset));
+                values.push_back(approx::detail::from_bits(u - offset));
+            }
+        }
+        while(values.size() % 4){ values.push_back(0.0f); }
+        return values;
+    }
+
+    void against_hardware(){
+        int widened = 0, widened4 = 0;
+        for(std::uint32_t h = 0; h < 0x10000u; ++h){
+            const std::uint16_t value = static_cast<std::uint16_t>(h);
+            widened += !test::same_bits(detail::float_from_half(value), hardware_float(value));
+        }
+        #if defined(GLIC_HALF_SSE2)
+            for(std::uint32_t h = 0; h < 0x10000u; h += 4){
+                const std::uint16_t in[4] = {
+                    static_cast<std::uint16_t>(h), static_cast<std::uint16_t>(h + 1), static_cast<std::uint16_t>(h + 2), static_cast<std::uint16_t>(h + 3)
+                };
+                float out[4];
+                detail::float4_from_half4(in, out);
+                for(int k = 0; k < 4; ++k){ widened4 += !test::same_bits(out[k], hardware_float(in[k])); }
+            }
+        #endif
+        GLIC_CHECK_NONE_DIFFER("float_from_half against _cvtsh_ss", widened, 0x10000u, "every half");
+        GLIC_CHECK_NONE_DIFFER("float4_from_half4 against _cvtsh_ss", widened4, 0x10000u, "every half");
+
+        const std::vector<float> values = sweep();
+        int narrowed = 0, narrowed4 = 0;
+        for(const float x : values){ narrowed += detail::half_from_float(x) != hardware_half(x); }
+        #if defined(GLIC_HALF_SSE2)
+            for(std::size_t i = 0; i < values.size(); i += 4){
+                std::uint16_t out[4];
+                detail::half4_from_float4(&values[i], out);
+                for(int k = 0; k < 4; ++k){ narrowed4 += out[k] != hardware_half(values[i + k]); }
+            }
+        #endif
+        GLIC_CHECK_NONE_DIFFER("half_from_float against _cvtss_sh", narrowed, values.size(), "the float sweep");
+        GLIC_CHECK_NONE_DIFFER("half4_from_float4 against _cvtss_sh", narrowed4, values.size(), "the float sweep");
+    }
+
+    void pack(){
+        // every half in the low and high half of the word, nans excepted as their float round trip only has to stay a nan
+        int trips = 0, nans = 0;
+        for(std::uint32_t h = 0; h < 0x10000u; ++h){
+            const std::uint32_t low = h, high = (h * 40503u) & 0xffffu;
+            const std::uint32_t word = low | (high << 16);
+            const vec2 v = unpackHalf2x16(word);
+            if(is_nan(static_cast<std::uint16_t>(low)) || is_nan(static_cast<std::uint16_t>(high))){
+                nans += !(v.x != v.x || v.y != v.y);
+                continue;
+            }
+            trips += packHalf2x16(v) != word;
+        }
+        GLIC_CHECK_NONE_DIFFER("unpackHalf2x16 then packHalf2x16", trips, 0x10000u, "every half");
+        GLIC_CHECK(nans == 0);
+
+        GLIC_CHECK(packHalf2x16(vec2(1.0f, -2.0f)) == 0xc0003c00u);
+        GLIC_CHECK(packHalf2x16(vec2(65520.0f, 1e-8f)) == 0x00007c00u);
+        const vec2 v = unpackHalf2x16(0x7bff0001u);
+        GLIC_CHECK(v.x == 5.9604645e-8f && v.y == 65504.0f);
+    }
+
+    void buffers(){
+        // 8 lanes at a time, then a tail of 3
+        const std::size_t n = 8 * 125 + 3;
+        std::vector<float> in(n), back(n + 1);
+        std::vector<half> out(n + 1), expected(n);
+        test::random r;
+        for(std::size_t i = 0; i < n; ++i){
+            in[i] = r.next(-70000.0f, 70000.0f) * (i % 3 ? 1.0f : 1e-6f);
+            expected[i] = half(in[i]);
+        }
+
+        const isa previous = dispatch::selected();
+        for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+            if(level > dispatch::detect()){ break; }
+            dispatch::use(level);
+
+            out[n] = half::from_bits(0x1234u);
+            back[n] = 42.0f;
+            batch::to_half(batch::span<const float>(in.data(), n), batch::span<half>(out.data(), n));
+            batch::to_float(batch::span<const half>(out.data(), n), batch::span<float>(back.data(), n));
+
+            int narrowed = 0, widened = 0;
+            for(std::size_t i = 0; i < n; ++i){
+                narrowed += bits(out[i]) != bits(expected[i]);
+                widened += !test::same_bits(back[i], static_cast<float>(expected[i]));
+            }
+            GLIC_CHECK_NONE_DIFFER("batch::to_half", narrowed, n, dispatch::name(level));
+            GLIC_CHECK_NONE_DIFFER("batch::to_float", widened, n, dispatch::name(level));
+            GLIC_CHECK(out[n].bits == 0x1234u && back[n] == 42.0f);
+        }
+        dispatch::use(previous);
+    }
+};
+
+int main(){
+    if(has_f16c()){
+        against_hardware();
+    }else{
+        std::fprintf(stderr, "no F16C on this cpu, the conversions are not compared against it\n");
+    }
+    pack();
+    buffers();
+    return test::result();
+}
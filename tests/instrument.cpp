@@ -0,0 +1,97 @@
+// the GLIC_INSTRUMENT counters: one call per builtin the program calls, however many builtins it runs inside (vector
+// overloads over their components, smoothstep over clamp, normalize over length and sqrt), nans and infs counted where
+// they are made rather than where they flow through, and threads' counts kept after the threads exit
+// built with GLIC_INSTRUMENT whatever the cmake option says
+
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <vector>
+#include "batch.h"
+#include "check.h"
+#include "glic.h"
+#include "instrument.h"
+
+using namespace glic;
+
+namespace {
+    instrument::counters of(const instrument::builtin b){ return instrument::snapshot()[static_cast<int>(b)]; }
+    std::uint64_t calls(const instrument::builtin b){ return of(b).calls; }
+
+    // none of the builtins but the ones listed were counted
+    bool only(std::initializer_list<instrument::builtin> expected){
+        const std::vector<instrument::counters> totals = instrument::snapshot();
+        for(int b = 0; b < static_cast<int>(instrument::builtin::count); ++b){
+            bool listed = false;
+            for(const instrument::builtin e : expected){ listed |= static_cast<int>(e) == b; }
+            if(!listed && totals[b].calls){
+                std::fprintf(stderr, "    %s was counted %llu times\n", instrument::name(static_cast<instrument::builtin>(b)), static_cast<unsigned long long>(totals[b].calls));
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // keeps results alive without caring about their value, as glic_bench's keep does
+    template <typename T> void use(const T& value){
+        #if defined(__GNUC__)
+            asm volatile("" : : "g"(&value) : "memory");
+        #else
+            static volatile const void* sink;
+            sink = &value;
+        #endif
+    }
+};
+
+int main(){
+    using instrument::builtin;
+    volatile float x = 0.5f;
+
+    instrument::reset();
+    use(glic::sin(vec4(x)));
+    GLIC_CHECK(calls(builtin::sin) == 1);
+    GLIC_CHECK(only({builtin::sin}));
+
+    instrument::reset();
+    use(glic::smoothstep(0.0f, 1.0f, x));
+    use(glic::smoothstep(vec3(0.0f), vec3(1.0f), vec3(x)));
+    GLIC_CHECK(calls(builtin::smoothstep) == 2);
+    GLIC_CHECK(only({builtin::smoothstep}));
+
+    instrument::reset();
+    use(glic::normalize(vec3(x, 1.0f, 2.0f)));
+    use(glic::refract(vec3(x, -1.0f, 0.0f), vec3(0.0f, 1.0f, 0.0f), 0.75f));
+    use(glic::distance(vec2(x), vec2(1.0f)));
+    GLIC_CHECK(calls(builtin::normalize) == 1 && calls(builtin::refract) == 1 && calls(builtin::distance) == 1);
+    GLIC_CHECK(only({builtin::normalize, builtin::refract, builtin::distance}));
+
+    instrument::reset();
+    for(int i = 0; i < 5; ++i){ use(glic::exp(x + i)); }
+    GLIC_CHECK(calls(builtin::exp) == 5);
+
+    // a nan made by sqrt counts there, the nan fed to abs afterwards does not count again
+    instrument::reset();
+    const float nan = glic::sqrt(x - 1.0f);
+    use(glic::abs(nan));
+    use(glic::exp(100.0f + x));
+    use(glic::exp(std::numeric_limits<float>::infinity()));
+    GLIC_CHECK(of(builtin::sqrt).nans == 1 && of(builtin::abs).nans == 0);
+    GLIC_CHECK(of(builtin::exp).infs == 1 && of(builtin::exp).calls == 2);
+
+    instrument::reset();
+    use(glic::abs(vec2(1e-39f, x)));
+    GLIC_CHECK(of(builtin::abs).denormal_inputs == 1 && of(builtin::abs).denormal_outputs == 1);
+
+    // the structure of arrays kernels count the builtins their loops call, one per element
+    instrument::reset();
+    batch::vec3_soa normals(64);
+    for(std::size_t i = 0; i < normals.size(); ++i){ normals.set(i, vec3(x, 1.0f, static_cast<float>(i))); }
+    batch::normalize(normals, normals);
+    GLIC_CHECK(calls(builtin::sqrt) == 64);
+
+    instrument::reset();
+    std::thread([&](){ for(int i = 0; i < 3; ++i){ use(glic::cos(x)); } }).join();
+    GLIC_CHECK(calls(builtin::cos) == 3);
+
+    return test::result();
+}
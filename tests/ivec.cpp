@@ -0,0 +1,148 @@
+// the integer and bool vectors of ivec.h and the relational builtins, selects and bit casts of glic.h, then quadAny,
+// quadAll and branch() of quad.h
+// pins what GLSL leaves open or c++ makes easy to get wrong: % truncates towards zero and takes the sign of the dividend,
+// >> on a negative ivec is arithmetic, << on one shifts the two's complement bits, uvec arithmetic wraps around, and a
+// divergent branch() gives each lane the result of the side it took
+
+#include <cstdint>
+#include <limits>
+#include "check.h"
+#include "quad.h"
+
+using namespace glic;
+
+namespace {
+    template <typename T> bool same(const tvec2<T>& a, const tvec2<T>& b){ return all(equal(a, b)); }
+    template <typename T> bool same(const tvec3<T>& a, const tvec3<T>& b){ return all(equal(a, b)); }
+    template <typename T> bool same(const tvec4<T>& a, const tvec4<T>& b){ return all(equal(a, b)); }
+
+    bool same(const vec3& a, const vec3& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z); }
+    bool same(const vec4& a, const vec4& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z) && test::same_bits(a.w, b.w); }
+
+    void integers(){
+        const ivec4 a(7, -7, 7, -7), b(3, 3, -3, -3);
+        GLIC_CHECK(same(a + b, ivec4(10, -4, 4, -10)) && same(a - b, ivec4(4, -10, 10, -4)));
+        GLIC_CHECK(same(a * b, ivec4(21, -21, -21, 21)) && same(a / b, ivec4(2, -2, -2, 2)));
+        GLIC_CHECK(same(a % b, ivec4(1, -1, 1, -1)));
+        GLIC_CHECK(same(ivec2(-9, 9) % 4, ivec2(-1, 1)) && same(-9 % ivec2(4, -4), ivec2(-1, -1)));
+
+        GLIC_CHECK(same(ivec4(-8, -1, 8, -2147483647 - 1) >> 1, ivec4(-4, -1, 4, -1073741824)));
+        GLIC_CHECK(same(ivec3(-1, -3, 1) << 4, ivec3(-16, -48, 16)));
+        GLIC_CHECK(same(ivec2(-1, 1) << ivec2(31, 31), ivec2(-2147483647 - 1, -2147483647 - 1)));
+        GLIC_CHECK(same(ivec2(-256, -256) >> ivec2(4, 8), ivec2(-16, -1)));
+        GLIC_CHECK(same(ivec3(6, -6, 0) & 3, ivec3(2, 2, 0)) && same(ivec3(6, -6, 0) | 1, ivec3(7, -5, 1)) && same(ivec3(6, -6, 0) ^ -1, ivec3(-7, 5, -1)));
+        GLIC_CHECK(same(~ivec2(0, -1), ivec2(-1, 0)) && same(-ivec2(5, -5), ivec2(-5, 5)));
+
+        ivec2 counter(1, -1);
+        GLIC_CHECK(same(counter++, ivec2(1, -1)) && same(counter, ivec2(2, 0)) && same(--counter, ivec2(1, -1)));
+
+        // uvec arithmetic is modulo 2^32, like GLSL's uint
+        const std::uint32_t largest = std::numeric_limits<std::uint32_t>::max();
+        GLIC_CHECK(same(uvec2(largest, 0u) + 1u, uvec2(0u, 1u)) && same(uvec2(0u, 5u) - uvec2(1u, 7u), uvec2(largest, largest - 1u)));
+        GLIC_CHECK(same(uvec3(0x80000000u, 3u, 0xffffu) * 2u, uvec3(0u, 6u, 0x1fffeu)));
+        GLIC_CHECK(same(-uvec2(1u, 0u), uvec2(largest, 0u)) && same(uvec2(largest, 1u) >> 31, uvec2(1u, 0u)));
+        GLIC_CHECK(same(uvec2(0xf000000fu, 1u) << 4, uvec2(0xf0u, 16u)) && same(uvec2(7u, 9u) % 4u, uvec2(3u, 1u)));
+
+        // conversions truncate towards zero, like GLSL constructors
+        GLIC_CHECK(same(ivec4(vec4(1.9f, -1.9f, 0.5f, -0.5f)), ivec4(1, -1, 0, 0)));
+        const vec3 widened(ivec3(-3, 0, 16777216));
+        GLIC_CHECK(widened.x == -3.0f && widened.y == 0.0f && widened.z == 16777216.0f);
+        GLIC_CHECK(same(uvec2(ivec2(-1, 2)), uvec2(largest, 2u)));
+    }
+
+    void relational(){
+        const vec4 x(1.0f, 2.0f, -0.0f, 4.0f), y(2.0f, 2.0f, 0.0f, 3.0f);
+        GLIC_CHECK(same(lessThan(x, y), bvec4(true, false, false, false)));
+        GLIC_CHECK(same(lessThanEqual(x, y), bvec4(true, true, true, false)));
+        GLIC_CHECK(same(greaterThan(x, y), bvec4(false, false, false, true)));
+        GLIC_CHECK(same(greaterThanEqual(x, y), bvec4(false, true, true, true)));
+        GLIC_CHECK(same(equal(x, y), bvec4(false, true, true, false)) && same(notEqual(x, y), bvec4(true, false, false, true)));
+
+        // nan compares false to everything, notEqual true
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const vec2 n(nan, 1.0f);
+        GLIC_CHECK(same(lessThan(n, vec2(2.0f)), bvec2(false, true)) && same(greaterThanEqual(n, vec2(0.0f)), bvec2(false, true)));
+        GLIC_CHECK(same(notEqual(n, n), bvec2(true, false)) && same(isnan(n), bvec2(true, false)));
+        GLIC_CHECK(same(isinf(vec3(std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), nan)), bvec3(true, true, false)));
+
+        GLIC_CHECK(same(lessThan(ivec3(-1, 0, 1), ivec3(0)), bvec3(true, false, false)));
+        GLIC_CHECK(same(greaterThan(uvec2(0xffffffffu, 0u), uvec2(1u)), bvec2(true, false)));
+        GLIC_CHECK(same(equal(bvec2(true, false), bvec2(true, true)), bvec2(true, false)));
+
+        GLIC_CHECK(any(bvec2(false, true)) && !any(bvec3(false)) && any(bvec4(false, false, false, true)));
+        GLIC_CHECK(all(bvec2(true)) && !all(bvec3(true, false, true)) && all(bvec4(true)));
+        GLIC_CHECK(same(not_(bvec3(true, false, true)), bvec3(false, true, false)));
+    }
+
+    void selects(){
+        const vec4 a(1.0f, 2.0f, 3.0f, 4.0f), b(-1.0f, -2.0f, -3.0f, -4.0f);
+        GLIC_CHECK(same(select(bvec4(true, false, false, true), a, b), vec4(1.0f, -2.0f, -3.0f, 4.0f)));
+        GLIC_CHECK(same(select(true, a, b), a) && same(select(false, a, b), b));
+        GLIC_CHECK(select(true, 1.0f, 2.0f) == 1.0f && select(false, 1.0f, 2.0f) == 2.0f);
+        GLIC_CHECK(same(select(bvec3(false, true, false), ivec3(1), ivec3(-1, -2, -3)), ivec3(-1, 1, -3)));
+        GLIC_CHECK(same(select(true, uvec2(1u, 2u), uvec2(3u)), uvec2(1u, 2u)) && same(select(false, uvec2(1u, 2u), uvec2(3u)), uvec2(3u)));
+
+        // mix with a bvec takes y where the lane is set, GLSL's argument order
+        GLIC_CHECK(same(mix(a, b, bvec4(true, false, true, false)), vec4(-1.0f, 2.0f, -3.0f, 4.0f)));
+        GLIC_CHECK(mix(1.0f, 2.0f, true) == 2.0f && mix(1.0f, 2.0f, false) == 1.0f);
+
+        // the untaken side's nan never leaks into the result
+        const float nan = std::numeric_limits<float>::quiet_NaN();
+        const vec3 picked = select(bvec3(true, false, true), vec3(1.0f, nan, 3.0f), vec3(nan, 2.0f, nan));
+        GLIC_CHECK(same(picked, vec3(1.0f, 2.0f, 3.0f)));
+
+        // past the critical angle k < 0 and refract's select has to give +0, with a nan sqrt on the untaken side
+        const vec3 normal(0.0f, 1.0f, 0.0f), grazing = normalize(vec3(1.0f, -0.1f, 0.0f)), steep = normalize(vec3(0.1f, -1.0f, 0.0f));
+        GLIC_CHECK(same(refract(grazing, normal, 1.5f), vec3(0.0f)));
+        GLIC_CHECK(same(refract(vec4(grazing.x, grazing.y, 0.0f, 0.0f), vec4(0.0f, 1.0f, 0.0f, 0.0f), 2.0f), vec4(0.0f)));
+        const vec3 bent = refract(steep, normal, 1.5f);
+        GLIC_CHECK(bent.y < 0.0f && bent.x > steep.x);
+        GLIC_CHECK(test::same_bits(refract(-0.5f, 1.0f, 3.0f), 0.0f) && refract(-1.0f, 1.0f, 1.5f) == -1.0f);
+    }
+
+    void bit_casts(){
+        const vec4 v(1.0f, -2.0f, -0.0f, std::numeric_limits<float>::infinity());
+        GLIC_CHECK(same(floatBitsToUint(v), uvec4(0x3f800000u, 0xc0000000u, 0x80000000u, 0x7f800000u)));
+        GLIC_CHECK(same(floatBitsToInt(v), ivec4(0x3f800000, -1073741824, -2147483647 - 1, 0x7f800000)));
+        GLIC_CHECK(same(intBitsToFloat(floatBitsToInt(v)), v) && same(uintBitsToFloat(floatBitsToUint(v)), v));
+        GLIC_CHECK(floatBitsToInt(1.0f) == 0x3f800000 && uintBitsToFloat(0x40490fdbu) == 3.14159274f);
+        GLIC_CHECK(intBitsToFloat(1) == std::numeric_limits<float>::denorm_min());
+        GLIC_CHECK(isnan(uintBitsToFloat(0x7fc00001u)) && floatBitsToUint(uintBitsToFloat(0x7fc00001u)) == 0x7fc00001u);
+    }
+
+    void lanes(){
+        GLIC_CHECK(quadAny(quad<bool>(false, false, true, false)) && !quadAny(quad<bool>(false)));
+        GLIC_CHECK(quadAll(quad<bool>(true)) && !quadAll(quad<bool>(true, true, false, true)));
+
+        const quad<float> x(-1.0f, 2.0f, -3.0f, 4.0f);
+        int thens = 0, otherwises = 0;
+        const auto then = [&](){ ++thens; return -x; };
+        const auto otherwise = [&](){ ++otherwises; return x * 10.0f; };
+
+        // divergent: both sides run once and each lane keeps its own side's result
+        const quad<float> divergent = branch(x < 0.0f, then, otherwise);
+        GLIC_CHECK(thens == 1 && otherwises == 1);
+        GLIC_CHECK(divergent[0] == 1.0f && divergent[1] == 20.0f && divergent[2] == 3.0f && divergent[3] == 40.0f);
+
+        // uniform: the side no lane takes never runs
+        thens = otherwises = 0;
+        const quad<float> taken = branch(x < 10.0f, then, otherwise);
+        GLIC_CHECK(thens == 1 && otherwises == 0 && taken[1] == -2.0f && taken[3] == -4.0f);
+        thens = otherwises = 0;
+        const quad<float> skipped = branch(x > 10.0f, then, otherwise);
+        GLIC_CHECK(thens == 0 && otherwises == 1 && skipped[0] == -10.0f && skipped[2] == -30.0f);
+
+        // a side may give a uniform value, which every lane that takes it gets
+        const quad<vec2> mixed = branch(quad<bool>(true, false, false, true), [](){ return vec2(1.0f, 2.0f); }, [](){ return quad<vec2>(vec2(3.0f), vec2(4.0f), vec2(5.0f), vec2(6.0f)); });
+        GLIC_CHECK(mixed[0].x == 1.0f && mixed[0].y == 2.0f && mixed[1].x == 4.0f && mixed[2].y == 5.0f && mixed[3].y == 2.0f);
+    }
+};
+
+int main(){
+    integers();
+    relational();
+    selects();
+    bit_casts();
+    lanes();
+    return test::result();
+}
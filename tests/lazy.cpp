@@ -0,0 +1,97 @@
+// fused lazy expressions against the same builtins called element by element, bit for bit: float and vector arrays,
+// uniforms, an output that is also an input, and half precision buffers read as float and rounded back on assignment;
+// arrays of different lengths throw std::length_error before anything is written, in release builds as well
+
+#include <cstdio>
+#include <stdexcept>
+#include <vector>
+#include "check.h"
+#include "lazy.h"
+
+using namespace glic;
+
+namespace {
+    bool same(const vec3& a, const vec3& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z); }
+    bool same(const vec4& a, const vec4& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z) && test::same_bits(a.w, b.w); }
+    bool same(const f16vec4& a, const f16vec4& b){ return a.x.bits == b.x.bits && a.y.bits == b.y.bits && a.z.bits == b.z.bits && a.w.bits == b.w.bits; }
+
+    template <typename T> void compare(const char* what, const std::vector<T>& result, const std::vector<T>& expected){
+        int mismatches = 0;
+        for(std::size_t i = 0; i < expected.size(); ++i){ mismatches += !same(result[i], expected[i]); }
+        GLIC_CHECK_NONE_DIFFER(what, mismatches, expected.size(), dispatch::name(dispatch::selected()));
+    }
+
+    template <typename F> bool throws_length_error(const F& f){
+        try {
+            f();
+        } catch(const std::length_error&){
+            return true;
+        }
+        return false;
+    }
+};
+
+int main(){
+    const std::size_t n = 1003;
+    test::random r;
+    std::vector<vec3> a(n), b(n), out(n), expected(n);
+    std::vector<float> x(n), scalars(n), expected_scalars(n);
+    std::vector<vec4> colors(n);
+    std::vector<f16vec4> packed(n);
+    for(std::size_t i = 0; i < n; ++i){
+        a[i] = vec3(r.next(-2.0f, 2.0f), r.next(-2.0f, 2.0f), r.next(-2.0f, 2.0f));
+        b[i] = vec3(r.next(-2.0f, 2.0f), r.next(-2.0f, 2.0f), r.next(-2.0f, 2.0f));
+        x[i] = r.next(-0.5f, 1.5f);
+        colors[i] = vec4(r.next(0.0f, 1.0f), r.next(0.0f, 1.0f), r.next(0.0f, 1.0f), 1.0f);
+        packed[i] = f16vec4(vec4(r.next(-4.0f, 4.0f), r.next(-4.0f, 4.0f), r.next(-4.0f, 4.0f), r.next(-4.0f, 4.0f)));
+    }
+
+    // the readme's example, with a vec3 uniform
+    const vec3 k(0.5f, 2.0f, -1.0f);
+    lazy::into(out) = mix(lazy::ref(a), lazy::ref(b), smoothstep(0.0f, 1.0f, lazy::ref(x))) * k;
+    for(std::size_t i = 0; i < n; ++i){ expected[i] = mix(a[i], b[i], smoothstep(0.0f, 1.0f, x[i])) * k; }
+    compare("mix of smoothstep", out, expected);
+
+    lazy::into(scalars) = dot(normalize(lazy::ref(a)), lazy::ref(b)) + fract(lazy::ref(x) * 3.0f);
+    for(std::size_t i = 0; i < n; ++i){ expected_scalars[i] = dot(normalize(a[i]), b[i]) + fract(x[i] * 3.0f); }
+    int mismatches = 0;
+    for(std::size_t i = 0; i < n; ++i){ mismatches += !test::same_bits(scalars[i], expected_scalars[i]); }
+    GLIC_CHECK_NONE_DIFFER("dot plus fract", mismatches, n, dispatch::name(dispatch::selected()));
+
+    const std::vector<vec3> evaluated = lazy::evaluate(cross(lazy::ref(a), lazy::ref(b)) - 1.0f);
+    for(std::size_t i = 0; i < n; ++i){ expected[i] = cross(a[i], b[i]) - 1.0f; }
+    compare("evaluate", evaluated, expected);
+
+    // the output as one of the inputs: element i is read before it is written
+    for(std::size_t i = 0; i < n; ++i){ expected[i] = reflect(a[i], normalize(b[i])) * 2.0f + a[i]; }
+    lazy::into(a) = reflect(lazy::ref(a), normalize(lazy::ref(b))) * 2.0f + lazy::ref(a);
+    compare("output aliasing an input", a, expected);
+
+    // half buffers widen when read and round back when written, also in place
+    std::vector<f16vec4> expected_packed(n);
+    for(std::size_t i = 0; i < n; ++i){ expected_packed[i] = f16vec4(vec4(packed[i]) * 0.5f + colors[i]); }
+    std::vector<f16vec4> halves(n);
+    lazy::into(halves) = lazy::ref(packed) * 0.5f + lazy::ref(colors);
+    compare("half output", halves, expected_packed);
+    lazy::into(packed) = lazy::ref(packed) * 0.5f + lazy::ref(colors);
+    compare("half output aliasing its input", packed, expected_packed);
+
+    std::vector<vec4> widened(n), expected_widened(n);
+    for(std::size_t i = 0; i < n; ++i){ expected_widened[i] = clamp(vec4(halves[i]), 0.0f, 1.0f); }
+    lazy::into(widened) = clamp(lazy::ref(halves), 0.0f, 1.0f);
+    compare("half input", widened, expected_widened);
+
+    // mismatched lengths throw before the loop writes anything
+    const std::vector<vec3> shorter(n - 1, vec3(7.0f));
+    std::vector<vec3> untouched(n, vec3(3.0f)), short_out(n - 1, vec3(3.0f));
+    GLIC_CHECK(throws_length_error([&](){ lazy::into(untouched) = lazy::ref(b) + lazy::ref(shorter); }));
+    GLIC_CHECK(throws_length_error([&](){ lazy::into(untouched) = lazy::ref(shorter) * 2.0f; }));
+    GLIC_CHECK(throws_length_error([&](){ lazy::into(short_out) = lazy::ref(b) * 2.0f; }));
+    GLIC_CHECK(throws_length_error([&](){ lazy::evaluate(lazy::ref(b) + lazy::ref(shorter)); }));
+    bool unchanged = true;
+    for(const vec3& v : untouched){ unchanged &= v.x == 3.0f && v.y == 3.0f && v.z == 3.0f; }
+    for(const vec3& v : short_out){ unchanged &= v.x == 3.0f && v.y == 3.0f && v.z == 3.0f; }
+    GLIC_CHECK(unchanged);
+
+    return test::result();
+}
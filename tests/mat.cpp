@@ -0,0 +1,113 @@
+// the matrix algebra of mat.h and glic.h and batch::transform over a mesh against the per vertex product
+// built twice like simd.cpp, as glic_test_mat_simd with GLIC_SIMD and glic_test_mat_scalar without, so the column operators
+// are checked on both paths
+// inverse and determinant round, so they are held to a tolerance; v * m and transpose(m) * v multiply the same pairs and add
+// them in the same order, and batch::transform runs the same sums as mat * vec, so those have to match bit for bit
+
+#include <cmath>
+#include <vector>
+#include "batch.h"
+#include "check.h"
+
+using namespace glic;
+
+namespace {
+    bool same(const vec2& a, const vec2& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y); }
+    bool same(const vec3& a, const vec3& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z); }
+    bool same(const vec4& a, const vec4& b){ return test::same_bits(a.x, b.x) && test::same_bits(a.y, b.y) && test::same_bits(a.z, b.z) && test::same_bits(a.w, b.w); }
+
+    vec2 make(test::random& r, vec2*){ return vec2(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+    vec3 make(test::random& r, vec3*){ return vec3(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+    vec4 make(test::random& r, vec4*){ return vec4(r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f), r.next(-1.0f, 1.0f)); }
+
+    template <typename M> struct traits;
+    template <> struct traits<mat2> { typedef vec2 column; static const int size = 2; };
+    template <> struct traits<mat3> { typedef vec3 column; static const int size = 3; };
+    template <> struct traits<mat4> { typedef vec4 column; static const int size = 4; };
+
+    // random elements in [-1, 1) plus 2 on the diagonal, so every matrix is well away from singular
+    template <typename M> M matrix(test::random& r){
+        typedef typename traits<M>::column column;
+        M m(2.0f);
+        for(int i = 0; i < traits<M>::size; ++i){ m[i] += make(r, static_cast<column*>(nullptr)); }
+        return m;
+    }
+
+    float largest(const vec2& v){ return std::fmax(std::fabs(v.x), std::fabs(v.y)); }
+    float largest(const vec3& v){ return std::fmax(largest(vec2(v.x, v.y)), std::fabs(v.z)); }
+    float largest(const vec4& v){ return std::fmax(largest(vec3(v.x, v.y, v.z)), std::fabs(v.w)); }
+
+    template <typename M> float largest_error(const M& m, const M& expected){
+        float error = 0.0f;
+        for(int i = 0; i < traits<M>::size; ++i){ error = std::fmax(error, largest(m[i] - expected[i])); }
+        return error;
+    }
+
+    template <typename M> void algebra(){
+        typedef typename traits<M>::column column;
+        const M identity(1.0f);
+        test::random r;
+        float residual = 0.0f;
+        int products = 0, rows = 0;
+        for(int k = 0; k < 1000; ++k){
+            const M a = matrix<M>(r), b = matrix<M>(r);
+            residual = std::fmax(residual, largest_error(a * inverse(a), identity));
+            residual = std::fmax(residual, largest_error(inverse(a) * a, identity));
+
+            const float expected = determinant(a) * determinant(b);
+            products += !(std::fabs(determinant(a * b) - expected) <= 1e-5f * std::fabs(expected) * traits<M>::size);
+
+            const column v = make(r, static_cast<column*>(nullptr));
+            rows += !same(v * a, transpose(a) * v);
+        }
+        GLIC_CHECK(residual <= 3e-5f);
+        GLIC_CHECK(products == 0);
+        GLIC_CHECK(rows == 0);
+
+        const M m = matrix<M>(r);
+        GLIC_CHECK(largest_error(transpose(transpose(m)), m) == 0.0f);
+        GLIC_CHECK(determinant(identity) == 1.0f && determinant(M(2.0f)) == std::ldexp(1.0f, traits<M>::size));
+    }
+
+    template <typename M, typename SoA> void transform(){
+        typedef typename traits<M>::column column;
+        const std::size_t n = 1001;
+        test::random r(0x2545f491u);
+        const M m = matrix<M>(r);
+        std::vector<column> mesh(n), out(n), expected(n);
+        for(std::size_t i = 0; i < n; ++i){
+            mesh[i] = make(r, static_cast<column*>(nullptr)) * 100.0f;
+            expected[i] = m * mesh[i];
+        }
+        const SoA in(mesh);
+        SoA soa(n);
+
+        const isa previous = dispatch::selected();
+        for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+            if(level > dispatch::detect()){ break; }
+            dispatch::use(level);
+
+            batch::transform(m, mesh, out);
+            int mismatches = 0;
+            for(std::size_t i = 0; i < n; ++i){ mismatches += !same(out[i], expected[i]); }
+            GLIC_CHECK_NONE_DIFFER("batch::transform of an array of structs", mismatches, n, dispatch::name(level));
+
+            batch::transform(m, in, soa);
+            mismatches = 0;
+            for(std::size_t i = 0; i < n; ++i){ mismatches += !same(soa[i], expected[i]); }
+            GLIC_CHECK_NONE_DIFFER("batch::transform of a structure of arrays", mismatches, n, dispatch::name(level));
+        }
+        dispatch::use(previous);
+    }
+};
+
+int main(){
+    algebra<mat2>();
+    algebra<mat3>();
+    algebra<mat4>();
+
+    transform<mat3, batch::vec3_soa>();
+    transform<mat4, batch::vec4_soa>();
+
+    return test::result();
+}
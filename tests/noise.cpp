@@ -0,0 +1,107 @@
+// the noise functions are deterministic (the hashes are pinned, repeated and batch evaluation give the same bits at every
+// dispatch level) and stay in their documented ranges: value noise inside [-1, 1], gradient and simplex roughly there with
+// their sampled extremes close to it, gradient noise 0 on the lattice, worley's distances ordered and within one cell
+// diagonal, fbm in the range of one octave
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include "check.h"
+#include "noise.h"
+
+using namespace glic;
+
+namespace {
+    struct range {
+        float lo = 1e30f, hi = -1e30f;
+        void add(const float v){ lo = v < lo ? v : lo; hi = v > hi ? v : hi; }
+    };
+
+    // inside [-limit, limit] and reaching past +-reach on both sides
+    bool spans(const char* name, const range& r, const float limit, const float reach){
+        const bool inside = r.lo >= -limit && r.hi <= limit, reaches = r.lo <= -reach && r.hi >= reach;
+        if(!inside || !reaches){ std::fprintf(stderr, "    %s ranges over [%g, %g]\n", name, r.lo, r.hi); }
+        return inside && reaches;
+    }
+
+    template <typename P, typename F, typename B> void same_in_batch(const char* name, const std::vector<P>& p, const F& single, const B& many){
+        std::vector<float> out(p.size());
+        many(batch::span<const P>(p), batch::span<float>(out));
+        int mismatches = 0;
+        for(std::size_t i = 0; i < p.size(); ++i){ mismatches += !test::same_bits(out[i], single(p[i])) || !test::same_bits(single(p[i]), single(p[i])); }
+        GLIC_CHECK_NONE_DIFFER(name, mismatches, p.size(), dispatch::name(dispatch::selected()));
+    }
+};
+
+int main(){
+    // the integer hashes are fixed functions, whatever the compiler or target
+    GLIC_CHECK(noise::hash(0u) == 0u && noise::hash(1u) == 0x688990c0u);
+    GLIC_CHECK(noise::hash(noise::hash(1u)) == noise::hash(0x688990c0u));
+
+    const std::size_t n = 1u << 16;
+    test::random r(0x2545f491u);
+    std::vector<vec2> p2(n);
+    std::vector<vec3> p3(n);
+    std::vector<vec4> p4(n);
+    for(std::size_t i = 0; i < n; ++i){
+        p4[i] = vec4(r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f), r.next(-100.0f, 100.0f));
+        p3[i] = vec3(p4[i].x, p4[i].y, p4[i].z);
+        p2[i] = vec2(p4[i].x, p4[i].y);
+    }
+
+    range value[3], gradient[3], simplex[3], fbm;
+    bool ordered = true, near = true;
+    for(std::size_t i = 0; i < n; ++i){
+        value[0].add(noise::value(p2[i])); value[1].add(noise::value(p3[i])); value[2].add(noise::value(p4[i]));
+        gradient[0].add(noise::gradient(p2[i])); gradient[1].add(noise::gradient(p3[i])); gradient[2].add(noise::gradient(p4[i]));
+        simplex[0].add(noise::simplex(p2[i])); simplex[1].add(noise::simplex(p3[i])); simplex[2].add(noise::simplex(p4[i]));
+        fbm.add(noise::fbm([](const vec3 q){ return noise::simplex(q); }, p3[i], 5));
+
+        const vec2 w2 = noise::worley(p2[i]), w3 = noise::worley(p3[i]);
+        ordered &= 0.0f <= w2.x && w2.x <= w2.y && 0.0f <= w3.x && w3.x <= w3.y;
+        near &= w2.x <= std::sqrt(2.0f) && w3.x <= std::sqrt(3.0f);
+    }
+
+    const char* dimensions[3] = {"2", "3", "4"};
+    for(int d = 0; d < 3; ++d){
+        std::printf("dimension %s: value [%g, %g] gradient [%g, %g] simplex [%g, %g]\n", dimensions[d], value[d].lo, value[d].hi, gradient[d].lo, gradient[d].hi, simplex[d].lo, simplex[d].hi);
+        GLIC_CHECK(spans("value", value[d], 1.0f, 0.9f));
+        GLIC_CHECK(spans("gradient", gradient[d], 1.1f, 0.6f));
+        GLIC_CHECK(spans("simplex", simplex[d], 1.1f, 0.6f));
+    }
+    GLIC_CHECK(spans("fbm", fbm, 1.1f, 0.5f));
+    GLIC_CHECK(ordered);
+    GLIC_CHECK(near);
+
+    for(int x = -3; x <= 3; ++x){
+        for(int y = -3; y <= 3; ++y){
+            GLIC_CHECK(noise::gradient(vec2(x, y)) == 0.0f);
+            GLIC_CHECK(noise::gradient(vec3(x, y, x - y)) == 0.0f);
+            GLIC_CHECK(noise::gradient(vec4(x, y, x - y, x + y)) == 0.0f);
+        }
+    }
+
+    const isa previous = dispatch::selected();
+    for(const isa level : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}){
+        if(level > dispatch::detect()){ break; }
+        dispatch::use(level);
+        same_in_batch("value2", p2, [](const vec2 p){ return noise::value(p); }, [](batch::span<const vec2> p, batch::span<float> out){ noise::value(p, out); });
+        same_in_batch("value4", p4, [](const vec4 p){ return noise::value(p); }, [](batch::span<const vec4> p, batch::span<float> out){ noise::value(p, out); });
+        same_in_batch("gradient3", p3, [](const vec3 p){ return noise::gradient(p); }, [](batch::span<const vec3> p, batch::span<float> out){ noise::gradient(p, out); });
+        same_in_batch("simplex2", p2, [](const vec2 p){ return noise::simplex(p); }, [](batch::span<const vec2> p, batch::span<float> out){ noise::simplex(p, out); });
+        same_in_batch("simplex3", p3, [](const vec3 p){ return noise::simplex(p); }, [](batch::span<const vec3> p, batch::span<float> out){ noise::simplex(p, out); });
+        same_in_batch("simplex4", p4, [](const vec4 p){ return noise::simplex(p); }, [](batch::span<const vec4> p, batch::span<float> out){ noise::simplex(p, out); });
+        same_in_batch("worley3", p3, [](const vec3 p){ return noise::worley(p).y; }, [](batch::span<const vec3> p, batch::span<float> out){
+            std::vector<vec2> cells(p.size);
+            noise::worley(p, batch::span<vec2>(cells));
+            for(std::size_t i = 0; i < p.size; ++i){ out[i] = cells[i].y; }
+        });
+        same_in_batch("fbm3", p3, [](const vec3 p){ return noise::fbm([](const vec3 q){ return noise::simplex(q); }, p, 5); }, [](batch::span<const vec3> p, batch::span<float> out){
+            noise::fbm([](const vec3 q){ return noise::simplex(q); }, p, out, 5);
+        });
+    }
+    dispatch::use(previous);
+
+    return test::result();
+}
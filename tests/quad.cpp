@@ -0,0 +1,42 @@
+// render_quads keeps every 2x2 quad on even pixel coordinates whatever tile size it is given, so derivatives come out the
+// same for every tile size, and stores only the pixels of the framebuffer (odd sizes included)
+
+#include <vector>
+#include "check.h"
+#include "quad.h"
+
+using namespace glic;
+
+int main(){
+    const int width = 7, height = 5;
+    const uniforms inputs(vec2(width, height));
+    thread_pool single(1);
+
+    // the fine derivative of x * x across a quad anchored at x0 is (x0 + 1.5)^2 - (x0 + 0.5)^2 = 2 x0 + 2
+    const auto shader = [](const quad<vec2>& fragCoord){
+        const quad<float> x = per_lane([](const vec2 p){ return p.x; }, fragCoord), y = per_lane([](const vec2 p){ return p.y; }, fragCoord);
+        return per_lane([](const float x, const float y, const float dx, const float dy){ return vec4(x, y, dx, dy); }, x, y, dFdx(x * x), dFdy(y * y));
+    };
+
+    for(const int tile_size : {-3, 0, 1, 2, 3, 4, 32}){
+        render_options options;
+        options.tile_size = tile_size;
+        options.pool = &single;
+
+        const vec4 untouched(-1.0f);
+        std::vector<vec4> pixels(width * height + 4, untouched);
+        render_quads(shader, inputs, pixels.data(), options);
+
+        for(int y = 0; y < height; ++y){
+            for(int x = 0; x < width; ++x){
+                const vec4 p = pixels[y * width + x];
+                const float dx = 2.0f * (x & ~1) + 2.0f, dy = 2.0f * (y & ~1) + 2.0f;
+                if(!GLIC_CHECK(p.x == x + 0.5f && p.y == y + 0.5f && p.z == dx && p.w == dy)){
+                    std::fprintf(stderr, "    tile size %d, pixel (%d, %d): (%g, %g, %g, %g)\n", tile_size, x, y, p.x, p.y, p.z, p.w);
+                }
+            }
+        }
+        for(int i = width * height; i < width * height + 4; ++i){ GLIC_CHECK(pixels[i].x == -1.0f && pixels[i].w == -1.0f); }
+    }
+    return test::result();
+}
@@ -0,0 +1,64 @@
+// the 8 bit framebuffer path of render.h: colors clamped to [0, 1] and rounded, nan components stored as 0 rather than
+// converted (which is undefined behaviour), and every pixel shaded once at its center whatever the tile size
+// the shader makes nan the way shaders usually do, normalizing a zero vector and taking the square root of a negative
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include "check.h"
+#include "render.h"
+
+using namespace glic;
+
+namespace {
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // column 0 is nan, the others one clamping or rounding case each; rows only tell the pixels apart
+    vec4 shader(const vec2 fragCoord){
+        switch(static_cast<int>(fragCoord.x)){
+            case 0: {
+                const vec3 n = normalize(vec3(0.0f));
+                return vec4(n.x, n.y, n.z, glic::sqrt(-fragCoord.y));
+            }
+            case 1: return vec4(0.5f, 1.0f / 255.0f, 0.49f / 255.0f, 0.0f);
+            case 2: return vec4(-1.0f, 2.0f, inf, -inf);
+            default: return vec4(glic::floor(fragCoord.x) / 255.0f, glic::floor(fragCoord.y) / 255.0f, 1.0f, 1.0f);
+        }
+    }
+
+    bool pixel(const std::vector<std::uint8_t>& bytes, const int width, const int x, const int y, const int r, const int g, const int b, const int a){
+        const std::uint8_t* p = &bytes[4 * (y * width + x)];
+        return p[0] == r && p[1] == g && p[2] == b && p[3] == a;
+    }
+};
+
+int main(){
+    const int width = 37, height = 11;
+    for(const int tile : {1, 4, 32}){
+        std::vector<std::uint8_t> bytes(4 * width * height, 77);
+        render_options options;
+        options.tile_size = tile;
+        render(shader, uniforms(vec2(width, height)), bytes.data(), options);
+
+        bool nan_black = true, rounded = true, clamped = true, gradient = true;
+        for(int y = 0; y < height; ++y){
+            nan_black &= pixel(bytes, width, 0, y, 0, 0, 0, 0);
+            rounded &= pixel(bytes, width, 1, y, 128, 1, 0, 0);
+            clamped &= pixel(bytes, width, 2, y, 0, 255, 255, 0);
+            for(int x = 3; x < width; ++x){ gradient &= pixel(bytes, width, x, y, x, y, 255, 255); }
+        }
+        GLIC_CHECK(nan_black);
+        GLIC_CHECK(rounded);
+        GLIC_CHECK(clamped);
+        GLIC_CHECK(gradient);
+    }
+
+    // the float framebuffer keeps the shader's values, nan included
+    std::vector<vec4> floats(width * height);
+    render(shader, uniforms(vec2(width, height)), floats.data());
+    GLIC_CHECK(std::isnan(floats[0].x) && std::isnan(floats[0].w));
+    GLIC_CHECK(floats[2].z == inf && floats[width + 5].x == 5.0f / 255.0f);
+
+    return test::result();
+}
@@ -0,0 +1,163 @@
+// the vector operators against a per component scalar reference, bit for bit
+// built twice, as glic_test_simd with GLIC_SIMD and glic_test_scalar without, so both builds have to produce exactly what the
+// scalar float operations produce, and so each other's results
+// the inputs cover signed zeros, denormals, the largest floats, infinities and nan on either side of every operator; results of
+// arithmetic on nan only have to be nan (c++ leaves the payload that survives open), min and max pick one of their operands
+// and have to pick the same one down to the bit
+
+#include <cfenv>
+#include <cstdio>
+#include <limits>
+#include "check.h"
+#include "glic.h"
+
+using namespace glic;
+
+namespace {
+    const float inf = std::numeric_limits<float>::infinity();
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+
+    const float values[] = {
+        0.0f, -0.0f, 1.0f, -1.0f, 0.5f, 3.0f, -7.25f, 1.0f / 3.0f, 1e30f, -1e-30f,
+        std::numeric_limits<float>::min(), std::numeric_limits<float>::denorm_min(), -1e-40f,
+        std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), inf, -inf, nan, -nan
+    };
+    const int count = sizeof(values) / sizeof(values[0]);
+
+    float lane(const vec2& v, const int i){ return i == 0 ? v.x : v.y; }
+    float lane(const vec3& v, const int i){ return i == 0 ? v.x : i == 1 ? v.y : v.z; }
+    float lane(const vec4& v, const int i){ return i == 0 ? v.x : i == 1 ? v.y : i == 2 ? v.z : v.w; }
+
+    template <typename T> struct traits;
+    template <> struct traits<vec2> { static constexpr int size = 2; static const char* name(){ return "vec2"; } };
+    template <> struct traits<vec3> { static constexpr int size = 3; static const char* name(){ return "vec3"; } };
+    template <> struct traits<vec4> { static constexpr int size = 4; static const char* name(){ return "vec4"; } };
+
+    vec2 make(const float* v, vec2*){ return vec2(v[0], v[1]); }
+    vec3 make(const float* v, vec3*){ return vec3(v[0], v[1], v[2]); }
+    vec4 make(const float* v, vec4*){ return vec4(v[0], v[1], v[2], v[3]); }
+
+    bool matches(const float result, const float expected, const bool exact){
+        if(!exact && result != result && expected != expected){ return true; }
+        return test::same_bits(result, expected);
+    }
+
+    // every lane of result against reference(lane of a, lane of b)
+    template <typename T, typename F> void lanes(const char* what, const T& result, const T& a, const T& b, const F& reference, const bool exact = false){
+        for(int i = 0; i < traits<T>::size; ++i){
+            const float expected = reference(lane(a, i), lane(b, i));
+            if(!test::check(matches(lane(result, i), expected, exact), __FILE__, __LINE__, what)){
+                std::fprintf(stderr, "    %s lane %d: %a and %a gave %a, expected %a\n", traits<T>::name(), i, lane(a, i), lane(b, i), lane(result, i), expected);
+            }
+        }
+    }
+
+    float add(const float a, const float b){ return a + b; }
+    float sub(const float a, const float b){ return a - b; }
+    float mul(const float a, const float b){ return a * b; }
+    float div(const float a, const float b){ return a / b; }
+    float negate(const float a, float){ return -a; }
+    float increment(const float a, float){ return a + 1.0f; }
+    float decrement(const float a, float){ return a - 1.0f; }
+    float first(const float a, float){ return a; }
+    float lesser(const float a, const float b){ return b < a ? b : a; }
+    float greater(const float a, const float b){ return a < b ? b : a; }
+
+    template <typename T> void operators(const T& a, const T& b, const float s){
+        const T splat(s);
+
+        lanes("a + b", a + b, a, b, add);
+        lanes("a - b", a - b, a, b, sub);
+        lanes("a * b", a * b, a, b, mul);
+        lanes("a / b", a / b, a, b, div);
+
+        lanes("a + s", a + s, a, splat, add);
+        lanes("a - s", a - s, a, splat, sub);
+        lanes("a * s", a * s, a, splat, mul);
+        lanes("a / s", a / s, a, splat, div);
+
+        lanes("s + a", s + a, splat, a, add);
+        lanes("s - a", s - a, splat, a, sub);
+        lanes("s * a", s * a, splat, a, mul);
+        lanes("s / a", s / a, splat, a, div);
+
+        T r = a; r += b; lanes("a += b", r, a, b, add);
+        r = a; r -= b; lanes("a -= b", r, a, b, sub);
+        r = a; r *= b; lanes("a *= b", r, a, b, mul);
+        r = a; r /= b; lanes("a /= b", r, a, b, div);
+
+        r = a; r += s; lanes("a += s", r, a, splat, add);
+        r = a; r -= s; lanes("a -= s", r, a, splat, sub);
+        r = a; r *= s; lanes("a *= s", r, a, splat, mul);
+        r = a; r /= s; lanes("a /= s", r, a, splat, div);
+
+        lanes("-a", -a, a, a, negate, true);
+
+        r = a; lanes("++a", ++r, a, a, increment); lanes("++a stores", r, a, a, increment);
+        r = a; lanes("--a", --r, a, a, decrement); lanes("--a stores", r, a, a, decrement);
+        r = a; lanes("a++", r++, a, a, first, true); lanes("a++ stores", r, a, a, increment);
+        r = a; lanes("a--", r--, a, a, first, true); lanes("a-- stores", r, a, a, decrement);
+
+        // min and max return one of their operands, nan and signed zeros included, so these compare every bit
+        lanes("T::min(a, b)", T::min(a, b), a, b, lesser, true);
+        lanes("T::max(a, b)", T::max(a, b), a, b, greater, true);
+        lanes("min(a, b)", min(a, b), a, b, lesser, true);
+        lanes("max(a, b)", max(a, b), a, b, greater, true);
+        lanes("min(a, s)", min(a, s), a, splat, lesser, true);
+        lanes("max(a, s)", max(a, s), a, splat, greater, true);
+    }
+
+    // every pair of values meets in every lane position, as a and b and as the scalar operand
+    template <typename T> void all_pairs(){
+        for(int i = 0; i < count; ++i){
+            for(int j = 0; j < count; ++j){
+                const float a[4] = {values[i], values[j], values[(i + 3) % count], values[(j + 5) % count]};
+                const float b[4] = {values[j], values[i], values[(i + j) % count], values[(i * j + 1) % count]};
+                operators(make(a, static_cast<T*>(nullptr)), make(b, static_cast<T*>(nullptr)), values[(i + 2 * j) % count]);
+            }
+        }
+    }
+
+    // vec2 goes through load2 and store2 under GLIC_SIMD, which move exactly its two floats and keep the spare lanes away
+    // from 0 / 0 and inf - inf
+    void two_lanes(){
+        vec2 row[3] = {vec2(1.0f, 2.0f), vec2(3.0f, 4.0f), vec2(5.0f, 6.0f)};
+        row[1] += vec2(0.5f, -0.5f);
+        row[1] = -row[1];
+        row[1] /= 2.0f;
+        GLIC_CHECK(row[0].x == 1.0f && row[0].y == 2.0f);
+        GLIC_CHECK(row[1].x == -1.75f && row[1].y == -1.75f);
+        GLIC_CHECK(row[2].x == 5.0f && row[2].y == 6.0f);
+
+        std::feclearexcept(FE_ALL_EXCEPT);
+        volatile float x = 1.0f, y = 2.0f;
+        const vec2 quotient = vec2(x, y) / vec2(y, x) + vec2(x, y) * vec2(y, x) - vec2(x, y);
+        GLIC_CHECK(quotient.x == 1.5f && quotient.y == 2.0f);
+        GLIC_CHECK(!std::fetestexcept(FE_INVALID | FE_DIVBYZERO));
+
+        #if defined(GLIC_SIMD)
+            const float pair[3] = {1.5f, -0.0f, nan};
+            alignas(16) float loaded[4];
+            simd::store(loaded, simd::load2(pair));
+            GLIC_CHECK(test::same_bits(loaded[0], 1.5f) && test::same_bits(loaded[1], -0.0f));
+            GLIC_CHECK(test::same_bits(loaded[2], 1.5f) && test::same_bits(loaded[3], -0.0f));
+
+            float stored[4] = {7.0f, 7.0f, 7.0f, 7.0f};
+            alignas(16) const float source[4] = {-1.0f, -0.0f, 3.0f, 4.0f};
+            simd::store2(stored + 1, simd::load(source));
+            GLIC_CHECK(stored[0] == 7.0f && test::same_bits(stored[1], -1.0f) && test::same_bits(stored[2], -0.0f) && stored[3] == 7.0f);
+
+            const vec2 v(-0.0f, nan);
+            simd::store(loaded, v.lanes());
+            GLIC_CHECK(test::same_bits(loaded[0], -0.0f) && test::same_bits(loaded[1], nan) && test::same_bits(loaded[2], -0.0f) && test::same_bits(loaded[3], nan));
+        #endif
+    }
+};
+
+int main(){
+    all_pairs<vec2>();
+    all_pairs<vec3>();
+    all_pairs<vec4>();
+    two_lanes();
+    return test::result();
+}
@@ -0,0 +1,55 @@
+// bilinear filtering between known texels, and lookups at uv that used to overflow the float to int conversion: nan,
+// infinities and coordinates far past 2^31 texels, for every wrap mode and filter
+
+#include <cmath>
+#include <limits>
+#include "check.h"
+#include "texture.h"
+
+using namespace glic;
+
+namespace {
+    bool finite(const vec4& v){ return std::isfinite(v.x) && std::isfinite(v.y) && std::isfinite(v.z) && std::isfinite(v.w); }
+};
+
+int main(){
+    const vec4 texels[4] = {vec4(0.0f), vec4(1.0f, 0.0f, 0.0f, 1.0f), vec4(0.0f, 1.0f, 0.0f, 1.0f), vec4(1.0f, 1.0f, 1.0f, 0.0f)};
+
+    for(const texture_layout layout : {texture_layout::linear, texture_layout::tiled}){
+        sampler_state state;
+        state.wrap_s = state.wrap_t = texture_wrap::clamp_to_edge;
+        const sampler2D linear(2, 2, texels, state, layout);
+
+        // texel centers, then the middle of the four
+        GLIC_CHECK(texture(linear, vec2(0.25f, 0.25f)).x == 0.0f && texture(linear, vec2(0.75f, 0.25f)).x == 1.0f);
+        const vec4 middle = texture(linear, vec2(0.5f, 0.5f));
+        GLIC_CHECK(middle.x == 0.5f && middle.y == 0.5f && middle.z == 0.25f && middle.w == 0.5f);
+        const vec4 quarter = texture(linear, vec2(0.375f, 0.25f));
+        GLIC_CHECK(quarter.x == 0.25f && quarter.y == 0.0f && quarter.w == 0.25f);
+    }
+
+    const float inf = std::numeric_limits<float>::infinity(), nan = std::numeric_limits<float>::quiet_NaN();
+    for(const texture_wrap wrap : {texture_wrap::repeat, texture_wrap::clamp_to_edge, texture_wrap::mirrored_repeat}){
+        for(const texture_filter filter : {texture_filter::nearest, texture_filter::linear}){
+            sampler_state state;
+            state.wrap_s = state.wrap_t = wrap;
+            state.mag = state.min = filter;
+            const sampler2D sampler(2, 2, texels, state);
+
+            // far out finite coordinates land on some texel (or between two) and stay finite
+            for(const float u : {3e9f, -3e9f, 1e30f, -1e30f}){
+                GLIC_CHECK(finite(texture(sampler, vec2(u, 0.25f))));
+                GLIC_CHECK(finite(texture(sampler, vec2(0.25f, u))));
+                GLIC_CHECK(finite(texture(sampler, vec2(u, u))));
+            }
+
+            // nan, inf and uv whose texel coordinate overflows to inf only have to come back without a crash, nearest even
+            // picks a texel for them
+            for(const float u : {nan, inf, -inf, std::numeric_limits<float>::max(), -std::numeric_limits<float>::max()}){
+                const vec4 a = texture(sampler, vec2(u, 0.25f)), b = texture(sampler, vec2(0.25f, u));
+                if(filter == texture_filter::nearest){ GLIC_CHECK(finite(a) && finite(b)); }
+            }
+        }
+    }
+    return test::result();
+}